@@ -70,6 +70,7 @@ public:
   rviz_common::properties::BoolProperty* fov_marker_enabled_property_;
   rviz_common::properties::FloatProperty* fov_marker_alpha_property_;
   rviz_common::properties::FloatProperty* fov_marker_size_property_;
+  rviz_common::properties::FloatProperty* statistics_period_property_;
 
 private Q_SLOTS:
 
@@ -78,6 +79,7 @@ private Q_SLOTS:
   // ******************************************************************************************
   void fillPlanningGroupNameComboBox();
   void updateMarkers();
+  void updateStatisticsPeriod();
 
 protected:
   void onInitialize() override;
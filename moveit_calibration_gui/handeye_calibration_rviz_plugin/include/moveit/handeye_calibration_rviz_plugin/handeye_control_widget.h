@@ -38,10 +38,15 @@
 
 // qt
 #include <QFile>
+#include <QFileInfo>
 #include <QLabel>
+#include <QTimer>
 #include <QString>
+#include <QThread>
 #include <QTreeView>
+#include <QCheckBox>
 #include <QComboBox>
+#include <QElapsedTimer>
 #include <QGroupBox>
 #include <QTextStream>
 #include <QFileDialog>
@@ -60,16 +65,28 @@
 #include <tf2_ros/transform_listener.h>
 #include <rviz_visual_tools/tf_visual_tools.hpp>
 #include <moveit/move_group_interface/move_group_interface.hpp>
+#include <moveit/robot_trajectory/robot_trajectory.h>
 #include <moveit/planning_scene_monitor/planning_scene_monitor.h>
 #include <moveit/handeye_calibration_solver/handeye_solver_base.h>
+#include <moveit/handeye_calibration_solver/handeye_solver_uncertainty.h>
+#include <moveit/handeye_calibration_target/handeye_trace.h>
+#include <moveit/handeye_calibration_tools/handeye_calibration_export.h>
+#include <moveit/handeye_calibration_tools/handeye_pose_selection.h>
+#include <moveit/handeye_calibration_tools/handeye_rotation_index.h>
+#include <moveit/handeye_calibration_tools/handeye_sample_file.h>
+#include <moveit/handeye_calibration_tools/handeye_sample_stream.h>
 #include <moveit/planning_scene_rviz_plugin/background_processing.hpp>
 #include <moveit/handeye_calibration_rviz_plugin/handeye_calibration_display.h>
+#include <moveit/handeye_calibration_rviz_plugin/handeye_yaml_loader.h>
 
 #ifndef Q_MOC_RUN
+#include <diagnostic_msgs/msg/diagnostic_array.hpp>
 #include <rclcpp/rclcpp.hpp>
 #include <rviz_common/panel.hpp>
 #endif
 
+#include <atomic>
+#include <mutex>
 #include <yaml-cpp/yaml.h>
 
 namespace mhc = moveit_handeye_calibration;
@@ -91,10 +108,12 @@ public:
   void setMin(int value);
   void setValue(int value);
   int getValue();
+  void setStatus(const QString& text);
 
   QLabel* name_label_;
   QLabel* value_label_;
   QLabel* max_label_;
+  QLabel* status_label_;
   QProgressBar* bar_;
 };
 
@@ -110,7 +129,44 @@ class ControlTabWidget : public QWidget
     FAILURE_NO_PSM = 3,
     FAILURE_NO_MOVE_GROUP = 4,
     FAILURE_WRONG_MOVE_GROUP = 5,
-    FAILURE_PLAN_FAILED = 6
+    FAILURE_PLAN_FAILED = 6,
+    FAILURE_JOINT_STATES_CHANGED = 7
+  };
+
+  // Inputs of planning to the recorded joint states, copied on the GUI thread for the planning thread
+  struct PlanningRequest
+  {
+    PLANNING_RESULT setup_result = SUCCESS;
+    moveit::planning_interface::MoveGroupInterfacePtr group;
+    planning_scene_monitor::PlanningSceneMonitorPtr planning_scene_monitor;
+    // Index of the joint state to plan to, and of the first joint state that was not visited yet
+    std::size_t first = 0;
+    std::size_t progress = 0;
+    std::vector<std::string> joint_names;
+    std::vector<std::vector<double>> joint_states;
+    std::vector<moveit::planning_interface::MoveGroupInterface::PlanPtr> cached_plans;
+    // Joint positions to start from instead of the current robot state, if not empty
+    std::vector<std::string> start_joint_names;
+    std::vector<double> start_positions;
+    bool select_next_pose = false;
+    std::vector<Eigen::Isometry3d> effector_wrt_world;
+    mhc::SensorMountType sensor_mount_type = mhc::EYE_TO_HAND;
+    mhc::MotionPairMode motion_pair_mode = mhc::ALL_PAIRS;
+    std::string base_frame;
+    std::string eef_frame;
+  };
+
+  // Plans computed by the planning thread, and the order of the recorded joint states they were planned in
+  struct PlanningResult
+  {
+    PLANNING_RESULT result = SUCCESS;
+    // One plan per planned joint state, starting with the one at the requested index
+    std::vector<moveit::planning_interface::MoveGroupInterface::PlanPtr> plans;
+    // Set if the plans lead through all remaining joint states, to be cached
+    bool all_plans = false;
+    // Joint states of the request, and the same joint states in the planned order
+    std::vector<std::vector<double>> recorded_joint_states;
+    std::vector<std::vector<double>> joint_states;
   };
 
 public:
@@ -118,10 +174,26 @@ public:
                             QWidget* parent = Q_NULLPTR);
   ~ControlTabWidget()
   {
+    solver_params_callback_.reset();
     tf_tools_.reset();
     tf_buffer_.reset();
+    if (uncertainty_cancel_)
+      *uncertainty_cancel_ = true;
+    if (uncertainty_watcher_->isRunning())
+      uncertainty_watcher_->waitForFinished();
+    for (CanceledUncertaintyEstimate& estimate : canceled_uncertainty_estimates_)
+      estimate.future.waitForFinished();
+    canceled_uncertainty_estimates_.clear();
+    if (plan_watcher_->isRunning())
+      plan_watcher_->waitForFinished();
+    if (lookahead_watcher_->isRunning())
+      lookahead_watcher_->waitForFinished();
+    if (yaml_load_watcher_->isRunning())
+      yaml_load_watcher_->waitForFinished();
+    uncertainty_solvers_.clear();
     solver_.reset();
     solver_plugins_loader_.reset();
+    lookahead_group_.reset();
     move_group_.reset();
     planning_scene_monitor_.reset();
   }
@@ -142,15 +214,77 @@ public:
 
   std::string parseSolverName(const std::string& solver_name, char delimiter);
 
-  bool takeTransformSamples();
+  std::string parsePluginName(const std::string& solver_name, char delimiter);
+
+  bool takeTransformSamples(bool quiet = false);
+
+  bool addTransformSample(geometry_msgs::msg::TransformStamped camera_to_object_tf,
+                          geometry_msgs::msg::TransformStamped base_to_eef_tf, bool quiet);
+
+  void rebuildRotationIndex();
+
+  // Adds the samples from the first one on to the tree view, with a single repaint
+  void addSamplesToTreeView(const mhc::SampleSet& samples, std::size_t first);
+
+  bool loadBinarySamples(const std::string& file_name);
+
+  void saveBinarySamples(const std::string& file_name);
+
+  void startYamlLoading(const QString& file_name, bool joint_states);
+
+  void loadYaml();
+
+  void startStreaming();
+
+  void stopStreaming();
 
   bool solveCameraRobotPose();
 
+  void estimateUncertainty();
+
+  // Invalidates the uncertainty estimate, and cancels it if it is still running
+  void cancelUncertaintyEstimate();
+
   bool frameNamesEmpty();
 
   bool checkJointStates();
 
-  void computePlan();
+  PLANNING_RESULT checkPlanningSetup();
+
+  PlanningRequest getPlanningRequest(std::size_t first);
+
+  // Moves the recorded joint states into the planned order, unless they were replaced while planning
+  bool applyPlanningResult(const PlanningResult& result);
+
+  moveit::core::RobotStatePtr getCurrentRobotState(const PlanningRequest& request);
+
+  PlanningResult computePlan(PlanningRequest request);
+
+  PlanningResult computeAllPlans(PlanningRequest request);
+
+  PlanningResult computeLookaheadPlan(PlanningRequest request);
+
+  bool findCachedPlan(PlanningRequest& request, const moveit::core::RobotState& start_state, std::size_t index,
+                      moveit::planning_interface::MoveGroupInterface::PlanPtr& plan);
+
+  QString getCachedPlansFileName() const;
+
+  bool saveCachedPlans();
+
+  void loadCachedPlans();
+
+  PLANNING_RESULT planJointState(PlanningRequest& request, const moveit::core::RobotState& start_state,
+                                 std::size_t index, moveit::planning_interface::MoveGroupInterface::PlanPtr& plan);
+
+  void selectNextJointState(PlanningRequest& request, const moveit::core::RobotState& start_state, std::size_t first);
+
+  void startAutoExecution();
+
+  void advanceAutoCalibration();
+
+  void stopAutoCalibration(const std::string& message);
+
+  void updateAutoEta();
 
   void computeExecution();
 
@@ -194,15 +328,40 @@ private Q_SLOTS:
 
   void autoPlanBtnClicked(bool clicked);
 
+  void autoPlanAllBtnClicked(bool clicked);
+
   void autoExecuteBtnClicked(bool clicked);
 
   void autoSkipBtnClicked(bool clicked);
 
+  void autoRunBtnClicked(bool clicked);
+
   void planFinished();
 
+  void lookaheadFinished();
+
   void executeFinished();
 
+  void uncertaintyFinished();
+
+  void streamSample();
+
+  void flushLoadedYaml();
+
+  void yamlLoadFinished();
+
+  void publishTraceDiagnostics();
+
+  // Called when the solver or the motion pairs are selected, to set the node parameters from them
+  void solverSettingsChanged();
+
 private:
+  // Declare the "solver" and "motion_pairs" node parameters, which select the solver settings of the GUI
+  void declareSolverParameters();
+
+  // Validates a change of the solver node parameters, and updates the GUI in the GUI thread
+  rcl_interfaces::msg::SetParametersResult solverParameterCallback(const std::vector<rclcpp::Parameter>& parameters);
+
   HandEyeCalibrationDisplay* calibration_display_;
 
   // **************************************************************
@@ -214,6 +373,8 @@ private:
   QStandardItemModel* tree_view_model_;
 
   QComboBox* calibration_solver_;
+  QComboBox* motion_pairs_;
+  QComboBox* uncertainty_method_;
 
   // Load & save pose samples and joint goals
   QPushButton* save_joint_state_btn_;
@@ -231,14 +392,26 @@ private:
   // Auto calibration
   QComboBox* group_name_;
   QPushButton* auto_plan_btn_;
+  QPushButton* auto_plan_all_btn_;
   QPushButton* auto_execute_btn_;
   QPushButton* auto_skip_btn_;
+  QPushButton* auto_run_btn_;
+  QCheckBox* stream_samples_;
+  QCheckBox* select_next_pose_;
+  QTimer* stream_timer_;
 
   // Progress of finished joint states for auto calibration
   ProgressBarWidget* auto_progress_;
 
-  QFutureWatcher<void>* plan_watcher_;
+  QFutureWatcher<PlanningResult>* plan_watcher_;
   QFutureWatcher<void>* execution_watcher_;
+  QFutureWatcher<PlanningResult>* lookahead_watcher_;
+  QFutureWatcher<mhc::CalibrationUncertainty>* uncertainty_watcher_;
+  QFutureWatcher<void>* yaml_load_watcher_;
+  // Moves the samples or joint states read so far by the YAML loader into the widget
+  QTimer* yaml_flush_timer_;
+  // Publishes the latencies of the traced stages
+  QTimer* trace_timer_;
 
   // **************************************************************
   // Variables
@@ -246,15 +419,50 @@ private:
 
   mhc::SensorMountType sensor_mount_type_;
   std::map<std::string, std::string> frame_names_;
-  // Transform samples
-  std::vector<Eigen::Isometry3d> effector_wrt_world_;
-  std::vector<Eigen::Isometry3d> object_wrt_sensor_;
+  // Transform samples, with the capture time of each sample's object detection in seconds, or 0 if unknown. The
+  // recorded joint states are kept in joint_states_, since they aren't necessarily taken one per sample.
+  mhc::SampleSet samples_;
+  // Joint state recorded with each sample, empty for samples taken without one, e.g. streamed or loaded from YAML
+  std::vector<std::vector<double>> sample_joint_states_;
   std::string from_frame_tag_;
   Eigen::Isometry3d camera_robot_pose_;
+  // Sample rotations, for rejecting samples too similar to a prior one
+  mhc::RotationIndex effector_rotation_index_;
+  mhc::RotationIndex object_rotation_index_;
+  std::string reprojection_error_text_;
+  mhc::CalibrationUncertainty calibration_uncertainty_;
+  bool uncertainty_valid_;
   std::vector<std::vector<double>> joint_states_;
   std::vector<std::string> joint_names_;
+  // File the joint states were loaded from or saved to, next to which the cached plans are stored
+  QString joint_state_file_;
   bool auto_started_;
+  // Automatic mode, which plans the next joint state while the current one is executed
+  bool auto_running_;
+  // Set from starting the planning of the next joint state until its result is applied
+  bool lookahead_pending_;
+  int auto_start_progress_;
+  QElapsedTimer auto_timer_;
+  mhc::SampleStreamFilter sample_stream_;
+  std::size_t stream_accepted_;
+  std::size_t stream_rejected_motion_;
+  std::size_t stream_rejected_similar_;
   PLANNING_RESULT planning_res_;
+  PLANNING_RESULT lookahead_res_;
+  // Sample or joint state file read on a background thread, with the data not yet moved into the widget
+  QString yaml_load_file_;
+  bool yaml_load_joint_states_;
+  std::mutex yaml_load_mutex_;
+  std::string yaml_load_error_;
+  std::vector<std::string> loaded_joint_names_;
+  std::vector<std::vector<double>> loaded_joint_states_;
+  std::vector<Eigen::Isometry3d> loaded_effector_wrt_world_;
+  std::vector<Eigen::Isometry3d> loaded_object_wrt_sensor_;
+  // Samples and joint states moved into the widget while a YAML file is read, which replace samples_ or the joint
+  // states once the whole file is read
+  mhc::SampleSet yaml_samples_;
+  std::vector<std::string> yaml_joint_names_;
+  std::vector<std::vector<double>> yaml_joint_states_;
 
   // **************************************************************
   // Ros components
@@ -263,24 +471,33 @@ private:
   std::shared_ptr<tf2_ros::Buffer> tf_buffer_;
   tf2_ros::TransformListener tf_listener_;
   rviz_visual_tools::TFVisualToolsPtr tf_tools_;
+  rclcpp::Publisher<diagnostic_msgs::msg::DiagnosticArray>::SharedPtr diagnostic_pub_;
   std::unique_ptr<pluginlib::ClassLoader<moveit_handeye_calibration::HandEyeSolverBase>> solver_plugins_loader_;
   pluginlib::UniquePtr<moveit_handeye_calibration::HandEyeSolverBase> solver_;
+  std::string solver_plugin_name_;
+  // Solvers in the format of calibration_solver_, "plugin_name/solver_name"
+  std::vector<std::string> solver_names_;
+  rclcpp::node_interfaces::OnSetParametersCallbackHandle::SharedPtr solver_params_callback_;
+  // Solver instances used by the uncertainty estimation, one per worker thread
+  std::vector<pluginlib::UniquePtr<moveit_handeye_calibration::HandEyeSolverBase>> uncertainty_solvers_;
+  std::string uncertainty_solver_plugin_name_;
+  // Set to stop the running uncertainty estimate early
+  std::shared_ptr<std::atomic<bool>> uncertainty_cancel_;
+  // Canceled uncertainty estimate that may still be running, with the solver instances it uses
+  struct CanceledUncertaintyEstimate
+  {
+    QFuture<mhc::CalibrationUncertainty> future;
+    std::vector<pluginlib::UniquePtr<moveit_handeye_calibration::HandEyeSolverBase>> solvers;
+  };
+  std::vector<CanceledUncertaintyEstimate> canceled_uncertainty_estimates_;
   planning_scene_monitor::PlanningSceneMonitorPtr planning_scene_monitor_;
   moveit::planning_interface::MoveGroupInterfacePtr move_group_;
   moveit::planning_interface::MoveGroupInterface::PlanPtr current_plan_;
-
-  // **************************************************************
-  // Launch script exporters
-  // **************************************************************
-  std::stringstream generateCalibrationPython(std::string& from_frame, std::string& to_frame, Eigen::Vector3d& t,
-                                              Eigen::Quaterniond& r_quat, Eigen::Vector3d& r_euler,
-                                              std::string& mount_type);
-  std::stringstream generateCalibrationXml(std::string& from_frame, std::string& to_frame, Eigen::Vector3d& t,
-                                           Eigen::Quaterniond& r_quat, Eigen::Vector3d& r_euler,
-                                           std::string& mount_type);
-  std::stringstream generateCalibrationYaml(std::string& from_frame, std::string& to_frame, Eigen::Vector3d& t,
-                                            Eigen::Quaterniond& r_quat, Eigen::Vector3d& r_euler,
-                                            std::string& mount_type);
+  // Separate interface for planning the next motion while move_group_ executes the current one
+  moveit::planning_interface::MoveGroupInterfacePtr lookahead_group_;
+  moveit::planning_interface::MoveGroupInterface::PlanPtr next_plan_;
+  // Plans to the recorded joint states, replayed instead of planning while they are still valid
+  std::vector<moveit::planning_interface::MoveGroupInterface::PlanPtr> cached_plans_;
 };
 
 }  // namespace moveit_rviz_plugin
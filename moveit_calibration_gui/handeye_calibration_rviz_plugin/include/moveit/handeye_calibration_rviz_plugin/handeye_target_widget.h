@@ -51,6 +51,7 @@
 #include <QFormLayout>
 #include <QMessageBox>
 #include <QFileDialog>
+#include <QTimer>
 
 // opencv
 #include <opencv2/aruco.hpp>
@@ -67,14 +68,22 @@
 #include <pluginlib/class_loader.hpp>
 #include <rviz_visual_tools/tf_visual_tools.hpp>
 #include <moveit/handeye_calibration_target/handeye_target_base.h>
+#include <moveit/handeye_calibration_target/handeye_trace.h>
+#include <moveit/handeye_calibration_tools/handeye_detection_statistics.h>
+#include <moveit/handeye_calibration_tools/handeye_target_parameters.h>
 #include <moveit/handeye_calibration_rviz_plugin/handeye_calibration_display.h>
 
 #ifndef Q_MOC_RUN
+#include <diagnostic_msgs/msg/diagnostic_array.hpp>
 #include <rclcpp/rclcpp.hpp>
 #include <rviz_common/config.hpp>
 #include <rviz_common/render_panel.hpp>
 #endif
 
+#include <atomic>
+#include <memory>
+#include <mutex>
+
 Q_DECLARE_METATYPE(sensor_msgs::msg::CameraInfo);
 Q_DECLARE_METATYPE(std::string);
 
@@ -118,7 +127,9 @@ public:
                            QWidget* parent = Q_NULLPTR);
   ~TargetTabWidget()
   {
-    target_.reset();
+    target_type_callback_.reset();
+    target_params_callback_.reset();
+    std::atomic_store(&target_, TargetPtr());
     target_plugins_loader_.reset();
     camera_info_.reset();
   }
@@ -130,6 +141,14 @@ public:
 
   bool createTargetInstance();
 
+  using TargetPtr = std::shared_ptr<moveit_handeye_calibration::HandEyeTargetBase>;
+
+  // Snapshot of the current target, which stays valid while the target type is switched in the GUI thread
+  TargetPtr getTarget() const
+  {
+    return std::atomic_load(&target_);
+  }
+
   void fillDictionaryIds(std::string id = "");
 
   void cameraCallback(const sensor_msgs::msg::Image::ConstSharedPtr& image,
@@ -138,6 +157,9 @@ public:
   void imageCallback(const sensor_msgs::msg::Image::ConstSharedPtr& msg);
 
   void cameraInfoCallback(sensor_msgs::msg::CameraInfo::ConstSharedPtr msg);
+
+  // Set the interval of publishing the detection statistics, in s, 0 to stop publishing
+  void setStatisticsPeriod(double period);
 private Q_SLOTS:
 
   // Called when the current item of target_type_ changed
@@ -146,6 +168,12 @@ private Q_SLOTS:
   // Called to update GUI inputs to match selected target type
   bool loadInputWidgetsForTargetType(const std::string& plugin_name);
 
+  // Called when a target parameter input is edited, to set the target parameters from the inputs
+  void targetParamInputChanged();
+
+  // Called to update GUI inputs to the parameters of the target
+  void updateTargetParamInputs();
+
   // Called when the create_target_btn clicked
   void createTargetImageBtnClicked(bool clicked);
 
@@ -155,6 +183,9 @@ private Q_SLOTS:
   // Called when the item of image_topic_field_ combobox is selected
   void imageTopicComboboxChanged(const QString& topic);
 
+  // Called to publish the detection statistics of the camera on /diagnostics
+  void publishDetectionStatistics();
+
 Q_SIGNALS:
 
   void cameraInfoChanged(sensor_msgs::msg::CameraInfo msg);
@@ -162,6 +193,10 @@ Q_SIGNALS:
   void opticalFrameChanged(const std::string& frame_id);
 
 private:
+  // Validates a change of the "target_type" node parameter, and switches the target type in the GUI thread
+  rcl_interfaces::msg::SetParametersResult
+  targetTypeParameterCallback(const std::vector<rclcpp::Parameter>& parameters);
+
   HandEyeCalibrationDisplay* calibration_display_;
 
   // **************************************************************
@@ -173,6 +208,9 @@ private:
   QComboBox* target_type_;
   std::vector<moveit_handeye_calibration::HandEyeTargetBase::Parameter> target_plugin_params_;
   std::map<std::string, QWidget*> target_param_inputs_;
+  std::atomic<bool> target_params_changed_;
+  std::vector<std::string> target_types_;
+  std::string target_plugin_name_;
 
   // Target 3D pose recognition
   RosTopicComboBox* image_topic_;
@@ -184,26 +222,38 @@ private:
   QPushButton* create_target_btn_;
   QPushButton* save_target_btn_;
 
+  QTimer* statistics_timer_;
+
   // **************************************************************
   // Variables
   // **************************************************************
 
   cv::Mat target_image_;
 
-  std::string optical_frame_;
-
   sensor_msgs::msg::CameraInfo::ConstPtr camera_info_;
 
+  // Optical frame and detection outcome of the frames of the subscribed camera. They are updated by the image callback
+  // on the executor thread and read by the statistics timer on the GUI thread.
+  std::mutex detection_mutex_;
+  std::string optical_frame_;
+  moveit_handeye_calibration::HandEyeDetectionStatistics detection_statistics_;
+
   // **************************************************************
   // Ros components
   // **************************************************************
   rclcpp::Node::SharedPtr node_;
   std::unique_ptr<pluginlib::ClassLoader<moveit_handeye_calibration::HandEyeTargetBase> > target_plugins_loader_;
-  pluginlib::UniquePtr<moveit_handeye_calibration::HandEyeTargetBase> target_;
+  // Replaced in the GUI thread and read in the image callbacks, always through getTarget() and std::atomic_store
+  TargetPtr target_;
   image_transport::ImageTransport it_;
   image_transport::CameraSubscriber camera_sub_;
   image_transport::Publisher image_pub_;
 
+  // Node parameters selecting the target type and setting the target parameters
+  rclcpp::node_interfaces::OnSetParametersCallbackHandle::SharedPtr target_type_callback_;
+  rclcpp::node_interfaces::OnSetParametersCallbackHandle::SharedPtr target_params_callback_;
+  rclcpp::Publisher<diagnostic_msgs::msg::DiagnosticArray>::SharedPtr diagnostic_pub_;
+
   // tf broadcaster
   std::shared_ptr<tf2_ros::TransformBroadcaster> tf_pub_;
 };
@@ -0,0 +1,169 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt Calibration contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <istream>
+#include <string>
+#include <vector>
+#include <Eigen/Geometry>
+#include <yaml-cpp/eventhandler.h>
+#include <yaml-cpp/yaml.h>
+
+namespace moveit_rviz_plugin
+{
+/**
+ * @class YamlStreamHandler
+ * @brief Base of the event-based YAML loaders, which read a file without building a document tree.
+ * It tracks the position of every event in the document as path of the enclosing map keys, with "-" for sequence
+ * levels, e.g. { "joint_values", "-", "-" } for a single joint value.
+ */
+class YamlStreamHandler : public YAML::EventHandler
+{
+public:
+  /**
+   * @brief Parse the first document of a stream, calling the handler as the events are read.
+   * @throw YAML::Exception on syntax errors and on values that don't match the expected format.
+   */
+  void parse(std::istream& input);
+
+  void OnDocumentStart(const YAML::Mark& mark) override;
+  void OnDocumentEnd() override;
+  void OnNull(const YAML::Mark& mark, YAML::anchor_t anchor) override;
+  void OnAlias(const YAML::Mark& mark, YAML::anchor_t anchor) override;
+  void OnScalar(const YAML::Mark& mark, const std::string& tag, YAML::anchor_t anchor,
+                const std::string& value) override;
+  void OnSequenceStart(const YAML::Mark& mark, const std::string& tag, YAML::anchor_t anchor,
+                       YAML::EmitterStyle::value style) override;
+  void OnSequenceEnd() override;
+  void OnMapStart(const YAML::Mark& mark, const std::string& tag, YAML::anchor_t anchor,
+                  YAML::EmitterStyle::value style) override;
+  void OnMapEnd() override;
+
+protected:
+  /**
+   * @brief Called for every scalar value, i.e. except map keys, with path() at the position of the value.
+   */
+  virtual void onValue(const YAML::Mark& mark, const std::string& value) = 0;
+
+  /**
+   * @brief Called at the end of every map or sequence, with path() at the position of the container.
+   */
+  virtual void onContainerEnd()
+  {
+  }
+
+  const std::vector<std::string>& path() const
+  {
+    return path_;
+  }
+
+  bool pathIs(std::initializer_list<const char*> path) const;
+
+  static double toDouble(const YAML::Mark& mark, const std::string& value);
+
+private:
+  void endValue();
+
+  struct Level
+  {
+    bool is_map;
+    bool expect_key;
+  };
+  std::vector<Level> levels_;
+  std::vector<std::string> path_;
+};
+
+/**
+ * @class SampleYamlLoader
+ * @brief Loads a sample file written by the control tab, a sequence of maps with the "effector_wrt_world" and
+ * "object_wrt_sensor" transforms as 4x4 row-major matrices. Every sample is passed on as soon as it is read.
+ */
+class SampleYamlLoader : public YamlStreamHandler
+{
+public:
+  using SampleCallback =
+      std::function<void(const Eigen::Isometry3d& effector_wrt_world, const Eigen::Isometry3d& object_wrt_sensor)>;
+
+  explicit SampleYamlLoader(const SampleCallback& callback);
+
+  void parse(std::istream& input);
+
+protected:
+  void onValue(const YAML::Mark& mark, const std::string& value) override;
+  void onContainerEnd() override;
+
+private:
+  SampleCallback callback_;
+  std::vector<double> effector_wrt_world_;
+  std::vector<double> object_wrt_sensor_;
+  std::size_t num_samples_ = 0;
+};
+
+/**
+ * @class JointStateYamlLoader
+ * @brief Loads a joint state file written by the control tab, a map of the "joint_names" and the "joint_values"
+ * sequences. The joint names have to come first, as they are written, and every joint state with the same number of
+ * values is passed on as soon as it is read.
+ */
+class JointStateYamlLoader : public YamlStreamHandler
+{
+public:
+  using JointNamesCallback = std::function<void(const std::vector<std::string>& joint_names)>;
+  using JointStateCallback = std::function<void(const std::vector<double>& joint_state)>;
+
+  JointStateYamlLoader(const JointNamesCallback& names_callback, const JointStateCallback& state_callback);
+
+  /**
+   * @brief Parse a joint state file.
+   * @throw YAML::Exception also if "joint_names" or "joint_values" is missing.
+   */
+  void parse(std::istream& input);
+
+protected:
+  void onValue(const YAML::Mark& mark, const std::string& value) override;
+  void onContainerEnd() override;
+
+private:
+  JointNamesCallback names_callback_;
+  JointStateCallback state_callback_;
+  std::vector<std::string> joint_names_;
+  std::vector<double> joint_state_;
+  bool has_names_ = false;
+  bool has_values_ = false;
+};
+
+}  // namespace moveit_rviz_plugin
@@ -67,6 +67,12 @@ HandEyeCalibrationDisplay::HandEyeCalibrationDisplay(QWidget* parent) : Display(
   fov_marker_size_property_ = new rviz_common::properties::FloatProperty(
       "Marker Size", 1.5f, "Specifies the size (depth in meters) for the rendered marker", fov_marker_enabled_property_,
       SLOT(updateMarkers()), this);
+
+  statistics_period_property_ = new rviz_common::properties::FloatProperty(
+      "Detection Statistics Period", 1.0f,
+      "Interval of publishing the target detection statistics on /diagnostics, in seconds, 0 to disable", this,
+      SLOT(updateStatisticsPeriod()), this);
+  statistics_period_property_->setMin(0.f);
 }
 
 HandEyeCalibrationDisplay::~HandEyeCalibrationDisplay()
@@ -123,4 +129,12 @@ void HandEyeCalibrationDisplay::updateMarkers()
   }
 }
 
+void HandEyeCalibrationDisplay::updateStatisticsPeriod()
+{
+  if (frame_ && frame_->tab_target_)
+  {
+    frame_->tab_target_->setStatisticsPeriod(statistics_period_property_->getFloat());
+  }
+}
+
 }  // namespace moveit_rviz_plugin
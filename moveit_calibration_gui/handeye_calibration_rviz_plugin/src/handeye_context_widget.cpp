@@ -35,10 +35,34 @@
 /* Author: Yu Yan */
 
 #include <moveit/handeye_calibration_rviz_plugin/handeye_context_widget.h>
+#include <moveit/handeye_calibration_target/handeye_target_base.h>
 #include <math.h>
 
 namespace moveit_rviz_plugin
 {
+namespace
+{
+// Largest angle of the FOV mesh sides from the optical axis, fisheye lenses can see 90 degrees and more
+const double MAX_FOV_HALF_ANGLE = 80. * M_PI / 180.;
+
+// Angle from the optical axis of the ray to an image point at the distorted angle theta_d, the distance from the
+// principal point over the focal length. Inverts the equidistant model
+// theta_d = theta (1 + k1 theta^2 + k2 theta^4 + k3 theta^6 + k4 theta^8) with Newton's method.
+double getFisheyeRayAngle(double theta_d, const std::vector<double>& d)
+{
+  double theta = theta_d;
+  for (int i = 0; i < 10; ++i)
+  {
+    const double theta2 = theta * theta;
+    const double error = theta * (1. + theta2 * (d[0] + theta2 * (d[1] + theta2 * (d[2] + theta2 * d[3])))) - theta_d;
+    const double derivative =
+        1. + theta2 * (3. * d[0] + theta2 * (5. * d[1] + theta2 * (7. * d[2] + 9. * theta2 * d[3])));
+    theta -= error / derivative;
+  }
+  return theta;
+}
+}  // namespace
+
 void TFFrameNameComboBox::mousePressEvent(QMouseEvent* event)
 {
   context_->getFrameManager()->update();
@@ -393,10 +417,24 @@ shape_msgs::msg::Mesh ContextTabWidget::getCameraFOVMesh(const sensor_msgs::msg:
                                                          double max_dist)
 {
   shape_msgs::msg::Mesh mesh;
-  image_geometry::PinholeCameraModel camera_model;
-  camera_model.fromCameraInfo(camera_info);
-  double delta_x = camera_model.getDeltaX(camera_info.width / 2, max_dist);
-  double delta_y = camera_model.getDeltaY(camera_info.height / 2, max_dist);
+  double delta_x;
+  double delta_y;
+  if (moveit_handeye_calibration::HandEyeTargetBase::isFisheyeDistortionModel(camera_info.distortion_model) &&
+      camera_info.d.size() == 4)
+  {
+    // The pinhole projection of the image edges underestimates the fisheye FOV
+    const double angle_x = getFisheyeRayAngle(camera_info.width / 2 / camera_info.k[0], camera_info.d);
+    const double angle_y = getFisheyeRayAngle(camera_info.height / 2 / camera_info.k[4], camera_info.d);
+    delta_x = max_dist * std::tan(std::min(angle_x, MAX_FOV_HALF_ANGLE));
+    delta_y = max_dist * std::tan(std::min(angle_y, MAX_FOV_HALF_ANGLE));
+  }
+  else
+  {
+    image_geometry::PinholeCameraModel camera_model;
+    camera_model.fromCameraInfo(camera_info);
+    delta_x = camera_model.getDeltaX(camera_info.width / 2, max_dist);
+    delta_y = camera_model.getDeltaY(camera_info.height / 2, max_dist);
+  }
 
   std::vector<double> x_cords = { -delta_x, delta_x };
   std::vector<double> y_cords = { -delta_y, delta_y };
@@ -37,11 +37,18 @@
 #include <moveit/handeye_calibration_rviz_plugin/handeye_control_widget.h>
 #include <tf2_geometry_msgs/tf2_geometry_msgs.hpp>
 #include <rclcpp/rclcpp.hpp>
+#include <algorithm>
+#include <fstream>
 
 namespace moveit_rviz_plugin
 {
 const std::string LOGNAME = "handeye_control_widget";
-const double MIN_ROTATION = M_PI / 36.;  // Smallest allowed rotation, 5 degrees
+const double MIN_ROTATION = M_PI / 36.;          // Smallest allowed rotation, 5 degrees
+const std::size_t BOOTSTRAP_RESAMPLES = 100;     // Number of resampled sample sets for the bootstrap estimate
+const int STREAM_POLL_INTERVAL = 10;             // Interval of polling for new detections while streaming, in ms
+const double CACHED_PLAN_TOLERANCE = 0.01;       // Largest joint difference to the start or goal of a cached plan
+const int YAML_FLUSH_INTERVAL = 100;             // Interval of adding the samples read so far to the view, in ms
+const int TRACE_DIAGNOSTIC_INTERVAL = 1000;      // Interval of publishing the stage latencies, in ms
 
 ProgressBarWidget::ProgressBarWidget(QWidget* parent, int min, int max, int value) : QWidget(parent)
 {
@@ -71,6 +78,10 @@ ProgressBarWidget::ProgressBarWidget(QWidget* parent, int min, int max, int valu
   max_label_->setContentsMargins(0, 0, 0, 0);
   row->addWidget(max_label_);
 
+  status_label_ = new QLabel(this);
+  status_label_->setContentsMargins(0, 0, 0, 0);
+  row->addWidget(status_label_);
+
   this->setLayout(row);
 }
 
@@ -97,6 +108,11 @@ int ProgressBarWidget::getValue()
   return bar_->value();
 }
 
+void ProgressBarWidget::setStatus(const QString& text)
+{
+  status_label_->setText(text);
+}
+
 ControlTabWidget::ControlTabWidget(rclcpp::Node::SharedPtr node, HandEyeCalibrationDisplay* pdisplay, QWidget* parent)
   : QWidget(parent)
   , node_(node)
@@ -110,8 +126,19 @@ ControlTabWidget::ControlTabWidget(rclcpp::Node::SharedPtr node, HandEyeCalibrat
   , solver_(nullptr)
   , move_group_(nullptr)
   , camera_robot_pose_(Eigen::Isometry3d::Identity())
+  , effector_rotation_index_(MIN_ROTATION)
+  , object_rotation_index_(MIN_ROTATION)
+  , uncertainty_valid_(false)
   , auto_started_(false)
+  , auto_running_(false)
+  , lookahead_pending_(false)
+  , auto_start_progress_(0)
+  , stream_accepted_(0)
+  , stream_rejected_motion_(0)
+  , stream_rejected_similar_(0)
   , planning_res_(ControlTabWidget::SUCCESS)
+  , lookahead_res_(ControlTabWidget::SUCCESS)
+  , yaml_load_joint_states_(false)
 {
   QVBoxLayout* layout = new QVBoxLayout();
   this->setLayout(layout);
@@ -155,8 +182,26 @@ ControlTabWidget::ControlTabWidget(rclcpp::Node::SharedPtr node, HandEyeCalibrat
   setting_layout->insertLayout(1, setting_layout_bottom);
 
   calibration_solver_ = new QComboBox();
+  connect(calibration_solver_, SIGNAL(activated(int)), this, SLOT(solverSettingsChanged()));
   setting_layout_top->addRow("AX=XB Solver", calibration_solver_);
 
+  // Items are in the order of mhc::MotionPairMode
+  motion_pairs_ = new QComboBox();
+  motion_pairs_->addItem("Consecutive");
+  motion_pairs_->addItem("All pairs");
+  motion_pairs_->addItem("Selected pairs");
+  motion_pairs_->setToolTip("Motions between samples used by the solver and the reprojection error");
+  connect(motion_pairs_, SIGNAL(activated(int)), this, SLOT(solverSettingsChanged()));
+  setting_layout_top->addRow("Motion Pairs", motion_pairs_);
+
+  // Items after "None" are in the order of mhc::UncertaintyMethod
+  uncertainty_method_ = new QComboBox();
+  uncertainty_method_->addItem("None");
+  uncertainty_method_->addItem("Bootstrap");
+  uncertainty_method_->addItem("Jackknife");
+  uncertainty_method_->setToolTip("Estimate the standard deviation of the calibration by resampling the samples");
+  setting_layout_top->addRow("Uncertainty", uncertainty_method_);
+
   group_name_ = new QComboBox();
   connect(group_name_, SIGNAL(activated(const QString&)), this, SLOT(planningGroupNameChanged(const QString&)));
   setting_layout_top->addRow("Planning Group", group_name_);
@@ -221,6 +266,13 @@ ControlTabWidget::ControlTabWidget(rclcpp::Node::SharedPtr node, HandEyeCalibrat
   connect(auto_plan_btn_, SIGNAL(clicked(bool)), this, SLOT(autoPlanBtnClicked(bool)));
   auto_btns_layout->addWidget(auto_plan_btn_);
 
+  auto_plan_all_btn_ = new QPushButton("Plan All");
+  auto_plan_all_btn_->setMinimumHeight(35);
+  auto_plan_all_btn_->setToolTip("Plan motions through all remaining joint states, and cache them next to the joint "
+                                 "state file to be replayed while they stay valid");
+  connect(auto_plan_all_btn_, SIGNAL(clicked(bool)), this, SLOT(autoPlanAllBtnClicked(bool)));
+  auto_btns_layout->addWidget(auto_plan_all_btn_);
+
   auto_execute_btn_ = new QPushButton("Execute");
   auto_execute_btn_->setMinimumHeight(35);
   auto_execute_btn_->setToolTip("Execute the planned motion to next calibration pose");
@@ -233,21 +285,61 @@ ControlTabWidget::ControlTabWidget(rclcpp::Node::SharedPtr node, HandEyeCalibrat
   connect(auto_skip_btn_, SIGNAL(clicked(bool)), this, SLOT(autoSkipBtnClicked(bool)));
   auto_btns_layout->addWidget(auto_skip_btn_);
 
+  auto_run_btn_ = new QPushButton("Run");
+  auto_run_btn_->setMinimumHeight(35);
+  auto_run_btn_->setToolTip("Plan, execute and take samples at all remaining joint states, planning each motion "
+                            "while the previous one is executed");
+  connect(auto_run_btn_, SIGNAL(clicked(bool)), this, SLOT(autoRunBtnClicked(bool)));
+  auto_btns_layout->addWidget(auto_run_btn_);
+
+  stream_samples_ = new QCheckBox("Stream samples during execution");
+  stream_samples_->setToolTip("Record every target detection while the robot moves, except during fast motion or "
+                              "when too similar to a prior sample");
+  auto_cal_layout->addWidget(stream_samples_);
+
+  select_next_pose_ = new QCheckBox("Select next pose by information gain");
+  select_next_pose_->setToolTip("Visit the recorded joint state that most reduces the calibration uncertainty next, "
+                                "instead of following the recorded order");
+  auto_cal_layout->addWidget(select_next_pose_);
+
+  stream_timer_ = new QTimer(this);
+  connect(stream_timer_, &QTimer::timeout, this, &ControlTabWidget::streamSample);
+
   // Initialize handeye solver plugins
   std::vector<std::string> plugins;
   if (loadSolverPlugin(plugins))
     fillSolverTypes(plugins);
+  declareSolverParameters();
 
   // Connect PSM and get group names
   fillPlanningGroupNameComboBox();
 
   // Set plan and execution watcher
-  plan_watcher_ = new QFutureWatcher<void>(this);
-  connect(plan_watcher_, &QFutureWatcher<void>::finished, this, &ControlTabWidget::planFinished);
+  plan_watcher_ = new QFutureWatcher<PlanningResult>(this);
+  connect(plan_watcher_, &QFutureWatcher<PlanningResult>::finished, this, &ControlTabWidget::planFinished);
 
   execution_watcher_ = new QFutureWatcher<void>(this);
   connect(execution_watcher_, &QFutureWatcher<void>::finished, this, &ControlTabWidget::executeFinished);
 
+  lookahead_watcher_ = new QFutureWatcher<PlanningResult>(this);
+  connect(lookahead_watcher_, &QFutureWatcher<PlanningResult>::finished, this, &ControlTabWidget::lookaheadFinished);
+
+  uncertainty_watcher_ = new QFutureWatcher<mhc::CalibrationUncertainty>(this);
+  connect(uncertainty_watcher_, &QFutureWatcher<mhc::CalibrationUncertainty>::finished, this,
+          &ControlTabWidget::uncertaintyFinished);
+
+  yaml_load_watcher_ = new QFutureWatcher<void>(this);
+  connect(yaml_load_watcher_, &QFutureWatcher<void>::finished, this, &ControlTabWidget::yamlLoadFinished);
+
+  yaml_flush_timer_ = new QTimer(this);
+  connect(yaml_flush_timer_, &QTimer::timeout, this, &ControlTabWidget::flushLoadedYaml);
+
+  // Latencies of the image callback, target detection, sampling and solving, as diagnostics
+  diagnostic_pub_ = node_->create_publisher<diagnostic_msgs::msg::DiagnosticArray>("/diagnostics", 1);
+  trace_timer_ = new QTimer(this);
+  connect(trace_timer_, &QTimer::timeout, this, &ControlTabWidget::publishTraceDiagnostics);
+  trace_timer_->start(TRACE_DIAGNOSTIC_INTERVAL);
+
   // Set initial status
   calibration_display_->setStatus(rviz_common::properties::StatusProperty::Ok, "Calibration",
                                   "Collect 5 samples to start calibration.");
@@ -267,9 +359,12 @@ void ControlTabWidget::loadWidget(const rviz_common::Config& config)
       Q_EMIT group_name_->activated(group_name);
     }
   }
+  // Parameter overrides of the node, e.g. from a launch file, take precedence over the saved configuration
+  const std::map<std::string, rclcpp::ParameterValue>& overrides =
+      node_->get_node_parameters_interface()->get_parameter_overrides();
   QString solver_name;
   config.mapGetString("solver", &solver_name);
-  if (!solver_name.isEmpty())
+  if (!solver_name.isEmpty() && !overrides.count("solver"))
   {
     for (size_t i = 0; i < calibration_solver_->count(); ++i)
     {
@@ -281,12 +376,31 @@ void ControlTabWidget::loadWidget(const rviz_common::Config& config)
       }
     }
   }
+  int motion_pairs;
+  if (config.mapGetInt("motion_pairs", &motion_pairs) && 0 <= motion_pairs && motion_pairs < motion_pairs_->count() &&
+      !overrides.count("motion_pairs"))
+    motion_pairs_->setCurrentIndex(motion_pairs);
+  solverSettingsChanged();
+  bool stream_samples;
+  if (config.mapGetBool("stream_samples", &stream_samples))
+    stream_samples_->setChecked(stream_samples);
+  bool select_next_pose;
+  if (config.mapGetBool("select_next_pose", &select_next_pose))
+    select_next_pose_->setChecked(select_next_pose);
+  int uncertainty_method;
+  if (config.mapGetInt("uncertainty", &uncertainty_method) && 0 <= uncertainty_method &&
+      uncertainty_method < uncertainty_method_->count())
+    uncertainty_method_->setCurrentIndex(uncertainty_method);
 }
 
 void ControlTabWidget::saveWidget(rviz_common::Config& config)
 {
   config.mapSetValue("solver", calibration_solver_->currentText());
   config.mapSetValue("group", group_name_->currentText());
+  config.mapSetValue("motion_pairs", motion_pairs_->currentIndex());
+  config.mapSetValue("uncertainty", uncertainty_method_->currentIndex());
+  config.mapSetValue("stream_samples", stream_samples_->isChecked());
+  config.mapSetValue("select_next_pose", select_next_pose_->isChecked());
 }
 
 bool ControlTabWidget::loadSolverPlugin(std::vector<std::string>& plugins)
@@ -318,6 +432,7 @@ bool ControlTabWidget::createSolverInstance(const std::string& plugin_name)
   {
     solver_ = solver_plugins_loader_->createUniqueInstance(plugin_name);
     solver_->initialize();
+    solver_plugin_name_ = plugin_name;
   }
   catch (pluginlib::PluginlibException& ex)
   {
@@ -345,6 +460,93 @@ void ControlTabWidget::fillSolverTypes(const std::vector<std::string>& plugins)
     }
 }
 
+void ControlTabWidget::declareSolverParameters()
+{
+  for (int i = 0; i < calibration_solver_->count(); ++i)
+    solver_names_.push_back(calibration_solver_->itemText(i).toStdString());
+  if (solver_names_.empty() || node_->has_parameter("solver"))
+    return;
+
+  // The solver can also be selected with node parameters, e.g. for comparing solvers from a launch file
+  rcl_interfaces::msg::ParameterDescriptor solver_descriptor;
+  solver_descriptor.description = "AX=XB solver, as plugin_name/solver_name";
+  const std::string solver =
+      node_->declare_parameter<std::string>("solver", solver_names_.front(), solver_descriptor);
+  if (std::find(solver_names_.begin(), solver_names_.end(), solver) != solver_names_.end())
+    calibration_solver_->setCurrentText(QString::fromStdString(solver));
+  else
+    RCLCPP_WARN(node_->get_logger(), "Unknown solver '%s'", solver.c_str());
+
+  rcl_interfaces::msg::ParameterDescriptor motion_pairs_descriptor;
+  motion_pairs_descriptor.description = "Motions between samples used by the solver: 0 consecutive, 1 all pairs, "
+                                        "2 selected pairs";
+  rcl_interfaces::msg::IntegerRange range;
+  range.from_value = mhc::CONSECUTIVE_PAIRS;
+  range.to_value = mhc::SELECTED_PAIRS;
+  motion_pairs_descriptor.integer_range.push_back(range);
+  motion_pairs_->setCurrentIndex(
+      node_->declare_parameter<int>("motion_pairs", motion_pairs_->currentIndex(), motion_pairs_descriptor));
+
+  solver_params_callback_ = node_->add_on_set_parameters_callback(
+      [this](const std::vector<rclcpp::Parameter>& parameters) { return solverParameterCallback(parameters); });
+}
+
+rcl_interfaces::msg::SetParametersResult
+ControlTabWidget::solverParameterCallback(const std::vector<rclcpp::Parameter>& parameters)
+{
+  rcl_interfaces::msg::SetParametersResult result;
+  result.successful = true;
+  for (const rclcpp::Parameter& parameter : parameters)
+  {
+    if (parameter.get_name() == "solver")
+    {
+      if (parameter.get_type() != rclcpp::ParameterType::PARAMETER_STRING ||
+          std::find(solver_names_.begin(), solver_names_.end(), parameter.as_string()) == solver_names_.end())
+      {
+        result.successful = false;
+        result.reason = "Unknown solver";
+        return result;
+      }
+    }
+    else if (parameter.get_name() == "motion_pairs")
+    {
+      if (parameter.get_type() != rclcpp::ParameterType::PARAMETER_INTEGER ||
+          parameter.as_int() < mhc::CONSECUTIVE_PAIRS || parameter.as_int() > mhc::SELECTED_PAIRS)
+      {
+        result.successful = false;
+        result.reason = "Invalid motion pair mode";
+        return result;
+      }
+    }
+  }
+
+  // The GUI is updated in the GUI thread, the solver settings are read from it when solving
+  for (const rclcpp::Parameter& parameter : parameters)
+  {
+    if (parameter.get_name() == "solver")
+    {
+      const QString solver = QString::fromStdString(parameter.as_string());
+      QMetaObject::invokeMethod(
+          this, [this, solver]() { calibration_solver_->setCurrentText(solver); }, Qt::QueuedConnection);
+    }
+    else if (parameter.get_name() == "motion_pairs")
+    {
+      const int motion_pairs = parameter.as_int();
+      QMetaObject::invokeMethod(
+          this, [this, motion_pairs]() { motion_pairs_->setCurrentIndex(motion_pairs); }, Qt::QueuedConnection);
+    }
+  }
+  return result;
+}
+
+void ControlTabWidget::solverSettingsChanged()
+{
+  if (!solver_params_callback_ || calibration_solver_->currentText().isEmpty())
+    return;
+  node_->set_parameters_atomically({ rclcpp::Parameter("solver", calibration_solver_->currentText().toStdString()),
+                                     rclcpp::Parameter("motion_pairs", motion_pairs_->currentIndex()) });
+}
+
 std::string ControlTabWidget::parseSolverName(const std::string& solver_name, char delimiter)
 {
   std::vector<std::string> tokens;
@@ -357,71 +559,158 @@ std::string ControlTabWidget::parseSolverName(const std::string& solver_name, ch
   return tokens.back();
 }
 
-bool ControlTabWidget::takeTransformSamples()
+std::string ControlTabWidget::parsePluginName(const std::string& solver_name, char delimiter)
 {
+  return solver_name.substr(0, solver_name.find_last_of(delimiter));
+}
+
+bool ControlTabWidget::takeTransformSamples(bool quiet)
+{
+  mhc::ScopedTrace trace("takeTransformSamples");
+
   // Store the pair of two tf transforms and calculate camera_robot pose
   try
   {
     geometry_msgs::msg::TransformStamped camera_to_object_tf;
     geometry_msgs::msg::TransformStamped base_to_eef_tf;
 
-    // Get the transform of the object w.r.t the camera
+    // Get the latest transform of the object w.r.t the camera, stamped with the capture time of its image
     camera_to_object_tf = tf_buffer_->lookupTransform(frame_names_["sensor"], frame_names_["object"], rclcpp::Time(0));
 
-    // Get the transform of the end-effector w.r.t the robot base
-    base_to_eef_tf = tf_buffer_->lookupTransform(frame_names_["base"], frame_names_["eef"], rclcpp::Time(0));
-
-    // Verify that sample contains sufficient rotation
-    Eigen::Isometry3d base_to_eef_eig, camera_to_object_eig;
-    base_to_eef_eig = tf2::transformToEigen(base_to_eef_tf);
-    camera_to_object_eig = tf2::transformToEigen(camera_to_object_tf);
-
-    for (const auto& prior_tf : effector_wrt_world_)
+    // Get the transform of the end-effector w.r.t the robot base at the capture time, interpolated by TF, so the pair
+    // stays consistent while the arm is moving. This runs in the GUI thread, so it must not wait for the robot pose.
+    const rclcpp::Time capture_time(camera_to_object_tf.header.stamp);
+    if (!tf_buffer_->canTransform(frame_names_["base"], frame_names_["eef"], capture_time))
     {
-      Eigen::AngleAxisd rot((base_to_eef_eig.inverse() * prior_tf).rotation());
-      if (rot.angle() < MIN_ROTATION)
-      {
+      RCLCPP_WARN(node_->get_logger(),
+                  "Robot pose at the image capture time is not yet available, sample not recorded.");
+      if (!quiet)
         QMessageBox::warning(this, tr("Error"),
-                             tr("End-effector orientation is too similar to a prior sample. Sample not recorded."));
-        return false;
-      }
+                             tr("Robot pose at the image capture time is not yet available. Sample not recorded."));
+      return false;
     }
+    base_to_eef_tf = tf_buffer_->lookupTransform(frame_names_["base"], frame_names_["eef"], capture_time);
 
-    for (const auto prior_tf : object_wrt_sensor_)
-    {
-      Eigen::AngleAxisd rot((camera_to_object_eig.inverse() * prior_tf).rotation());
-      if (rot.angle() < MIN_ROTATION)
-      {
-        QMessageBox::warning(this, tr("Error"),
-                             tr("Camera orientation is too similar to a prior sample. Sample not recorded."));
-        return false;
-      }
-    }
+    return addTransformSample(camera_to_object_tf, base_to_eef_tf, quiet);
+  }
+  catch (tf2::TransformException& e)
+  {
+    RCLCPP_WARN(node_->get_logger(), "TF exception: %s", e.what());
+    return false;
+  }
+}
 
-    // Renormalize quaternions, to avoid numerical issues
-    tf2::Quaternion tf2_quat;
-    tf2::fromMsg(camera_to_object_tf.transform.rotation, tf2_quat);
-    tf2_quat.normalize();
-    camera_to_object_tf.transform.rotation = tf2::toMsg(tf2_quat);
-    tf2::fromMsg(base_to_eef_tf.transform.rotation, tf2_quat);
-    tf2_quat.normalize();
-    base_to_eef_tf.transform.rotation = tf2::toMsg(tf2_quat);
+bool ControlTabWidget::addTransformSample(geometry_msgs::msg::TransformStamped camera_to_object_tf,
+                                          geometry_msgs::msg::TransformStamped base_to_eef_tf, bool quiet)
+{
+  // Verify that sample contains sufficient rotation
+  Eigen::Isometry3d base_to_eef_eig, camera_to_object_eig;
+  base_to_eef_eig = tf2::transformToEigen(base_to_eef_tf);
+  camera_to_object_eig = tf2::transformToEigen(camera_to_object_tf);
 
-    // save the pose samples
-    effector_wrt_world_.push_back(base_to_eef_eig);
-    object_wrt_sensor_.push_back(camera_to_object_eig);
+  if (effector_rotation_index_.size() != samples_.effector_wrt_world.size() ||
+      object_rotation_index_.size() != samples_.object_wrt_sensor.size())
+    rebuildRotationIndex();
 
-    ControlTabWidget::addPoseSampleToTreeView(camera_to_object_tf, base_to_eef_tf, effector_wrt_world_.size());
+  if (effector_rotation_index_.hasNeighbor(base_to_eef_eig.rotation()))
+  {
+    if (!quiet)
+      QMessageBox::warning(this, tr("Error"),
+                           tr("End-effector orientation is too similar to a prior sample. Sample not recorded."));
+    return false;
   }
-  catch (tf2::TransformException& e)
+
+  if (object_rotation_index_.hasNeighbor(camera_to_object_eig.rotation()))
   {
-    RCLCPP_WARN(node_->get_logger(), "TF exception: %s", e.what());
+    if (!quiet)
+      QMessageBox::warning(this, tr("Error"),
+                           tr("Camera orientation is too similar to a prior sample. Sample not recorded."));
     return false;
   }
 
+  // Renormalize quaternions, to avoid numerical issues
+  tf2::Quaternion tf2_quat;
+  tf2::fromMsg(camera_to_object_tf.transform.rotation, tf2_quat);
+  tf2_quat.normalize();
+  camera_to_object_tf.transform.rotation = tf2::toMsg(tf2_quat);
+  tf2::fromMsg(base_to_eef_tf.transform.rotation, tf2_quat);
+  tf2_quat.normalize();
+  base_to_eef_tf.transform.rotation = tf2::toMsg(tf2_quat);
+
+  // save the pose samples
+  samples_.effector_wrt_world.push_back(base_to_eef_eig);
+  samples_.object_wrt_sensor.push_back(camera_to_object_eig);
+  samples_.stamps.push_back(rclcpp::Time(camera_to_object_tf.header.stamp).seconds());
+  sample_joint_states_.emplace_back();
+  effector_rotation_index_.insert(base_to_eef_eig.rotation());
+  object_rotation_index_.insert(camera_to_object_eig.rotation());
+
+  ControlTabWidget::addPoseSampleToTreeView(camera_to_object_tf, base_to_eef_tf, samples_.effector_wrt_world.size());
   return true;
 }
 
+void ControlTabWidget::rebuildRotationIndex()
+{
+  effector_rotation_index_.clear();
+  for (const Eigen::Isometry3d& pose : samples_.effector_wrt_world)
+    effector_rotation_index_.insert(pose.rotation());
+  object_rotation_index_.clear();
+  for (const Eigen::Isometry3d& pose : samples_.object_wrt_sensor)
+    object_rotation_index_.insert(pose.rotation());
+}
+
+void ControlTabWidget::startStreaming()
+{
+  // Only detections captured after the start of the motion are streamed
+  sample_stream_.start({ frame_names_["sensor"], frame_names_["object"], frame_names_["base"], frame_names_["eef"] },
+                       tf2_ros::fromRclcpp(node_->now()));
+  stream_accepted_ = 0;
+  stream_rejected_motion_ = 0;
+  stream_rejected_similar_ = 0;
+  stream_timer_->start(STREAM_POLL_INTERVAL);
+}
+
+void ControlTabWidget::stopStreaming()
+{
+  if (!stream_timer_->isActive())
+    return;
+  stream_timer_->stop();
+  RCLCPP_INFO(node_->get_logger(),
+              "Streamed %zu samples, rejected %zu during fast motion and %zu too similar to a prior sample",
+              stream_accepted_, stream_rejected_motion_, stream_rejected_similar_);
+}
+
+void ControlTabWidget::streamSample()
+{
+  if (frame_names_["sensor"].empty() || frame_names_["object"].empty() || frame_names_["base"].empty() ||
+      frame_names_["eef"].empty())
+    return;
+
+  geometry_msgs::msg::TransformStamped camera_to_object_tf;
+  geometry_msgs::msg::TransformStamped base_to_eef_tf;
+  std::string error_message;
+  switch (sample_stream_.poll(*tf_buffer_, camera_to_object_tf, base_to_eef_tf, &error_message))
+  {
+    case mhc::STREAM_LOOKUP_FAILED:
+      RCLCPP_WARN_THROTTLE(node_->get_logger(), *node_->get_clock(), 1000,
+                           "TF exception while streaming samples: %s", error_message.c_str());
+      break;
+    case mhc::STREAM_FAST_MOTION:
+      ++stream_rejected_motion_;
+      break;
+    case mhc::STREAM_NEW_SAMPLE:
+      // The detection is only skipped once the sample is stored or rejected as too similar
+      if (addTransformSample(camera_to_object_tf, base_to_eef_tf, true))
+        ++stream_accepted_;
+      else
+        ++stream_rejected_similar_;
+      sample_stream_.markProcessed(camera_to_object_tf);
+      break;
+    default:
+      break;
+  }
+}
+
 void ControlTabWidget::solveBtnClicked(bool clicked)
 {
   solveCameraRobotPose();
@@ -429,10 +718,19 @@ void ControlTabWidget::solveBtnClicked(bool clicked)
 
 bool ControlTabWidget::solveCameraRobotPose()
 {
+  mhc::ScopedTrace trace("solveCameraRobotPose");
+
+  // Switch to the plugin providing the selected solver, the last loaded plugin is active after filling the list
+  const std::string plugin_name = parsePluginName(calibration_solver_->currentText().toStdString(), '/');
+  if (!plugin_name.empty() && plugin_name != solver_plugin_name_)
+    createSolverInstance(plugin_name);
+
   if (solver_ && !calibration_solver_->currentText().isEmpty())
   {
     std::string error_message;
-    bool res = solver_->solve(effector_wrt_world_, object_wrt_sensor_, sensor_mount_type_,
+    cancelUncertaintyEstimate();
+    solver_->setMotionPairMode(static_cast<mhc::MotionPairMode>(motion_pairs_->currentIndex()));
+    bool res = solver_->solve(samples_.effector_wrt_world, samples_.object_wrt_sensor, sensor_mount_type_,
                               parseSolverName(calibration_solver_->currentText().toStdString(), '/'), &error_message);
     if (res)
     {
@@ -444,12 +742,22 @@ bool ControlTabWidget::solveCameraRobotPose()
       Q_EMIT sensorPoseUpdate(t[0], t[1], t[2], r[0], r[1], r[2]);
 
       // Calculate reprojection error
-      const auto& reproj_err = solver_->getReprojectionError(effector_wrt_world_, object_wrt_sensor_,
-                                                             camera_robot_pose_, sensor_mount_type_);
+      const moveit_handeye_calibration::CalibrationError reproj_err = solver_->getCalibrationError(
+          samples_.effector_wrt_world, samples_.object_wrt_sensor, camera_robot_pose_, sensor_mount_type_);
       std::ostringstream reproj_err_text;
-      reproj_err_text << "Reprojection error:\n" << reproj_err.first << " m, " << reproj_err.second << " rad";
+      reproj_err_text << "Reprojection error:\n"
+                      << reproj_err.translation << " m, " << reproj_err.rotation << " rad";
       RCLCPP_WARN(node_->get_logger(), "%s", reproj_err_text.str().c_str());
+      reprojection_error_text_ = reproj_err_text.str();
       reprojection_error_label_->setText(QString(reproj_err_text.str().c_str()));
+      estimateUncertainty();
+
+      Eigen::Isometry3d object_robot_pose;
+      if (solver_->getObjectRobotPose(object_robot_pose))
+        RCLCPP_INFO_STREAM(node_->get_logger(), "Calibration object pose w.r.t. "
+                                                    << (sensor_mount_type_ == mhc::EYE_IN_HAND ? "base" : "eef")
+                                                    << " frame:" << std::endl
+                                                    << object_robot_pose.matrix());
 
       // Publish camera pose tf
       const std::string& from_frame = frame_names_[from_frame_tag_];
@@ -505,6 +813,102 @@ bool ControlTabWidget::solveCameraRobotPose()
   }
 }
 
+void ControlTabWidget::estimateUncertainty()
+{
+  cancelUncertaintyEstimate();
+  if (uncertainty_method_->currentIndex() <= 0 || !solver_)
+    return;
+
+  // Solver instances are created here, since plugin loading is not thread safe
+  const std::size_t num_threads = std::max(1, QThread::idealThreadCount());
+  if (uncertainty_solvers_.size() != num_threads || uncertainty_solver_plugin_name_ != solver_plugin_name_)
+  {
+    uncertainty_solvers_.clear();
+    try
+    {
+      for (std::size_t i = 0; i < num_threads; ++i)
+      {
+        uncertainty_solvers_.push_back(solver_plugins_loader_->createUniqueInstance(solver_plugin_name_));
+        uncertainty_solvers_.back()->initialize();
+      }
+      uncertainty_solver_plugin_name_ = solver_plugin_name_;
+    }
+    catch (pluginlib::PluginlibException& ex)
+    {
+      RCLCPP_ERROR_STREAM(node_->get_logger(),
+                          "Exception while loading handeye solver plugin for uncertainty estimation: "
+                              << solver_plugin_name_ << ex.what());
+      uncertainty_solvers_.clear();
+      return;
+    }
+  }
+
+  std::vector<mhc::HandEyeSolverBase*> solvers;
+  for (auto& solver : uncertainty_solvers_)
+  {
+    solver->setMotionPairMode(solver_->getMotionPairMode(), solver_->getMaxMotionPairs());
+    solvers.push_back(solver.get());
+  }
+
+  reprojection_error_label_->setText(QString::fromStdString(reprojection_error_text_ + "\nEstimating uncertainty..."));
+
+  // Samples are copied, so new samples can be taken while the estimate is running
+  const mhc::UncertaintyMethod method = static_cast<mhc::UncertaintyMethod>(uncertainty_method_->currentIndex() - 1);
+  const std::string solver_name = parseSolverName(calibration_solver_->currentText().toStdString(), '/');
+  uncertainty_cancel_ = std::make_shared<std::atomic<bool>>(false);
+  uncertainty_watcher_->setFuture(QtConcurrent::run([solvers, method, solver_name, cancel = uncertainty_cancel_,
+                                                     effector_wrt_world = samples_.effector_wrt_world,
+                                                     object_wrt_sensor = samples_.object_wrt_sensor,
+                                                     X = camera_robot_pose_, setup = sensor_mount_type_]() {
+    // A failed estimate is returned without resamples
+    mhc::CalibrationUncertainty uncertainty;
+    if (!mhc::estimateCalibrationUncertainty(solvers, effector_wrt_world, object_wrt_sensor, X, setup, solver_name,
+                                             method, BOOTSTRAP_RESAMPLES, uncertainty, 0, cancel.get()))
+      uncertainty.num_resamples = 0;
+    return uncertainty;
+  }));
+}
+
+void ControlTabWidget::cancelUncertaintyEstimate()
+{
+  uncertainty_valid_ = false;
+  if (uncertainty_cancel_)
+    *uncertainty_cancel_ = true;
+  // Also cancels a finished estimate whose result is not yet delivered to uncertaintyFinished
+  uncertainty_watcher_->cancel();
+
+  // Finished estimates no longer use their solver instances
+  canceled_uncertainty_estimates_.erase(
+      std::remove_if(canceled_uncertainty_estimates_.begin(), canceled_uncertainty_estimates_.end(),
+                     [](const CanceledUncertaintyEstimate& estimate) { return estimate.future.isFinished(); }),
+      canceled_uncertainty_estimates_.end());
+  if (uncertainty_watcher_->isRunning())
+  {
+    // The next estimate creates new solver instances, since these are still in use
+    canceled_uncertainty_estimates_.push_back({ uncertainty_watcher_->future(), std::move(uncertainty_solvers_) });
+    uncertainty_solvers_.clear();
+  }
+}
+
+void ControlTabWidget::uncertaintyFinished()
+{
+  // The estimate was canceled, since the calibration changed while it was running
+  if (uncertainty_watcher_->isCanceled())
+    return;
+
+  calibration_uncertainty_ = uncertainty_watcher_->result();
+  uncertainty_valid_ = calibration_uncertainty_.num_resamples > 0;
+  if (!uncertainty_valid_)
+  {
+    reprojection_error_label_->setText(QString::fromStdString(reprojection_error_text_ + "\nUncertainty: N/A"));
+    return;
+  }
+
+  const std::string uncertainty_text = mhc::getUncertaintyText(calibration_uncertainty_, "");
+  RCLCPP_INFO(node_->get_logger(), "%s", uncertainty_text.c_str());
+  reprojection_error_label_->setText(QString::fromStdString(reprojection_error_text_ + "\n" + uncertainty_text));
+}
+
 bool ControlTabWidget::frameNamesEmpty()
 {
   // All of four frame names needed for getting the pair of two tf transforms
@@ -594,7 +998,8 @@ void ControlTabWidget::takeSampleBtnClicked(bool clicked)
   if (frameNamesEmpty() || !takeTransformSamples())
     return;
 
-  if (effector_wrt_world_.size() == object_wrt_sensor_.size() && effector_wrt_world_.size() > 4)
+  if (samples_.effector_wrt_world.size() == samples_.object_wrt_sensor.size() &&
+      samples_.effector_wrt_world.size() > 4)
     if (!solveCameraRobotPose())
       return;
 
@@ -620,6 +1025,7 @@ void ControlTabWidget::takeSampleBtnClicked(bool clicked)
       {
         joint_names_ = names;
         joint_states_.push_back(state_joint_values);
+        sample_joint_states_.back() = state_joint_values;
         auto_progress_->setMax(joint_states_.size());
       }
     }
@@ -628,27 +1034,45 @@ void ControlTabWidget::takeSampleBtnClicked(bool clicked)
 
 void ControlTabWidget::deleteLatestSampleBtnClicked(bool clicked)
 {
-  if (joint_states_.empty())
+  if (samples_.effector_wrt_world.empty())
   {
     QMessageBox::warning(this, tr("Empty Pose samples"), tr("Cannot delete last sample, list is already empty."));
     return;
   }
 
   // Delete latest recorded transform
-  effector_wrt_world_.pop_back();
-  object_wrt_sensor_.pop_back();
-
-  // Delete latest recorded joint state, update progress bar
-  joint_states_.pop_back();
-  tree_view_model_->takeRow(joint_states_.size());
-  auto_progress_->setMax(joint_states_.size());
+  samples_.effector_wrt_world.pop_back();
+  samples_.object_wrt_sensor.pop_back();
+  samples_.stamps.pop_back();
+  if (effector_rotation_index_.size() > samples_.effector_wrt_world.size())
+    effector_rotation_index_.removeLast();
+  if (object_rotation_index_.size() > samples_.object_wrt_sensor.size())
+    object_rotation_index_.removeLast();
+  tree_view_model_->removeRow(samples_.effector_wrt_world.size());
+
+  // Delete the joint state recorded with the sample, which planning may have moved within joint_states_
+  const std::vector<double> joint_state = std::move(sample_joint_states_.back());
+  sample_joint_states_.pop_back();
+  if (!joint_state.empty())
+  {
+    auto it = std::find(joint_states_.rbegin(), joint_states_.rend(), joint_state);
+    if (it != joint_states_.rend())
+    {
+      joint_states_.erase(std::next(it).base());
+      auto_progress_->setMax(joint_states_.size());
+    }
+  }
 }
 
 void ControlTabWidget::clearSamplesBtnClicked(bool clicked)
 {
   // Clear recorded transforms
-  effector_wrt_world_.clear();
-  object_wrt_sensor_.clear();
+  samples_.effector_wrt_world.clear();
+  samples_.object_wrt_sensor.clear();
+  samples_.stamps.clear();
+  sample_joint_states_.clear();
+  effector_rotation_index_.clear();
+  object_rotation_index_.clear();
   tree_view_model_->clear();
 
   // Clear recorded joint states
@@ -692,38 +1116,8 @@ void ControlTabWidget::saveCameraPoseBtnClicked(bool clicked)
     return;
   }
 
-  Eigen::Vector3d t = camera_robot_pose_.translation();
-  Eigen::Quaterniond r_quat(camera_robot_pose_.rotation());
-  Eigen::Vector3d r_euler = camera_robot_pose_.rotation().eulerAngles(0, 1, 2);
-
-  std::string mount_type;
-  switch (sensor_mount_type_)
-  {
-    case mhc::EYE_TO_HAND:
-      mount_type = "EYE-TO-HAND";
-      break;
-    case mhc::EYE_IN_HAND:
-      mount_type = "EYE-IN-HAND";
-      break;
-    default:
-      RCLCPP_ERROR_STREAM(node_->get_logger(), "Error sensor mount type.");
-      break;
-  }
-
-  std::stringstream ss;
-  if (file_name.endsWith(".py"))
-  {
-    ss = generateCalibrationPython(from_frame, to_frame, t, r_quat, r_euler, mount_type);
-  }
-  else if (file_name.endsWith(".xml"))
-  {
-    ss = generateCalibrationXml(from_frame, to_frame, t, r_quat, r_euler, mount_type);
-  }
-  else if (file_name.endsWith(".yaml") || file_name.endsWith(".yml"))
-  {
-    ss = generateCalibrationYaml(from_frame, to_frame, t, r_quat, r_euler, mount_type);
-  }
-  else
+  mhc::LaunchFormat format;
+  if (!mhc::getLaunchFormat(file_name.toStdString(), format))
   {
     QMessageBox::warning(
         this, tr("Unknown file type"),
@@ -732,6 +1126,9 @@ void ControlTabWidget::saveCameraPoseBtnClicked(bool clicked)
     return;
   }
 
+  const std::stringstream ss = mhc::generateCalibrationLaunch(format, from_frame, to_frame, camera_robot_pose_,
+                                                              sensor_mount_type_,
+                                                              uncertainty_valid_ ? &calibration_uncertainty_ : nullptr);
   QTextStream out(&file);
   out << ss.str().c_str();
 }
@@ -763,6 +1160,7 @@ void ControlTabWidget::setGroupName(const std::string& group_name)
 
     // Clear the joint values from any previous group
     joint_states_.clear();
+    cached_plans_.clear();
     auto_progress_->setMax(0);
   }
   catch (std::exception& ex)
@@ -847,53 +1245,80 @@ void ControlTabWidget::saveJointStateBtnClicked(bool clicked)
 
   QTextStream out(&file);
   out << emitter.c_str();
+
+  joint_state_file_ = file_name;
+  saveCachedPlans();
 }
 
 void ControlTabWidget::loadSamplesBtnClicked(bool clicked)
 {
-  QString file_name = QFileDialog::getOpenFileName(this, tr("Load Samples"), "", tr("Target File (*.yaml)"), nullptr,
-                                                   QFileDialog::DontUseNativeDialog);
-
-  if (file_name.isEmpty())
+  if (yaml_load_watcher_->isRunning())
     return;
 
-  effector_wrt_world_.clear();
-  object_wrt_sensor_.clear();
+  QString file_name =
+      QFileDialog::getOpenFileName(this, tr("Load Samples"), "", tr("Sample File (*.yaml *.samples)"), nullptr,
+                                   QFileDialog::DontUseNativeDialog);
 
-  // transformations are serialised as 4x4 row-major matrices
-  typedef Eigen::Matrix<double, 4, 4, Eigen::RowMajor> Matrix4d_rm;
+  if (file_name.isEmpty())
+    return;
 
-  YAML::Node yaml_states = YAML::LoadFile(file_name.toStdString());
-  try
+  if (!file_name.endsWith(".samples"))
   {
-    for (std::size_t i = 0; i < yaml_states.size(); i++)
-    {
-      effector_wrt_world_.emplace_back(
-          Eigen::Map<const Matrix4d_rm>(yaml_states[i]["effector_wrt_world"].as<std::vector<double>>().data()));
+    // Large YAML files are read on a background thread, and the samples are shown as they are read. They replace the
+    // current samples once the whole file is read.
+    tree_view_model_->clear();
+    startYamlLoading(file_name, false);
+    return;
+  }
 
-      object_wrt_sensor_.emplace_back(
-          Eigen::Map<const Matrix4d_rm>(yaml_states[i]["object_wrt_sensor"].as<std::vector<double>>().data()));
+  if (!loadBinarySamples(file_name.toStdString()))
+    return;
 
-      // add to GUI
-      ControlTabWidget::addPoseSampleToTreeView(tf2::eigenToTransform(object_wrt_sensor_.back()),
-                                                tf2::eigenToTransform(effector_wrt_world_.back()),
-                                                effector_wrt_world_.size());
-    }
+  tree_view_model_->clear();
+  addSamplesToTreeView(samples_, 0);
+  auto_progress_->setMax(samples_.effector_wrt_world.size());
+  auto_progress_->setValue(samples_.effector_wrt_world.size());
+  rebuildRotationIndex();
+}
+
+void ControlTabWidget::addSamplesToTreeView(const mhc::SampleSet& samples, std::size_t first)
+{
+  sample_tree_view_->setUpdatesEnabled(false);
+  for (std::size_t i = first; i < samples.effector_wrt_world.size(); ++i)
+    addPoseSampleToTreeView(tf2::eigenToTransform(samples.object_wrt_sensor[i]),
+                            tf2::eigenToTransform(samples.effector_wrt_world[i]), i + 1);
+  sample_tree_view_->setUpdatesEnabled(true);
+}
 
-    auto_progress_->setMax(yaml_states.size());
-    auto_progress_->setValue(yaml_states.size());
+bool ControlTabWidget::loadBinarySamples(const std::string& file_name)
+{
+  // The samples are read into a temporary set, so the current ones are kept if the file can't be read
+  mhc::SampleSet samples;
+  std::string error_message;
+  if (!mhc::readSampleFile(file_name, samples, &error_message))
+  {
+    QMessageBox::warning(this, tr("Unable to load samples"), QString::fromStdString(error_message));
+    return false;
   }
-  catch (const YAML::Exception& e)
+  samples.stamps.resize(samples.effector_wrt_world.size(), 0.);
+
+  // Joint states recorded with the samples can be replayed for auto calibration
+  sample_joint_states_ = samples.joint_states;
+  sample_joint_states_.resize(samples.effector_wrt_world.size());
+  if (!samples.joint_states.empty())
   {
-    QMessageBox::critical(this, "YAML Exception",
-                          QString::fromStdString("YAML exception: " + std::string(e.what()) +
-                                                 "\nCheck that the sample file has the correct format."));
+    joint_names_.swap(samples.joint_names);
+    joint_states_.swap(samples.joint_states);
   }
+  samples.joint_names.clear();
+  samples.joint_states.clear();
+  samples_ = std::move(samples);
+  return true;
 }
 
 void ControlTabWidget::saveSamplesBtnClicked(bool clicked)
 {
-  if (effector_wrt_world_.size() != object_wrt_sensor_.size())
+  if (samples_.effector_wrt_world.size() != samples_.object_wrt_sensor.size())
   {
     RCLCPP_ERROR_STREAM(node_->get_logger(), "Different number of poses");
     return;
@@ -901,12 +1326,18 @@ void ControlTabWidget::saveSamplesBtnClicked(bool clicked)
 
   // DontUseNativeDialog option set to avoid this issue: https://github.com/ros-planning/moveit/issues/2357
   QString file_name =
-      QFileDialog::getSaveFileName(this, tr("Save Samples"), "", tr("Target File (*.yaml);;All Files (*)"), nullptr,
-                                   QFileDialog::DontUseNativeDialog);
+      QFileDialog::getSaveFileName(this, tr("Save Samples"), "", tr("Target File (*.yaml);;Binary File (*.samples)"),
+                                   nullptr, QFileDialog::DontUseNativeDialog);
 
   if (file_name.isEmpty())
     return;
 
+  if (file_name.endsWith(".samples"))
+  {
+    saveBinarySamples(file_name.toStdString());
+    return;
+  }
+
   if (!file_name.endsWith(".yaml"))
     file_name += ".yaml";
 
@@ -919,7 +1350,7 @@ void ControlTabWidget::saveSamplesBtnClicked(bool clicked)
 
   YAML::Emitter emitter;
   emitter << YAML::BeginSeq;
-  for (size_t i = 0; i < effector_wrt_world_.size(); i++)
+  for (size_t i = 0; i < samples_.effector_wrt_world.size(); i++)
   {
     emitter << YAML::Value << YAML::BeginMap;
     emitter << YAML::Key << "effector_wrt_world";
@@ -928,7 +1359,7 @@ void ControlTabWidget::saveSamplesBtnClicked(bool clicked)
     {
       for (size_t x = 0; x < 4; x++)
       {
-        emitter << YAML::Value << effector_wrt_world_[i](y, x);
+        emitter << YAML::Value << samples_.effector_wrt_world[i](y, x);
       }
     }
     emitter << YAML::EndSeq;
@@ -938,7 +1369,7 @@ void ControlTabWidget::saveSamplesBtnClicked(bool clicked)
     {
       for (size_t x = 0; x < 4; x++)
       {
-        emitter << YAML::Value << object_wrt_sensor_[i](y, x);
+        emitter << YAML::Value << samples_.object_wrt_sensor[i](y, x);
       }
     }
     emitter << YAML::EndSeq;
@@ -950,8 +1381,29 @@ void ControlTabWidget::saveSamplesBtnClicked(bool clicked)
   out << emitter.c_str();
 }
 
+void ControlTabWidget::saveBinarySamples(const std::string& file_name)
+{
+  mhc::SampleSet samples = samples_;
+  // Stamps are only stored when at least one detection time is known
+  if (std::all_of(samples.stamps.begin(), samples.stamps.end(), [](double stamp) { return stamp == 0.; }))
+    samples.stamps.clear();
+  // Joint states are only stored when they were recorded together with the samples
+  if (joint_states_.size() == samples_.effector_wrt_world.size() && checkJointStates())
+  {
+    samples.joint_names = joint_names_;
+    samples.joint_states = joint_states_;
+  }
+
+  std::string error_message;
+  if (!mhc::writeSampleFile(file_name, samples, &error_message))
+    QMessageBox::warning(this, tr("Unable to save samples"), QString::fromStdString(error_message));
+}
+
 void ControlTabWidget::loadJointStateBtnClicked(bool clicked)
 {
+  if (yaml_load_watcher_->isRunning())
+    return;
+
   // DontUseNativeDialog option set to avoid this issue: https://github.com/ros-planning/moveit/issues/2357
   QString file_name =
       QFileDialog::getOpenFileName(this, tr("Load Joint States"), "", tr("Target File (*.yaml);;All Files (*)"),
@@ -967,139 +1419,577 @@ void ControlTabWidget::loadJointStateBtnClicked(bool clicked)
     return;
   }
 
-  // Begin parsing
+  RCLCPP_DEBUG_STREAM(node_->get_logger(), "Load joint states from file: " << file_name.toStdString().c_str());
+  startYamlLoading(file_name, true);
+}
+
+void ControlTabWidget::startYamlLoading(const QString& file_name, bool joint_states)
+{
+  yaml_load_file_ = file_name;
+  yaml_load_joint_states_ = joint_states;
+  yaml_load_error_.clear();
+  yaml_samples_ = mhc::SampleSet();
+  yaml_joint_names_.clear();
+  yaml_joint_states_.clear();
+  load_samples_btn_->setEnabled(false);
+  load_joint_state_btn_->setEnabled(false);
+  auto_progress_->setStatus("Loading " + QFileInfo(file_name).fileName());
+  yaml_flush_timer_->start(YAML_FLUSH_INTERVAL);
+  yaml_load_watcher_->setFuture(QtConcurrent::run(this, &ControlTabWidget::loadYaml));
+}
+
+void ControlTabWidget::loadYaml()
+{
+  std::ifstream input(yaml_load_file_.toStdString());
   try
   {
-    RCLCPP_DEBUG_STREAM(node_->get_logger(), "Load joint states from file: " << file_name.toStdString().c_str());
-    YAML::Node doc = YAML::LoadFile(file_name.toStdString());
-    if (!doc.IsMap())
-      return;
+    if (!input.is_open())
+      throw std::runtime_error("Unable to open " + yaml_load_file_.toStdString());
 
-    // Read joint names
-    const YAML::Node& names = doc["joint_names"];
-    if (!names.IsNull() && names.IsSequence())
+    if (yaml_load_joint_states_)
     {
-      joint_names_.clear();
-      for (YAML::const_iterator it = names.begin(); it != names.end(); ++it)
-        joint_names_.push_back(it->as<std::string>());
+      JointStateYamlLoader loader(
+          [this](const std::vector<std::string>& joint_names) {
+            std::lock_guard<std::mutex> lock(yaml_load_mutex_);
+            loaded_joint_names_ = joint_names;
+          },
+          [this](const std::vector<double>& joint_state) {
+            std::lock_guard<std::mutex> lock(yaml_load_mutex_);
+            loaded_joint_states_.push_back(joint_state);
+          });
+      loader.parse(input);
     }
     else
     {
-      RCLCPP_ERROR_STREAM(node_->get_logger(), "Can't find 'joint_names' in the opened file.");
-      return;
+      SampleYamlLoader loader([this](const Eigen::Isometry3d& effector_wrt_world,
+                                     const Eigen::Isometry3d& object_wrt_sensor) {
+        std::lock_guard<std::mutex> lock(yaml_load_mutex_);
+        loaded_effector_wrt_world_.push_back(effector_wrt_world);
+        loaded_object_wrt_sensor_.push_back(object_wrt_sensor);
+      });
+      loader.parse(input);
     }
+  }
+  catch (const std::exception& e)
+  {
+    std::lock_guard<std::mutex> lock(yaml_load_mutex_);
+    yaml_load_error_ = e.what();
+  }
+}
+
+void ControlTabWidget::flushLoadedYaml()
+{
+  std::vector<std::string> joint_names;
+  std::vector<std::vector<double>> joint_states;
+  std::vector<Eigen::Isometry3d> effector_wrt_world;
+  std::vector<Eigen::Isometry3d> object_wrt_sensor;
+  {
+    std::lock_guard<std::mutex> lock(yaml_load_mutex_);
+    joint_names.swap(loaded_joint_names_);
+    joint_states.swap(loaded_joint_states_);
+    effector_wrt_world.swap(loaded_effector_wrt_world_);
+    object_wrt_sensor.swap(loaded_object_wrt_sensor_);
+  }
+
+  if (!joint_names.empty())
+    yaml_joint_names_ = joint_names;
+  if (!joint_states.empty())
+  {
+    yaml_joint_states_.insert(yaml_joint_states_.end(), joint_states.begin(), joint_states.end());
+    auto_progress_->setStatus(QString("Loaded %1 joint states").arg(yaml_joint_states_.size()));
+  }
+
+  if (effector_wrt_world.empty())
+    return;
 
-    // Read joint values
-    const YAML::Node& values = doc["joint_values"];
-    if (!values.IsNull() && values.IsSequence())
+  const std::size_t first = yaml_samples_.effector_wrt_world.size();
+  yaml_samples_.effector_wrt_world.insert(yaml_samples_.effector_wrt_world.end(), effector_wrt_world.begin(),
+                                          effector_wrt_world.end());
+  yaml_samples_.object_wrt_sensor.insert(yaml_samples_.object_wrt_sensor.end(), object_wrt_sensor.begin(),
+                                         object_wrt_sensor.end());
+  yaml_samples_.stamps.resize(yaml_samples_.effector_wrt_world.size(), 0.);
+  addSamplesToTreeView(yaml_samples_, first);
+  auto_progress_->setStatus(QString("Loaded %1 samples").arg(yaml_samples_.effector_wrt_world.size()));
+}
+
+void ControlTabWidget::yamlLoadFinished()
+{
+  yaml_flush_timer_->stop();
+  flushLoadedYaml();
+  load_samples_btn_->setEnabled(true);
+  load_joint_state_btn_->setEnabled(true);
+  auto_progress_->setStatus("");
+
+  if (yaml_load_joint_states_)
+  {
+    if (!yaml_load_error_.empty())
     {
-      joint_states_.clear();
-      for (YAML::const_iterator state_it = values.begin(); state_it != values.end(); ++state_it)
-      {
-        std::vector<double> jv;
-        if (!state_it->IsNull() && state_it->IsSequence())
-          for (YAML::const_iterator joint_it = state_it->begin(); joint_it != state_it->end(); ++joint_it)
-            jv.push_back(joint_it->as<double>());
-        if (jv.size() == joint_names_.size())
-          joint_states_.push_back(jv);
-      }
+      // Keep the joint states from before the load
+      RCLCPP_ERROR_STREAM(node_->get_logger(), yaml_load_error_);
+      yaml_joint_names_.clear();
+      yaml_joint_states_.clear();
+      return;
     }
-    else
+
+    joint_names_.swap(yaml_joint_names_);
+    joint_states_.swap(yaml_joint_states_);
+    yaml_joint_names_.clear();
+    yaml_joint_states_.clear();
+    if (joint_states_.size() > 0)
     {
-      RCLCPP_ERROR_STREAM(node_->get_logger(), "Can't find 'joint_values' in the opened file.");
-      return;
+      auto_progress_->setMax(joint_states_.size());
+      auto_progress_->setValue(0);
     }
+    RCLCPP_INFO_STREAM(node_->get_logger(), "Loaded and parsed: " << yaml_load_file_.toStdString());
+
+    joint_state_file_ = yaml_load_file_;
+    loadCachedPlans();
+    return;
   }
-  catch (YAML::ParserException& e)  // Catch errors
+
+  if (!yaml_load_error_.empty())
   {
-    RCLCPP_ERROR_STREAM(node_->get_logger(), e.what());
+    QMessageBox::critical(this, "YAML Exception",
+                          QString::fromStdString("YAML exception: " + yaml_load_error_ +
+                                                 "\nCheck that the sample file has the correct format."));
+    // Keep the samples from before the load
+    yaml_samples_ = mhc::SampleSet();
+    tree_view_model_->clear();
+    addSamplesToTreeView(samples_, 0);
     return;
   }
 
-  if (joint_states_.size() > 0)
+  samples_ = std::move(yaml_samples_);
+  yaml_samples_ = mhc::SampleSet();
+  sample_joint_states_.assign(samples_.effector_wrt_world.size(), std::vector<double>());
+  auto_progress_->setMax(samples_.effector_wrt_world.size());
+  auto_progress_->setValue(samples_.effector_wrt_world.size());
+  rebuildRotationIndex();
+}
+
+void ControlTabWidget::publishTraceDiagnostics()
+{
+  const std::map<std::string, mhc::TraceStatistics> statistics = mhc::TraceBuffer::instance().getStatistics();
+  if (statistics.empty())
+    return;
+
+  diagnostic_msgs::msg::DiagnosticStatus status;
+  status.name = std::string(node_->get_name()) + ": Hand-eye calibration stage latencies";
+  status.level = diagnostic_msgs::msg::DiagnosticStatus::OK;
+  status.message = "Latest " + std::to_string(mhc::TraceBuffer::CAPACITY) + " traced stage calls";
+  auto add_value = [&status](const std::string& key, const std::string& value) {
+    diagnostic_msgs::msg::KeyValue key_value;
+    key_value.key = key;
+    key_value.value = value;
+    status.values.push_back(key_value);
+  };
+  for (const auto& stage : statistics)
   {
-    auto_progress_->setMax(joint_states_.size());
-    auto_progress_->setValue(0);
+    add_value(stage.first + " count", std::to_string(stage.second.count));
+    add_value(stage.first + " last (ms)", std::to_string(stage.second.last * 1e3));
+    add_value(stage.first + " mean (ms)", std::to_string(stage.second.mean * 1e3));
+    add_value(stage.first + " p95 (ms)", std::to_string(stage.second.p95 * 1e3));
+    add_value(stage.first + " max (ms)", std::to_string(stage.second.max * 1e3));
   }
-  RCLCPP_INFO_STREAM(node_->get_logger(), "Loaded and parsed: " << file_name.toStdString());
+
+  diagnostic_msgs::msg::DiagnosticArray array;
+  array.header.stamp = node_->now();
+  array.status.push_back(status);
+  diagnostic_pub_->publish(array);
 }
 
 void ControlTabWidget::autoPlanBtnClicked(bool clicked)
 {
+  // The plan is applied by planFinished on the GUI thread, so it can't be executed before
   auto_plan_btn_->setEnabled(false);
-  plan_watcher_->setFuture(QtConcurrent::run(this, &ControlTabWidget::computePlan));
+  auto_execute_btn_->setEnabled(false);
+  PlanningRequest request = getPlanningRequest(auto_progress_->getValue());
+  request.setup_result = checkPlanningSetup();
+  plan_watcher_->setFuture(QtConcurrent::run(this, &ControlTabWidget::computePlan, request));
 }
 
-void ControlTabWidget::computePlan()
+ControlTabWidget::PLANNING_RESULT ControlTabWidget::checkPlanningSetup()
 {
-  planning_res_ = ControlTabWidget::SUCCESS;
   int max = auto_progress_->bar_->maximum();
 
   if (max != joint_states_.size() || auto_progress_->getValue() == max)
+    return ControlTabWidget::FAILURE_NO_JOINT_STATE;
+
+  if (!checkJointStates())
+    return ControlTabWidget::FAILURE_INVALID_JOINT_STATE;
+
+  if (!planning_scene_monitor_)
+    return ControlTabWidget::FAILURE_NO_PSM;
+
+  if (!move_group_)
+    return ControlTabWidget::FAILURE_NO_MOVE_GROUP;
+
+  if (move_group_->getActiveJoints() != joint_names_)
+    return ControlTabWidget::FAILURE_WRONG_MOVE_GROUP;
+
+  return ControlTabWidget::SUCCESS;
+}
+
+ControlTabWidget::PlanningRequest ControlTabWidget::getPlanningRequest(std::size_t first)
+{
+  PlanningRequest request;
+  request.group = move_group_;
+  request.planning_scene_monitor = planning_scene_monitor_;
+  request.first = first;
+  request.progress = auto_progress_->getValue();
+  request.joint_names = joint_names_;
+  request.joint_states = joint_states_;
+  request.cached_plans = cached_plans_;
+  request.select_next_pose = select_next_pose_->isChecked();
+  request.effector_wrt_world = samples_.effector_wrt_world;
+  request.sensor_mount_type = sensor_mount_type_;
+  request.motion_pair_mode = static_cast<mhc::MotionPairMode>(motion_pairs_->currentIndex());
+  request.base_frame = frame_names_["base"];
+  request.eef_frame = frame_names_["eef"];
+  return request;
+}
+
+bool ControlTabWidget::applyPlanningResult(const PlanningResult& result)
+{
+  if (result.recorded_joint_states != joint_states_)
   {
-    planning_res_ = ControlTabWidget::FAILURE_NO_JOINT_STATE;
-    return;
+    RCLCPP_WARN_STREAM(node_->get_logger(), "Recorded joint states changed while planning, discarding the plan.");
+    return false;
   }
+  joint_states_ = result.joint_states;
+  return true;
+}
 
-  if (!checkJointStates())
+moveit::core::RobotStatePtr ControlTabWidget::getCurrentRobotState(const PlanningRequest& request)
+{
+  moveit::core::RobotStatePtr start_state = request.group->getCurrentState();
+  request.planning_scene_monitor->waitForCurrentRobotState(rclcpp::Clock(RCL_ROS_TIME).now(), 0.1);
+  const planning_scene_monitor::LockedPlanningSceneRO& ps =
+      planning_scene_monitor::LockedPlanningSceneRO(request.planning_scene_monitor);
+  if (ps)
+    start_state.reset(new moveit::core::RobotState(ps->getCurrentState()));
+  return start_state;
+}
+
+ControlTabWidget::PlanningResult ControlTabWidget::computePlan(PlanningRequest request)
+{
+  PlanningResult result;
+  result.result = request.setup_result;
+  if (result.result != ControlTabWidget::SUCCESS)
+    return result;
+  result.recorded_joint_states = request.joint_states;
+
+  // Get current joint state as start state
+  moveit::core::RobotStatePtr start_state = getCurrentRobotState(request);
+
+  // Plan motion to the recorded joint state target
+  moveit::planning_interface::MoveGroupInterface::PlanPtr plan;
+  result.result = planJointState(request, *start_state, request.first, plan);
+  if (result.result == ControlTabWidget::SUCCESS)
   {
-    planning_res_ = ControlTabWidget::FAILURE_INVALID_JOINT_STATE;
-    return;
+    RCLCPP_DEBUG_STREAM(node_->get_logger(), "Planning succeed.");
+    result.plans.push_back(plan);
   }
+  else
+    RCLCPP_ERROR_STREAM(node_->get_logger(), "Planning failed.");
 
-  if (!planning_scene_monitor_)
+  result.joint_states = std::move(request.joint_states);
+  return result;
+}
+
+ControlTabWidget::PlanningResult ControlTabWidget::computeAllPlans(PlanningRequest request)
+{
+  PlanningResult result;
+  result.result = request.setup_result;
+  if (result.result != ControlTabWidget::SUCCESS)
+    return result;
+  result.recorded_joint_states = request.joint_states;
+
+  // Plan each joint state from the goal of the previous plan
+  moveit::core::RobotStatePtr start_state = getCurrentRobotState(request);
+  for (std::size_t i = request.first; i < request.joint_states.size(); ++i)
   {
-    planning_res_ = ControlTabWidget::FAILURE_NO_PSM;
-    return;
+    moveit::planning_interface::MoveGroupInterface::PlanPtr plan;
+    result.result = planJointState(request, *start_state, i, plan);
+    if (result.result != ControlTabWidget::SUCCESS)
+    {
+      RCLCPP_ERROR_STREAM(node_->get_logger(), "Planning to joint state " << i + 1 << " failed.");
+      result.plans.clear();
+      return result;
+    }
+    const trajectory_msgs::msg::JointTrajectory& trajectory = plan->trajectory.joint_trajectory;
+    if (!trajectory.points.empty())
+      start_state->setVariablePositions(trajectory.joint_names, trajectory.points.back().positions);
+    start_state->update();
+    result.plans.push_back(plan);
   }
 
-  if (!move_group_)
+  result.all_plans = true;
+  result.joint_states = std::move(request.joint_states);
+  return result;
+}
+
+ControlTabWidget::PlanningResult ControlTabWidget::computeLookaheadPlan(PlanningRequest request)
+{
+  PlanningResult result;
+  result.recorded_joint_states = request.joint_states;
+
+  moveit::core::RobotStatePtr start_state;
   {
-    planning_res_ = ControlTabWidget::FAILURE_NO_MOVE_GROUP;
-    return;
+    const planning_scene_monitor::LockedPlanningSceneRO& ps =
+        planning_scene_monitor::LockedPlanningSceneRO(request.planning_scene_monitor);
+    if (!ps)
+    {
+      result.result = ControlTabWidget::FAILURE_NO_PSM;
+      return result;
+    }
+    start_state.reset(new moveit::core::RobotState(ps->getCurrentState()));
   }
 
-  if (move_group_->getActiveJoints() != joint_names_)
+  // Start from the goal of the motion being executed
+  start_state->setVariablePositions(request.start_joint_names, request.start_positions);
+  start_state->update();
+
+  moveit::planning_interface::MoveGroupInterface::PlanPtr plan;
+  result.result = planJointState(request, *start_state, request.first, plan);
+  if (result.result == ControlTabWidget::SUCCESS)
+  {
+    RCLCPP_DEBUG_STREAM(node_->get_logger(), "Planning of the next joint state succeed.");
+    result.plans.push_back(plan);
+  }
+  else
+    RCLCPP_WARN_STREAM(node_->get_logger(), "Planning of the next joint state failed, retrying after execution.");
+
+  result.joint_states = std::move(request.joint_states);
+  return result;
+}
+
+ControlTabWidget::PLANNING_RESULT ControlTabWidget::planJointState(
+    PlanningRequest& request, const moveit::core::RobotState& start_state, std::size_t index,
+    moveit::planning_interface::MoveGroupInterface::PlanPtr& plan)
+{
+  if (findCachedPlan(request, start_state, index, plan))
+    return ControlTabWidget::SUCCESS;
+
+  if (request.select_next_pose)
+    selectNextJointState(request, start_state, index);
+
+  moveit::planning_interface::MoveGroupInterface& group = *request.group;
+  group.setStartState(start_state);
+  group.setJointValueTarget(request.joint_states[index]);
+  group.setMaxVelocityScalingFactor(0.5);
+  group.setMaxAccelerationScalingFactor(0.5);
+  plan.reset(new moveit::planning_interface::MoveGroupInterface::Plan());
+  return (group.plan(*plan) == moveit::core::MoveItErrorCode::SUCCESS) ? ControlTabWidget::SUCCESS :
+                                                                          ControlTabWidget::FAILURE_PLAN_FAILED;
+}
+
+bool ControlTabWidget::findCachedPlan(PlanningRequest& request, const moveit::core::RobotState& start_state,
+                                      std::size_t index, moveit::planning_interface::MoveGroupInterface::PlanPtr& plan)
+{
+  const std::string group_name = request.group->getName();
+  auto is_close = [](const std::vector<double>& a, const std::vector<double>& b) {
+    if (a.size() != b.size())
+      return false;
+    for (std::size_t i = 0; i < a.size(); ++i)
+      if (std::abs(a[i] - b[i]) > CACHED_PLAN_TOLERANCE)
+        return false;
+    return true;
+  };
+
+  std::vector<double> start_values;
+  for (const std::string& name : request.joint_names)
+    start_values.push_back(start_state.getVariablePosition(name));
+
+  for (const moveit::planning_interface::MoveGroupInterface::PlanPtr& cached_plan : request.cached_plans)
+  {
+    // A cached plan is replayed if it starts at the start state and ends at one of the remaining joint states. Its
+    // goal is moved to the front, so a cached sequence is replayed in its planned order.
+    const trajectory_msgs::msg::JointTrajectory& trajectory = cached_plan->trajectory.joint_trajectory;
+    if (trajectory.points.empty() || trajectory.joint_names != request.joint_names ||
+        !is_close(trajectory.points.front().positions, start_values))
+      continue;
+
+    std::size_t goal = index;
+    while (goal < request.joint_states.size() &&
+           !is_close(trajectory.points.back().positions, request.joint_states[goal]))
+      ++goal;
+    if (goal == request.joint_states.size())
+      continue;
+
+    // The planning scene may have changed since the plan was cached
+    const planning_scene_monitor::LockedPlanningSceneRO& ps =
+        planning_scene_monitor::LockedPlanningSceneRO(request.planning_scene_monitor);
+    if (!ps)
+      return false;
+    robot_trajectory::RobotTrajectory robot_trajectory(ps->getRobotModel(), group_name);
+    robot_trajectory.setRobotTrajectoryMsg(start_state, cached_plan->trajectory);
+    if (!ps->isPathValid(robot_trajectory, group_name))
+    {
+      RCLCPP_WARN_STREAM(node_->get_logger(), "Cached plan to joint state " << goal + 1 << " is no longer valid.");
+      continue;
+    }
+
+    std::swap(request.joint_states[index], request.joint_states[goal]);
+    plan = cached_plan;
+    RCLCPP_DEBUG_STREAM(node_->get_logger(), "Replaying cached plan to joint state " << index + 1 << ".");
+    return true;
+  }
+  return false;
+}
+
+QString ControlTabWidget::getCachedPlansFileName() const
+{
+  if (joint_state_file_.isEmpty())
+    return QString();
+  const QFileInfo info(joint_state_file_);
+  return info.path() + "/" + info.completeBaseName() + "_plans.yaml";
+}
+
+bool ControlTabWidget::saveCachedPlans()
+{
+  const QString file_name = getCachedPlansFileName();
+  if (file_name.isEmpty() || cached_plans_.empty())
+    return false;
+
+  QFile file(file_name);
+  if (!file.open(QIODevice::WriteOnly))
+  {
+    RCLCPP_ERROR_STREAM(node_->get_logger(), "Unable to open file: " << file_name.toStdString());
+    return false;
+  }
+
+  YAML::Emitter emitter;
+  emitter << YAML::BeginMap;
+
+  emitter << YAML::Key << "joint_names";
+  emitter << YAML::Value << YAML::Flow << joint_names_;
+
+  // One trajectory of the joint positions, velocities and accelerations per plan
+  emitter << YAML::Key << "plans";
+  emitter << YAML::Value << YAML::BeginSeq;
+  for (const moveit::planning_interface::MoveGroupInterface::PlanPtr& plan : cached_plans_)
+  {
+    emitter << YAML::BeginSeq;
+    for (const trajectory_msgs::msg::JointTrajectoryPoint& point : plan->trajectory.joint_trajectory.points)
+    {
+      emitter << YAML::BeginMap;
+      emitter << YAML::Key << "time_from_start" << YAML::Value << rclcpp::Duration(point.time_from_start).seconds();
+      emitter << YAML::Key << "positions" << YAML::Value << YAML::Flow << point.positions;
+      emitter << YAML::Key << "velocities" << YAML::Value << YAML::Flow << point.velocities;
+      emitter << YAML::Key << "accelerations" << YAML::Value << YAML::Flow << point.accelerations;
+      emitter << YAML::EndMap;
+    }
+    emitter << YAML::EndSeq;
+  }
+  emitter << YAML::EndSeq;
+
+  emitter << YAML::EndMap;
+
+  QTextStream out(&file);
+  out << emitter.c_str();
+  return true;
+}
+
+void ControlTabWidget::loadCachedPlans()
+{
+  cached_plans_.clear();
+  const QString file_name = getCachedPlansFileName();
+  if (file_name.isEmpty() || !QFile::exists(file_name))
+    return;
+
+  try
   {
-    planning_res_ = ControlTabWidget::FAILURE_WRONG_MOVE_GROUP;
+    YAML::Node doc = YAML::LoadFile(file_name.toStdString());
+    if (!doc.IsMap() || !doc["joint_names"] || doc["joint_names"].as<std::vector<std::string>>() != joint_names_ ||
+        !doc["plans"].IsSequence())
+    {
+      RCLCPP_WARN_STREAM(node_->get_logger(), "Ignoring cached plans for other joints: " << file_name.toStdString());
+      return;
+    }
+
+    for (const YAML::Node& points : doc["plans"])
+    {
+      moveit::planning_interface::MoveGroupInterface::PlanPtr plan(
+          new moveit::planning_interface::MoveGroupInterface::Plan());
+      trajectory_msgs::msg::JointTrajectory& trajectory = plan->trajectory.joint_trajectory;
+      trajectory.joint_names = joint_names_;
+      for (const YAML::Node& point_node : points)
+      {
+        trajectory_msgs::msg::JointTrajectoryPoint point;
+        point.time_from_start = rclcpp::Duration::from_seconds(point_node["time_from_start"].as<double>());
+        point.positions = point_node["positions"].as<std::vector<double>>();
+        point.velocities = point_node["velocities"].as<std::vector<double>>();
+        point.accelerations = point_node["accelerations"].as<std::vector<double>>();
+        trajectory.points.push_back(point);
+      }
+      cached_plans_.push_back(plan);
+    }
+  }
+  catch (YAML::Exception& e)
+  {
+    RCLCPP_ERROR_STREAM(node_->get_logger(), e.what());
+    cached_plans_.clear();
     return;
   }
+  RCLCPP_INFO_STREAM(node_->get_logger(), "Loaded " << cached_plans_.size() << " cached plans from "
+                                                    << file_name.toStdString());
+}
 
-  // Get current joint state as start state
-  moveit::core::RobotStatePtr start_state = move_group_->getCurrentState();
-  planning_scene_monitor_->waitForCurrentRobotState(rclcpp::Clock(RCL_ROS_TIME).now(), 0.1);
-  const planning_scene_monitor::LockedPlanningSceneRO& ps =
-      planning_scene_monitor::LockedPlanningSceneRO(planning_scene_monitor_);
-  if (ps)
-    start_state.reset(new moveit::core::RobotState(ps->getCurrentState()));
+void ControlTabWidget::selectNextJointState(PlanningRequest& request, const moveit::core::RobotState& start_state,
+                                            std::size_t first)
+{
+  // Nothing to choose from, or no sample to compare against
+  if (request.effector_wrt_world.size() + first - request.progress == 0 || first + 1 >= request.joint_states.size())
+    return;
 
-  // Plan motion to the recorded joint state target
-  if (auto_progress_->getValue() < joint_states_.size())
-  {
-    move_group_->setStartState(*start_state);
-    move_group_->setJointValueTarget(joint_states_[auto_progress_->getValue()]);
-    move_group_->setMaxVelocityScalingFactor(0.5);
-    move_group_->setMaxAccelerationScalingFactor(0.5);
-    current_plan_.reset(new moveit::planning_interface::MoveGroupInterface::Plan());
-    planning_res_ = (move_group_->plan(*current_plan_) == moveit::core::MoveItErrorCode::SUCCESS) ?
-                        ControlTabWidget::SUCCESS :
-                        ControlTabWidget::FAILURE_PLAN_FAILED;
+  moveit::core::RobotState state(start_state);
+  if (!state.knowsFrameTransform(request.base_frame) || !state.knowsFrameTransform(request.eef_frame))
+  {
+    RCLCPP_WARN_STREAM(node_->get_logger(),
+                       "Can't compute the end-effector pose of the recorded joint states, keeping the recorded order.");
+    return;
+  }
 
-    if (planning_res_ == ControlTabWidget::SUCCESS)
-      RCLCPP_DEBUG_STREAM(node_->get_logger(), "Planning succeed.");
-    else
-      RCLCPP_ERROR_STREAM(node_->get_logger(), "Planning failed.");
+  // Score the end-effector poses of the remaining joint states, and move the best one to the front
+  std::vector<Eigen::Isometry3d> remaining;
+  for (std::size_t i = request.progress; i < request.joint_states.size(); ++i)
+  {
+    state.setVariablePositions(request.joint_names, request.joint_states[i]);
+    state.update();
+    remaining.push_back(state.getFrameTransform(request.base_frame).inverse() *
+                        state.getFrameTransform(request.eef_frame));
   }
+
+  double gain = 0.;
+  const std::size_t best =
+      request.progress + mhc::selectNextRecordedPose(request.sensor_mount_type, request.motion_pair_mode,
+                                                     request.effector_wrt_world, remaining, first - request.progress,
+                                                     &gain);
+  std::swap(request.joint_states[first], request.joint_states[best]);
+  RCLCPP_INFO(node_->get_logger(), "Selected recorded joint state %zu of %zu, information gain: %g", best + 1,
+              request.joint_states.size(), gain);
+}
+
+void ControlTabWidget::autoPlanAllBtnClicked(bool clicked)
+{
+  auto_plan_btn_->setEnabled(false);
+  auto_plan_all_btn_->setEnabled(false);
+  auto_execute_btn_->setEnabled(false);
+  PlanningRequest request = getPlanningRequest(auto_progress_->getValue());
+  request.setup_result = checkPlanningSetup();
+  plan_watcher_->setFuture(QtConcurrent::run(this, &ControlTabWidget::computeAllPlans, request));
 }
 
 void ControlTabWidget::autoExecuteBtnClicked(bool clicked)
 {
+  // The plan being computed is only applied once planFinished has run
   if (plan_watcher_->isRunning())
-  {
-    plan_watcher_->waitForFinished();
-  }
+    return;
 
   auto_execute_btn_->setEnabled(false);
+  if (stream_samples_->isChecked())
+    startStreaming();
   execution_watcher_->setFuture(QtConcurrent::run(this, &ControlTabWidget::computeExecution));
 }
 
@@ -1120,7 +2010,26 @@ void ControlTabWidget::computeExecution()
 
 void ControlTabWidget::planFinished()
 {
-  auto_plan_btn_->setEnabled(true);
+  auto_plan_btn_->setEnabled(!auto_running_);
+  auto_plan_all_btn_->setEnabled(!auto_running_);
+  auto_execute_btn_->setEnabled(!auto_running_ && !execution_watcher_->isRunning());
+
+  const PlanningResult result = plan_watcher_->result();
+  planning_res_ = result.result;
+  if (planning_res_ == ControlTabWidget::SUCCESS && !applyPlanningResult(result))
+    planning_res_ = ControlTabWidget::FAILURE_JOINT_STATES_CHANGED;
+  // After planning all joint states, the first plan is executed next
+  current_plan_.reset();
+  if (planning_res_ == ControlTabWidget::SUCCESS && !result.plans.empty())
+    current_plan_ = result.plans.front();
+  if (planning_res_ == ControlTabWidget::SUCCESS && result.all_plans)
+  {
+    cached_plans_ = result.plans;
+    if (saveCachedPlans())
+      RCLCPP_INFO_STREAM(node_->get_logger(), "Saved " << cached_plans_.size() << " plans to "
+                                                       << getCachedPlansFileName().toStdString());
+  }
+
   switch (planning_res_)
   {
     case ControlTabWidget::FAILURE_NO_JOINT_STATE:
@@ -1145,25 +2054,65 @@ void ControlTabWidget::planFinished()
     case ControlTabWidget::FAILURE_PLAN_FAILED:
       QMessageBox::warning(this, tr("Error"), tr("Could not compute plan. Planning failed."));
       break;
+    case ControlTabWidget::FAILURE_JOINT_STATES_CHANGED:
+      QMessageBox::warning(this, tr("Error"),
+                           tr("Could not compute plan. Recorded joint states changed while planning."));
+      break;
     case ControlTabWidget::SUCCESS:
       break;
   }
   RCLCPP_DEBUG(node_->get_logger(), "Plan finished");
+
+  if (auto_running_)
+  {
+    if (planning_res_ == ControlTabWidget::SUCCESS)
+      startAutoExecution();
+    else
+      stopAutoCalibration("Automatic calibration stopped, planning failed.");
+  }
+}
+
+void ControlTabWidget::lookaheadFinished()
+{
+  const PlanningResult result = lookahead_watcher_->result();
+  lookahead_pending_ = false;
+  lookahead_res_ = result.result;
+  next_plan_.reset();
+  if (lookahead_res_ == ControlTabWidget::SUCCESS && !result.plans.empty() && applyPlanningResult(result))
+    next_plan_ = result.plans.front();
+  advanceAutoCalibration();
 }
 
 void ControlTabWidget::executeFinished()
 {
-  auto_execute_btn_->setEnabled(true);
+  auto_execute_btn_->setEnabled(!auto_running_ && !plan_watcher_->isRunning());
+  const bool streaming = stream_timer_->isActive();
+  if (streaming)
+  {
+    streamSample();
+    stopStreaming();
+  }
+
   if (planning_res_ == ControlTabWidget::SUCCESS)
   {
     auto_progress_->setValue(auto_progress_->getValue() + 1);
+    // The goal pose may already have been streamed, so similar samples are skipped without a warning
     if (!frameNamesEmpty())
-      takeTransformSamples();
+      takeTransformSamples(streaming);
 
-    if (effector_wrt_world_.size() == object_wrt_sensor_.size() && effector_wrt_world_.size() > 4)
+    if (samples_.effector_wrt_world.size() == samples_.object_wrt_sensor.size() &&
+        samples_.effector_wrt_world.size() > 4)
       solveCameraRobotPose();
   }
   RCLCPP_DEBUG(node_->get_logger(), "Execution finished");
+
+  if (auto_running_)
+  {
+    if (planning_res_ == ControlTabWidget::SUCCESS)
+      advanceAutoCalibration();
+    else
+      stopAutoCalibration("Automatic calibration stopped, execution failed.");
+  }
 }
 
 void ControlTabWidget::autoSkipBtnClicked(bool clicked)
@@ -1171,118 +2120,117 @@ void ControlTabWidget::autoSkipBtnClicked(bool clicked)
   auto_progress_->setValue(auto_progress_->getValue() + 1);
 }
 
-std::stringstream ControlTabWidget::generateCalibrationPython(std::string& from_frame, std::string& to_frame,
-                                                              Eigen::Vector3d& t, Eigen::Quaterniond& r_quat,
-                                                              Eigen::Vector3d& r_euler, std::string& mount_type)
-{
-  std::stringstream ss;
-  ss << "\"\"\" Static transform publisher acquired via MoveIt 2 hand-eye calibration \"\"\"" << std::endl;
-  ss << "\"\"\" " << mount_type << ": " << from_frame << " -> " << to_frame << " \"\"\"" << std::endl;
-  ss << "from launch import LaunchDescription" << std::endl;
-  ss << "from launch_ros.actions import Node" << std::endl;
-  ss << std::endl;
-  ss << std::endl;
-  ss << "def generate_launch_description() -> LaunchDescription:" << std::endl;
-  ss << "    nodes = [" << std::endl;
-  ss << "        Node(" << std::endl;
-  ss << "            package=\"tf2_ros\"," << std::endl;
-  ss << "            executable=\"static_transform_publisher\"," << std::endl;
-  ss << "            output=\"log\"," << std::endl;
-  ss << "            arguments=[" << std::endl;
-  ss << "                \"--frame-id\"," << std::endl;
-  ss << "                \"" << from_frame << "\"," << std::endl;
-  ss << "                \"--child-frame-id\"," << std::endl;
-  ss << "                \"" << to_frame << "\"," << std::endl;
-  ss << "                \"--x\"," << std::endl;
-  ss << "                \"" << t[0] << "\"," << std::endl;
-  ss << "                \"--y\"," << std::endl;
-  ss << "                \"" << t[1] << "\"," << std::endl;
-  ss << "                \"--z\"," << std::endl;
-  ss << "                \"" << t[2] << "\"," << std::endl;
-  ss << "                \"--qx\"," << std::endl;
-  ss << "                \"" << r_quat.x() << "\"," << std::endl;
-  ss << "                \"--qy\"," << std::endl;
-  ss << "                \"" << r_quat.y() << "\"," << std::endl;
-  ss << "                \"--qz\"," << std::endl;
-  ss << "                \"" << r_quat.z() << "\"," << std::endl;
-  ss << "                \"--qw\"," << std::endl;
-  ss << "                \"" << r_quat.w() << "\"," << std::endl;
-  ss << "                # \"--roll\"," << std::endl;
-  ss << "                # \"" << r_euler[0] << "\"," << std::endl;
-  ss << "                # \"--pitch\"," << std::endl;
-  ss << "                # \"" << r_euler[1] << "\"," << std::endl;
-  ss << "                # \"--yaw\"," << std::endl;
-  ss << "                # \"" << r_euler[2] << "\"," << std::endl;
-  ss << "            ]," << std::endl;
-  ss << "        )," << std::endl;
-  ss << "    ]" << std::endl;
-  ss << "    return LaunchDescription(nodes)" << std::endl;
-  return ss;
-}
-
-std::stringstream ControlTabWidget::generateCalibrationXml(std::string& from_frame, std::string& to_frame,
-                                                           Eigen::Vector3d& t, Eigen::Quaterniond& r_quat,
-                                                           Eigen::Vector3d& r_euler, std::string& mount_type)
-{
-  std::stringstream ss;
-  ss << "<!-- Static transform publisher acquired via MoveIt 2 hand-eye calibration -->" << std::endl;
-  ss << "<!-- " << mount_type << ": " << from_frame << " -> " << to_frame << " -->" << std::endl;
-  ss << std::endl;
-  ss << "<launch>" << std::endl;
-  ss << "    <node" << std::endl;
-  ss << "        pkg=\"tf2_ros\"" << std::endl;
-  ss << "        exec=\"static_transform_publisher\"" << std::endl;
-  ss << "        output=\"log\"" << std::endl;
-  ss << "        args=\"" << std::endl;
-  ss << "            --frame-id " << from_frame << std::endl;
-  ss << "            --child-frame-id " << to_frame << std::endl;
-  ss << "            --x " << t[0] << std::endl;
-  ss << "            --y " << t[1] << std::endl;
-  ss << "            --z " << t[2] << std::endl;
-  ss << "            --qx " << r_quat.x() << std::endl;
-  ss << "            --qy " << r_quat.y() << std::endl;
-  ss << "            --qz " << r_quat.z() << std::endl;
-  ss << "            --qw " << r_quat.w() << std::endl;
-  ss << "        \"" << std::endl;
-  ss << "    />" << std::endl;
-  ss << "    <!--" << std::endl;
-  ss << "            roll " << r_euler[0] << std::endl;
-  ss << "            pitch " << r_euler[1] << std::endl;
-  ss << "            yaw " << r_euler[2] << std::endl;
-  ss << "    -->" << std::endl;
-  ss << "</launch>" << std::endl;
-  return ss;
-}
-
-std::stringstream ControlTabWidget::generateCalibrationYaml(std::string& from_frame, std::string& to_frame,
-                                                            Eigen::Vector3d& t, Eigen::Quaterniond& r_quat,
-                                                            Eigen::Vector3d& r_euler, std::string& mount_type)
-{
-  std::stringstream ss;
-  ss << "# Static transform publisher acquired via MoveIt 2 hand-eye calibration" << std::endl;
-  ss << "# " << mount_type << ": " << from_frame << " -> " << to_frame << std::endl;
-  ss << std::endl;
-  ss << "launch:" << std::endl;
-  ss << "    - node:" << std::endl;
-  ss << "          pkg: tf2_ros" << std::endl;
-  ss << "          exec: static_transform_publisher" << std::endl;
-  ss << "          output: log" << std::endl;
-  ss << "          args:" << std::endl;
-  ss << "              \"" << std::endl;
-  ss << "              --frame-id " << from_frame << std::endl;
-  ss << "              --child-frame-id " << to_frame << std::endl;
-  ss << "              --x " << t[0] << std::endl;
-  ss << "              --y " << t[1] << std::endl;
-  ss << "              --z " << t[2] << std::endl;
-  ss << "              --qx " << r_quat.x() << std::endl;
-  ss << "              --qy " << r_quat.y() << std::endl;
-  ss << "              --qz " << r_quat.z() << std::endl;
-  ss << "              --qw " << r_quat.w() << std::endl;
-  ss << "              \"" << std::endl;
-  ss << "              # --roll " << r_euler[0] << std::endl;
-  ss << "              # --pitch " << r_euler[1] << std::endl;
-  ss << "              # --yaw " << r_euler[2] << std::endl;
-  return ss;
+void ControlTabWidget::autoRunBtnClicked(bool clicked)
+{
+  if (auto_running_)
+  {
+    // The motion being executed is finished, but no new one is started
+    stopAutoCalibration("Automatic calibration stopped.");
+    return;
+  }
+
+  if (!move_group_)
+  {
+    QMessageBox::warning(this, tr("Error"), tr("Could not run automatic calibration. Missing move_group."));
+    return;
+  }
+
+  // Without a second interface, each motion is planned after the previous one is executed
+  if (!lookahead_group_ || lookahead_group_->getName() != move_group_->getName())
+  {
+    try
+    {
+      moveit::planning_interface::MoveGroupInterface::Options opt(move_group_->getName());
+      lookahead_group_.reset(
+          new moveit::planning_interface::MoveGroupInterface(node_, opt, tf_buffer_, rclcpp::Duration(5, 0)));
+    }
+    catch (std::exception& ex)
+    {
+      RCLCPP_ERROR(node_->get_logger(), "%s", ex.what());
+      lookahead_group_.reset();
+    }
+  }
+
+  auto_running_ = true;
+  auto_start_progress_ = auto_progress_->getValue();
+  auto_timer_.start();
+  auto_run_btn_->setText("Stop");
+  auto_plan_btn_->setEnabled(false);
+  auto_plan_all_btn_->setEnabled(false);
+  auto_execute_btn_->setEnabled(false);
+  auto_skip_btn_->setEnabled(false);
+  updateAutoEta();
+  autoPlanBtnClicked(true);
+}
+
+void ControlTabWidget::startAutoExecution()
+{
+  autoExecuteBtnClicked(true);
+
+  // Plan the next joint state while the current one is executed
+  next_plan_.reset();
+  if (lookahead_group_ && current_plan_ && !current_plan_->trajectory.joint_trajectory.points.empty() &&
+      auto_progress_->getValue() + 1 < joint_states_.size())
+  {
+    PlanningRequest request = getPlanningRequest(auto_progress_->getValue() + 1);
+    request.group = lookahead_group_;
+    const trajectory_msgs::msg::JointTrajectory& trajectory = current_plan_->trajectory.joint_trajectory;
+    request.start_joint_names = trajectory.joint_names;
+    request.start_positions = trajectory.points.back().positions;
+    lookahead_pending_ = true;
+    lookahead_watcher_->setFuture(QtConcurrent::run(this, &ControlTabWidget::computeLookaheadPlan, request));
+  }
+}
+
+void ControlTabWidget::advanceAutoCalibration()
+{
+  // Continue once both the execution and the planning of the next motion are finished
+  if (!auto_running_ || plan_watcher_->isRunning() || execution_watcher_->isRunning() || lookahead_pending_)
+    return;
+
+  updateAutoEta();
+  if (auto_progress_->getValue() >= joint_states_.size())
+  {
+    stopAutoCalibration("Automatic calibration finished.");
+    return;
+  }
+
+  if (next_plan_ && lookahead_res_ == ControlTabWidget::SUCCESS)
+  {
+    current_plan_ = next_plan_;
+    next_plan_.reset();
+    startAutoExecution();
+  }
+  else
+  {
+    next_plan_.reset();
+    autoPlanBtnClicked(true);
+  }
+}
+
+void ControlTabWidget::stopAutoCalibration(const std::string& message)
+{
+  auto_running_ = false;
+  auto_run_btn_->setText("Run");
+  auto_plan_btn_->setEnabled(!plan_watcher_->isRunning());
+  auto_plan_all_btn_->setEnabled(!plan_watcher_->isRunning());
+  auto_execute_btn_->setEnabled(!execution_watcher_->isRunning() && !plan_watcher_->isRunning());
+  auto_skip_btn_->setEnabled(true);
+  auto_progress_->setStatus(QString("%1 s").arg(auto_timer_.elapsed() / 1000));
+  RCLCPP_INFO_STREAM(node_->get_logger(), message);
+}
+
+void ControlTabWidget::updateAutoEta()
+{
+  const int done = auto_progress_->getValue() - auto_start_progress_;
+  const int remaining = static_cast<int>(joint_states_.size()) - auto_progress_->getValue();
+  if (done <= 0)
+  {
+    auto_progress_->setStatus("ETA: -");
+    return;
+  }
+  const qint64 eta = auto_timer_.elapsed() * remaining / done / 1000;
+  auto_progress_->setStatus(QString("ETA: %1 s").arg(eta));
 }
 
 }  // namespace moveit_rviz_plugin
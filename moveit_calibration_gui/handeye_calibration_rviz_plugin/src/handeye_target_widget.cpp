@@ -90,6 +90,7 @@ TargetTabWidget::TargetTabWidget(rclcpp::Node::SharedPtr node, HandEyeCalibratio
   , target_plugins_loader_(nullptr)
   , target_(nullptr)
   , target_param_layout_(new QFormLayout())
+  , target_params_changed_(false)
 {
   // Target setting tab area -----------------------------------------------
   QHBoxLayout* layout = new QHBoxLayout();
@@ -144,6 +145,12 @@ TargetTabWidget::TargetTabWidget(rclcpp::Node::SharedPtr node, HandEyeCalibratio
   // Initialize image publisher
   image_pub_ = it_.advertise("/handeye_calibration/target_detection", 1);
 
+  // Detection statistics, for monitoring the camera without RViz
+  diagnostic_pub_ = node_->create_publisher<diagnostic_msgs::msg::DiagnosticArray>("/diagnostics", 1);
+  statistics_timer_ = new QTimer(this);
+  connect(statistics_timer_, &QTimer::timeout, this, &TargetTabWidget::publishDetectionStatistics);
+  setStatisticsPeriod(calibration_display_->statistics_period_property_->getFloat());
+
   // Register custom types
   qRegisterMetaType<sensor_msgs::msg::CameraInfo>();
   qRegisterMetaType<std::string>();
@@ -155,7 +162,11 @@ TargetTabWidget::TargetTabWidget(rclcpp::Node::SharedPtr node, HandEyeCalibratio
 
 void TargetTabWidget::loadWidget(const rviz_common::Config& config)
 {
-  if (target_type_->count() > 0)
+  // Parameter overrides of the node, e.g. from a launch file, take precedence over the saved configuration
+  const std::map<std::string, rclcpp::ParameterValue>& overrides =
+      node_->get_node_parameters_interface()->get_parameter_overrides();
+
+  if (target_type_->count() > 0 && !overrides.count("target_type"))
   {
     QString type;
     if (config.mapGetString("target_type", &type) && target_type_->findText(type, Qt::MatchCaseSensitive) != -1)
@@ -170,6 +181,8 @@ void TargetTabWidget::loadWidget(const rviz_common::Config& config)
   QString param_enum;
   for (const moveit_handeye_calibration::HandEyeTargetBase::Parameter& param : target_plugin_params_)
   {
+    if (overrides.count(moveit_handeye_calibration::getTargetParameterName(param.name_)))
+      continue;
     switch (param.parameter_type_)
     {
       case moveit_handeye_calibration::HandEyeTargetBase::Parameter::ParameterType::Int:
@@ -189,6 +202,7 @@ void TargetTabWidget::loadWidget(const rviz_common::Config& config)
         break;
     }
   }
+  targetParamInputChanged();
 
   for (const std::pair<const std::string, RosTopicComboBox*>& topic : ros_topics_)
   {
@@ -269,11 +283,66 @@ bool TargetTabWidget::loadAvailableTargetPlugins()
 
   for (const std::string& it : classes)
     target_type_->addItem(tr(it.c_str()));
-  loadInputWidgetsForTargetType(classes[0]);
+
+  // The target type can also be selected with the "target_type" node parameter, e.g. from a launch file
+  target_types_ = classes;
+  std::string target_type = classes[0];
+  if (!node_->has_parameter("target_type"))
+  {
+    rcl_interfaces::msg::ParameterDescriptor descriptor;
+    descriptor.description = "Handeye calibration target plugin";
+    target_type = node_->declare_parameter<std::string>("target_type", target_type, descriptor);
+  }
+  else
+    target_type = node_->get_parameter("target_type").as_string();
+  if (std::find(classes.begin(), classes.end(), target_type) == classes.end())
+  {
+    RCLCPP_WARN(node_->get_logger(), "Unknown target type '%s'", target_type.c_str());
+    target_type = classes[0];
+    node_->set_parameter(rclcpp::Parameter("target_type", target_type));
+  }
+  target_type_callback_ = node_->add_on_set_parameters_callback(
+      [this](const std::vector<rclcpp::Parameter>& parameters) { return targetTypeParameterCallback(parameters); });
+
+  target_type_->setCurrentText(tr(target_type.c_str()));
+  loadInputWidgetsForTargetType(target_type);
 
   return true;
 }
 
+rcl_interfaces::msg::SetParametersResult
+TargetTabWidget::targetTypeParameterCallback(const std::vector<rclcpp::Parameter>& parameters)
+{
+  rcl_interfaces::msg::SetParametersResult result;
+  result.successful = true;
+  for (const rclcpp::Parameter& parameter : parameters)
+  {
+    if (parameter.get_name() != "target_type")
+      continue;
+    if (parameter.get_type() != rclcpp::ParameterType::PARAMETER_STRING ||
+        std::find(target_types_.begin(), target_types_.end(), parameter.as_string()) == target_types_.end())
+    {
+      result.successful = false;
+      result.reason = "Unknown target type";
+      return result;
+    }
+
+    // Parameters cannot be declared in this callback, so the new target and its parameters are created afterwards
+    const QString target_type = QString::fromStdString(parameter.as_string());
+    QMetaObject::invokeMethod(
+        this,
+        [this, target_type]() {
+          if (target_type.toStdString() != target_plugin_name_)
+          {
+            target_type_->setCurrentText(target_type);
+            targetTypeComboboxChanged(target_type);
+          }
+        },
+        Qt::QueuedConnection);
+  }
+  return result;
+}
+
 bool TargetTabWidget::loadInputWidgetsForTargetType(const std::string& plugin_name)
 {
   if (plugin_name.empty())
@@ -281,8 +350,27 @@ bool TargetTabWidget::loadInputWidgetsForTargetType(const std::string& plugin_na
 
   try
   {
-    target_ = target_plugins_loader_->createUniqueInstance(plugin_name);
-    target_plugin_params_ = target_->getParameters();
+    // Release the node parameters of the previous target
+    target_params_callback_.reset();
+    for (const auto& param : target_plugin_params_)
+    {
+      const std::string name = moveit_handeye_calibration::getTargetParameterName(param.name_);
+      if (node_->has_parameter(name))
+        node_->undeclare_parameter(name);
+    }
+    target_plugin_params_.clear();
+
+    // Set the new target up completely before the image callbacks can see it
+    TargetPtr target = target_plugins_loader_->createUniqueInstance(plugin_name);
+    target_plugin_name_ = plugin_name;
+    // The target parameters are set through node parameters, which the inputs, launch files and other nodes can set
+    target_params_callback_ = moveit_handeye_calibration::bindTargetParameters(*node_, *target);
+    target_plugin_params_ = target->getParameters();
+    target->addParameterCallback([this](const moveit_handeye_calibration::HandEyeTargetBase::Parameter&) {
+      QMetaObject::invokeMethod(this, &TargetTabWidget::updateTargetParamInputs, Qt::QueuedConnection);
+    });
+    std::atomic_store(&target_, target);
+    target_params_changed_ = true;
     target_param_inputs_.clear();
     // clear out layout, except target type
     while (target_param_layout_->rowCount() > 1)
@@ -294,71 +382,109 @@ bool TargetTabWidget::loadInputWidgetsForTargetType(const std::string& plugin_na
       switch (param.parameter_type_)
       {
         case moveit_handeye_calibration::HandEyeTargetBase::Parameter::ParameterType::Int:
-          target_param_inputs_.insert(std::make_pair(param.name_, new QLineEdit()));
-          target_param_layout_->addRow(param.name_.c_str(), target_param_inputs_[param.name_]);
-          static_cast<QLineEdit*>(target_param_inputs_[param.name_])->setText(std::to_string(param.value_.i).c_str());
-          break;
         case moveit_handeye_calibration::HandEyeTargetBase::Parameter::ParameterType::Float:
-          target_param_inputs_.insert(std::make_pair(param.name_, new QLineEdit()));
-          target_param_layout_->addRow(param.name_.c_str(), target_param_inputs_[param.name_]);
-          static_cast<QLineEdit*>(target_param_inputs_[param.name_])->setText(std::to_string(param.value_.f).c_str());
+        {
+          QLineEdit* line_edit = new QLineEdit();
+          connect(line_edit, SIGNAL(editingFinished()), this, SLOT(targetParamInputChanged()));
+          target_param_inputs_.insert(std::make_pair(param.name_, line_edit));
+          target_param_layout_->addRow(param.name_.c_str(), line_edit);
           break;
+        }
         case moveit_handeye_calibration::HandEyeTargetBase::Parameter::ParameterType::Enum:
           QComboBox* combo_box = new QComboBox();
           for (const std::string& value : param.enum_values_)
           {
             combo_box->addItem(tr(value.c_str()));
           }
+          connect(combo_box, SIGNAL(activated(int)), this, SLOT(targetParamInputChanged()));
           target_param_inputs_.insert(std::make_pair(param.name_, combo_box));
-          target_param_layout_->addRow(param.name_.c_str(), target_param_inputs_[param.name_]);
-          static_cast<QComboBox*>(target_param_inputs_[param.name_])->setCurrentIndex(param.value_.e);
+          target_param_layout_->addRow(param.name_.c_str(), combo_box);
           break;
       }
     }
+    updateTargetParamInputs();
   }
   catch (pluginlib::PluginlibException& ex)
   {
     QMessageBox::warning(this, tr("Exception while loading a handeye target plugin"), tr(ex.what()));
-    target_ = nullptr;
+    std::atomic_store(&target_, TargetPtr());
     return false;
   }
   return true;
 }
 
-bool TargetTabWidget::createTargetInstance()
+void TargetTabWidget::targetParamInputChanged()
 {
-  if (!target_)
-    return false;
-
-  try
+  // The inputs are applied together through the node parameters, which check them and initialize the target again
+  std::vector<rclcpp::Parameter> parameters;
+  bool inputs_valid = true;
+  for (const auto& param : target_plugin_params_)
   {
-    // TODO: load parameters from GUI
-    for (const auto& param : target_plugin_params_)
+    const std::string name = moveit_handeye_calibration::getTargetParameterName(param.name_);
+    bool ok = true;
+    switch (param.parameter_type_)
     {
-      switch (param.parameter_type_)
-      {
-        case moveit_handeye_calibration::HandEyeTargetBase::Parameter::ParameterType::Int:
-          target_->setParameter(param.name_,
-                                static_cast<QLineEdit*>(target_param_inputs_[param.name_])->text().toInt());
-          break;
-        case moveit_handeye_calibration::HandEyeTargetBase::Parameter::ParameterType::Float:
-          target_->setParameter(param.name_,
-                                static_cast<QLineEdit*>(target_param_inputs_[param.name_])->text().toFloat());
-          break;
-        case moveit_handeye_calibration::HandEyeTargetBase::Parameter::ParameterType::Enum:
-          target_->setParameter(
-              param.name_, static_cast<QComboBox*>(target_param_inputs_[param.name_])->currentText().toStdString());
-          break;
-      }
+      case moveit_handeye_calibration::HandEyeTargetBase::Parameter::ParameterType::Int:
+        parameters.emplace_back(name, static_cast<QLineEdit*>(target_param_inputs_[param.name_])->text().toInt(&ok));
+        break;
+      case moveit_handeye_calibration::HandEyeTargetBase::Parameter::ParameterType::Float:
+        parameters.emplace_back(name,
+                                static_cast<QLineEdit*>(target_param_inputs_[param.name_])->text().toDouble(&ok));
+        break;
+      case moveit_handeye_calibration::HandEyeTargetBase::Parameter::ParameterType::Enum:
+        parameters.emplace_back(
+            name, static_cast<QComboBox*>(target_param_inputs_[param.name_])->currentText().toStdString());
+        break;
     }
-    target_->initialize();
+    inputs_valid = inputs_valid && ok;
   }
-  catch (pluginlib::PluginlibException& ex)
+
+  rcl_interfaces::msg::SetParametersResult result;
+  if (inputs_valid)
+    result = node_->set_parameters_atomically(parameters);
+  else
+    result.reason = "Target parameter inputs are not numbers";
+  if (!result.successful)
   {
-    QMessageBox::warning(this, tr("Exception while loading a handeye target plugin"), tr(ex.what()));
-    target_ = nullptr;
-    return false;
+    calibration_display_->setStatusStd(rviz_common::properties::StatusProperty::Warn, "Target detection",
+                                       result.reason);
+    updateTargetParamInputs();
+  }
+}
+
+void TargetTabWidget::updateTargetParamInputs()
+{
+  const TargetPtr target = getTarget();
+  if (!target)
+    return;
+
+  target_plugin_params_ = target->getParameters();
+  for (const auto& param : target_plugin_params_)
+  {
+    switch (param.parameter_type_)
+    {
+      case moveit_handeye_calibration::HandEyeTargetBase::Parameter::ParameterType::Int:
+        static_cast<QLineEdit*>(target_param_inputs_[param.name_])->setText(std::to_string(param.value_.i).c_str());
+        break;
+      case moveit_handeye_calibration::HandEyeTargetBase::Parameter::ParameterType::Float:
+        static_cast<QLineEdit*>(target_param_inputs_[param.name_])->setText(std::to_string(param.value_.f).c_str());
+        break;
+      case moveit_handeye_calibration::HandEyeTargetBase::Parameter::ParameterType::Enum:
+        static_cast<QComboBox*>(target_param_inputs_[param.name_])->setCurrentIndex(param.value_.e);
+        break;
+    }
   }
+}
+
+bool TargetTabWidget::createTargetInstance()
+{
+  const TargetPtr target = getTarget();
+  if (!target)
+    return false;
+
+  // Changes of the target parameters initialize the target again, see bindTargetParameters
+  if (target_params_changed_.exchange(false) && !target->initialize())
+    target_params_changed_ = true;
 
   return true;
 }
@@ -372,28 +498,47 @@ void TargetTabWidget::cameraCallback(const sensor_msgs::msg::Image::ConstSharedP
 
 void TargetTabWidget::imageCallback(const sensor_msgs::msg::Image::ConstSharedPtr& msg)
 {
+  moveit_handeye_calibration::ScopedTrace trace("imageCallback");
+  auto skip_frame = [this]() {
+    std::lock_guard<std::mutex> lock(detection_mutex_);
+    detection_statistics_.addSkippedFrame();
+  };
+  {
+    std::lock_guard<std::mutex> lock(detection_mutex_);
+    detection_statistics_.addReceivedFrame(rclcpp::Time(msg->header.stamp).seconds());
+  }
   createTargetInstance();
+  // A target type switched in the GUI thread only takes effect with the next image
+  const TargetPtr target = getTarget();
 
   // Depth image format `16UC1` cannot be converted to `MONO8`
   if (msg->encoding == "16UC1")
   {
+    skip_frame();
     calibration_display_->setStatus(rviz_common::properties::StatusProperty::Error, "Target detection",
                                     "Received 16-bit image, which cannot be processed.");
     return;
   }
 
-  std::string frame_id = msg->header.frame_id;
+  const std::string& frame_id = msg->header.frame_id;
   if (!frame_id.empty())
   {
-    if (optical_frame_.compare(frame_id))
+    bool frame_changed = false;
     {
-      optical_frame_ = frame_id;
-      Q_EMIT opticalFrameChanged(optical_frame_);
+      std::lock_guard<std::mutex> lock(detection_mutex_);
+      if (optical_frame_.compare(frame_id))
+      {
+        optical_frame_ = frame_id;
+        frame_changed = true;
+      }
     }
+    if (frame_changed)
+      Q_EMIT opticalFrameChanged(frame_id);
   }
   else
   {
     RCLCPP_ERROR_STREAM(node_->get_logger(), "Image msg has empty frame_id.");
+    skip_frame();
     calibration_display_->setStatus(rviz_common::properties::StatusProperty::Error, "Target detection",
                                     "Image message has empty frame ID.");
     return;
@@ -402,24 +547,40 @@ void TargetTabWidget::imageCallback(const sensor_msgs::msg::Image::ConstSharedPt
   if (msg->data.empty())
   {
     RCLCPP_ERROR_STREAM(node_->get_logger(), "Image msg has empty data.");
+    skip_frame();
     calibration_display_->setStatus(rviz_common::properties::StatusProperty::Error, "Target detection",
                                     "Image message is empty.");
     return;
   }
 
+  if (!target)
+  {
+    skip_frame();
+    return;
+  }
+
   cv_bridge::CvImagePtr cv_ptr;
   try
   {
     cv_ptr = cv_bridge::toCvCopy(msg, sensor_msgs::image_encodings::MONO8);
 
     sensor_msgs::msg::Image::SharedPtr pub_msg;
-    if (target_ && target_->detectTargetPose(cv_ptr->image))
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    const bool detected = target->detectTargetPose(cv_ptr->image);
+    const moveit_handeye_calibration::HandEyeTargetBase::DetectionInfo info = target->getDetectionInfo();
+    const double latency = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    {
+      std::lock_guard<std::mutex> lock(detection_mutex_);
+      detection_statistics_.addProcessedFrame(detected, latency, info.num_markers, info.reprojection_rms);
+    }
+    if (detected)
     {
       pub_msg = cv_bridge::CvImage(std_msgs::msg::Header(), "rgb8", cv_ptr->image).toImageMsg();
 
-      geometry_msgs::msg::TransformStamped tf2_msg = target_->getTransformStamped(optical_frame_);
+      geometry_msgs::msg::TransformStamped tf2_msg =
+          target->getTransformStamped(frame_id, rclcpp::Time(msg->header.stamp));
       tf_pub_->sendTransform(tf2_msg);
-      if (!target_->areIntrinsicsReasonable())
+      if (!target->areIntrinsicsReasonable())
       {
         calibration_display_->setStatus(
             rviz_common::properties::StatusProperty::Warn, "Target detection",
@@ -459,11 +620,12 @@ void TargetTabWidget::cameraInfoCallback(sensor_msgs::msg::CameraInfo::ConstShar
 {
   if (!camera_info_ || msg->k != camera_info_->k || msg->p != camera_info_->p)
   {
-    if (target_ && msg->height > 0 && msg->width > 0 && !msg->k.empty() && !msg->d.empty())
+    const TargetPtr target = getTarget();
+    if (target && msg->height > 0 && msg->width > 0 && !msg->k.empty() && !msg->d.empty())
     {
       RCLCPP_DEBUG(node_->get_logger(), "Received camera info.");
       camera_info_ = msg;
-      target_->setCameraIntrinsicParams(camera_info_);
+      target->setCameraIntrinsicParams(camera_info_);
       Q_EMIT cameraInfoChanged(*camera_info_);
     }
     else
@@ -481,19 +643,23 @@ void TargetTabWidget::targetTypeComboboxChanged(const QString& text)
   if (!text.isEmpty())
   {
     loadInputWidgetsForTargetType(text.toStdString());
-    if (target_)
+    const TargetPtr target = getTarget();
+    if (target)
     {
-      target_->setCameraIntrinsicParams(camera_info_);
+      target->setCameraIntrinsicParams(camera_info_);
     }
+    if (node_->get_parameter("target_type").as_string() != text.toStdString())
+      node_->set_parameter(rclcpp::Parameter("target_type", text.toStdString()));
   }
 }
 
 void TargetTabWidget::createTargetImageBtnClicked(bool clicked)
 {
   createTargetInstance();
-  if (target_)
+  const TargetPtr target = getTarget();
+  if (target)
   {
-    target_->createTargetImage(target_image_);
+    target->createTargetImage(target_image_);
   }
   else
     QMessageBox::warning(this, tr("Fail to create a target image."), "No available target plugin.");
@@ -543,6 +709,10 @@ void TargetTabWidget::saveTargetImageBtnClicked(bool clicked)
 void TargetTabWidget::imageTopicComboboxChanged(const QString& topic)
 {
   camera_sub_.shutdown();
+  {
+    std::lock_guard<std::mutex> lock(detection_mutex_);
+    detection_statistics_.reset();
+  }
 
   calibration_display_->setStatusStd(rviz_common::properties::StatusProperty::Warn, "Target detection",
                                      "Not subscribed to image topic.");
@@ -562,4 +732,31 @@ void TargetTabWidget::imageTopicComboboxChanged(const QString& topic)
   }
 }
 
+void TargetTabWidget::setStatisticsPeriod(double period)
+{
+  if (period > 0.)
+    statistics_timer_->start(static_cast<int>(period * 1000));
+  else
+    statistics_timer_->stop();
+}
+
+void TargetTabWidget::publishDetectionStatistics()
+{
+  moveit_handeye_calibration::DetectionSummary summary;
+  std::string optical_frame;
+  {
+    std::lock_guard<std::mutex> lock(detection_mutex_);
+    summary = detection_statistics_.getSummary();
+    optical_frame = optical_frame_;
+  }
+  if (optical_frame.empty())
+    return;
+
+  diagnostic_msgs::msg::DiagnosticArray array;
+  array.header.stamp = node_->now();
+  array.status.push_back(moveit_handeye_calibration::getDetectionDiagnostics(
+      summary, std::string(node_->get_name()) + ": Hand-eye target detection", optical_frame));
+  diagnostic_pub_->publish(array);
+}
+
 }  // namespace moveit_rviz_plugin
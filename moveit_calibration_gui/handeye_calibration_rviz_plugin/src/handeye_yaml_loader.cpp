@@ -0,0 +1,219 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt Calibration contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <moveit/handeye_calibration_rviz_plugin/handeye_yaml_loader.h>
+
+namespace moveit_rviz_plugin
+{
+void YamlStreamHandler::parse(std::istream& input)
+{
+  levels_.clear();
+  path_.clear();
+  YAML::Parser parser(input);
+  parser.HandleNextDocument(*this);
+}
+
+void YamlStreamHandler::OnDocumentStart(const YAML::Mark& /*mark*/)
+{
+}
+
+void YamlStreamHandler::OnDocumentEnd()
+{
+}
+
+void YamlStreamHandler::OnNull(const YAML::Mark& /*mark*/, YAML::anchor_t /*anchor*/)
+{
+  if (!levels_.empty() && levels_.back().is_map && levels_.back().expect_key)
+  {
+    path_.back().clear();
+    levels_.back().expect_key = false;
+    return;
+  }
+  endValue();
+}
+
+void YamlStreamHandler::OnAlias(const YAML::Mark& mark, YAML::anchor_t anchor)
+{
+  // The files written by the control tab have no aliases, so they are skipped like null values
+  OnNull(mark, anchor);
+}
+
+void YamlStreamHandler::OnScalar(const YAML::Mark& mark, const std::string& /*tag*/, YAML::anchor_t /*anchor*/,
+                                 const std::string& value)
+{
+  if (!levels_.empty() && levels_.back().is_map && levels_.back().expect_key)
+  {
+    path_.back() = value;
+    levels_.back().expect_key = false;
+    return;
+  }
+  onValue(mark, value);
+  endValue();
+}
+
+void YamlStreamHandler::OnSequenceStart(const YAML::Mark& /*mark*/, const std::string& /*tag*/,
+                                        YAML::anchor_t /*anchor*/, YAML::EmitterStyle::value /*style*/)
+{
+  levels_.push_back({ false, false });
+  path_.push_back("-");
+}
+
+void YamlStreamHandler::OnSequenceEnd()
+{
+  levels_.pop_back();
+  path_.pop_back();
+  onContainerEnd();
+  endValue();
+}
+
+void YamlStreamHandler::OnMapStart(const YAML::Mark& /*mark*/, const std::string& /*tag*/, YAML::anchor_t /*anchor*/,
+                                   YAML::EmitterStyle::value /*style*/)
+{
+  levels_.push_back({ true, true });
+  path_.emplace_back();
+}
+
+void YamlStreamHandler::OnMapEnd()
+{
+  levels_.pop_back();
+  path_.pop_back();
+  onContainerEnd();
+  endValue();
+}
+
+bool YamlStreamHandler::pathIs(std::initializer_list<const char*> path) const
+{
+  return path.size() == path_.size() && std::equal(path.begin(), path.end(), path_.begin());
+}
+
+double YamlStreamHandler::toDouble(const YAML::Mark& mark, const std::string& value)
+{
+  // Same conversion as YAML::Node::as<double>()
+  double result;
+  if (!YAML::convert<double>::decode(YAML::Node(value), result))
+    throw YAML::ParserException(mark, "'" + value + "' is not a number");
+  return result;
+}
+
+void YamlStreamHandler::endValue()
+{
+  // The next scalar in a map is a key again
+  if (!levels_.empty() && levels_.back().is_map)
+    levels_.back().expect_key = true;
+}
+
+SampleYamlLoader::SampleYamlLoader(const SampleCallback& callback) : callback_(callback)
+{
+}
+
+void SampleYamlLoader::parse(std::istream& input)
+{
+  effector_wrt_world_.clear();
+  object_wrt_sensor_.clear();
+  num_samples_ = 0;
+  YamlStreamHandler::parse(input);
+}
+
+void SampleYamlLoader::onValue(const YAML::Mark& mark, const std::string& value)
+{
+  if (pathIs({ "-", "effector_wrt_world", "-" }))
+    effector_wrt_world_.push_back(toDouble(mark, value));
+  else if (pathIs({ "-", "object_wrt_sensor", "-" }))
+    object_wrt_sensor_.push_back(toDouble(mark, value));
+}
+
+void SampleYamlLoader::onContainerEnd()
+{
+  if (!pathIs({ "-" }))
+    return;
+
+  // transformations are serialised as 4x4 row-major matrices
+  typedef Eigen::Matrix<double, 4, 4, Eigen::RowMajor> Matrix4d_rm;
+  ++num_samples_;
+  if (effector_wrt_world_.size() != 16 || object_wrt_sensor_.size() != 16)
+    throw YAML::Exception(YAML::Mark::null_mark(),
+                          "Sample " + std::to_string(num_samples_) + " doesn't have two 4x4 transformation matrices");
+
+  callback_(Eigen::Isometry3d(Eigen::Map<const Matrix4d_rm>(effector_wrt_world_.data())),
+            Eigen::Isometry3d(Eigen::Map<const Matrix4d_rm>(object_wrt_sensor_.data())));
+  effector_wrt_world_.clear();
+  object_wrt_sensor_.clear();
+}
+
+JointStateYamlLoader::JointStateYamlLoader(const JointNamesCallback& names_callback,
+                                           const JointStateCallback& state_callback)
+  : names_callback_(names_callback), state_callback_(state_callback)
+{
+}
+
+void JointStateYamlLoader::parse(std::istream& input)
+{
+  joint_names_.clear();
+  has_names_ = false;
+  has_values_ = false;
+  YamlStreamHandler::parse(input);
+  if (!has_names_)
+    throw YAML::Exception(YAML::Mark::null_mark(), "Can't find 'joint_names' in the opened file.");
+  if (!has_values_)
+    throw YAML::Exception(YAML::Mark::null_mark(), "Can't find 'joint_values' in the opened file.");
+}
+
+void JointStateYamlLoader::onValue(const YAML::Mark& mark, const std::string& value)
+{
+  if (pathIs({ "joint_names", "-" }))
+    joint_names_.push_back(value);
+  else if (pathIs({ "joint_values", "-", "-" }))
+    joint_state_.push_back(toDouble(mark, value));
+}
+
+void JointStateYamlLoader::onContainerEnd()
+{
+  if (pathIs({ "joint_names" }))
+  {
+    has_names_ = true;
+    names_callback_(joint_names_);
+  }
+  else if (pathIs({ "joint_values", "-" }))
+  {
+    if (has_names_ && joint_state_.size() == joint_names_.size())
+      state_callback_(joint_state_);
+    joint_state_.clear();
+  }
+  else if (pathIs({ "joint_values" }))
+  {
+    has_values_ = true;
+  }
+}
+
+}  // namespace moveit_rviz_plugin
@@ -0,0 +1,185 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt Calibration contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <gtest/gtest.h>
+#include <moveit/handeye_calibration_rviz_plugin/handeye_yaml_loader.h>
+
+#include <sstream>
+
+using namespace moveit_rviz_plugin;
+
+namespace
+{
+const char* IDENTITY = "[1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1]";
+const char* TRANSLATION = "[1, 0, 0, 0.5, 0, 1, 0, -0.25, 0, 0, 1, 1, 0, 0, 0, 1]";
+
+struct Samples
+{
+  std::vector<Eigen::Isometry3d> effector_wrt_world;
+  std::vector<Eigen::Isometry3d> object_wrt_sensor;
+};
+
+// Parse a sample file, and keep the samples passed on before an error
+void parseSamples(const std::string& yaml, Samples& samples)
+{
+  SampleYamlLoader loader([&samples](const Eigen::Isometry3d& effector_wrt_world,
+                                     const Eigen::Isometry3d& object_wrt_sensor) {
+    samples.effector_wrt_world.push_back(effector_wrt_world);
+    samples.object_wrt_sensor.push_back(object_wrt_sensor);
+  });
+  std::istringstream input(yaml);
+  loader.parse(input);
+}
+
+struct JointStates
+{
+  std::vector<std::string> joint_names;
+  std::vector<std::vector<double>> joint_states;
+};
+
+void parseJointStates(const std::string& yaml, JointStates& joint_states)
+{
+  JointStateYamlLoader loader(
+      [&joint_states](const std::vector<std::string>& names) { joint_states.joint_names = names; },
+      [&joint_states](const std::vector<double>& state) { joint_states.joint_states.push_back(state); });
+  std::istringstream input(yaml);
+  loader.parse(input);
+}
+}  // namespace
+
+TEST(HandEyeYamlLoader, Samples)
+{
+  Samples samples;
+  // Flow and block sequences
+  ASSERT_NO_THROW(parseSamples(std::string("- effector_wrt_world: ") + TRANSLATION + "\n  object_wrt_sensor: " +
+                                   IDENTITY +
+                                   "\n"
+                                   "- effector_wrt_world:\n"
+                                   "    - 1\n    - 0\n    - 0\n    - 0\n"
+                                   "    - 0\n    - 1\n    - 0\n    - 0\n"
+                                   "    - 0\n    - 0\n    - 1\n    - 0\n"
+                                   "    - 0\n    - 0\n    - 0\n    - 1\n"
+                                   "  object_wrt_sensor: " +
+                                   TRANSLATION + "\n",
+                               samples));
+  ASSERT_EQ(samples.effector_wrt_world.size(), 2u);
+  ASSERT_EQ(samples.object_wrt_sensor.size(), 2u);
+  EXPECT_TRUE(samples.effector_wrt_world[0].translation().isApprox(Eigen::Vector3d(0.5, -0.25, 1.)));
+  EXPECT_TRUE(samples.object_wrt_sensor[0].isApprox(Eigen::Isometry3d::Identity()));
+  EXPECT_TRUE(samples.effector_wrt_world[1].isApprox(Eigen::Isometry3d::Identity()));
+  EXPECT_TRUE(samples.object_wrt_sensor[1].translation().isApprox(Eigen::Vector3d(0.5, -0.25, 1.)));
+
+  // Empty file
+  samples = Samples();
+  EXPECT_NO_THROW(parseSamples("", samples));
+  EXPECT_TRUE(samples.effector_wrt_world.empty());
+}
+
+TEST(HandEyeYamlLoader, TruncatedSamples)
+{
+  // The samples before the error are passed on
+  Samples samples;
+  const std::string first_sample =
+      std::string("- effector_wrt_world: ") + IDENTITY + "\n  object_wrt_sensor: " + IDENTITY + "\n";
+  EXPECT_THROW(parseSamples(first_sample + "- effector_wrt_world: " + IDENTITY + "\n", samples), YAML::Exception);
+  EXPECT_EQ(samples.effector_wrt_world.size(), 1u);
+
+  samples = Samples();
+  EXPECT_THROW(parseSamples(first_sample + "- effector_wrt_world: [1, 0, 0, 0, 0, 1, 0, 0]\n  object_wrt_sensor: " +
+                                IDENTITY + "\n",
+                            samples),
+               YAML::Exception);
+  EXPECT_EQ(samples.effector_wrt_world.size(), 1u);
+
+  // Cut off within a matrix
+  samples = Samples();
+  EXPECT_THROW(parseSamples(first_sample + "- effector_wrt_world: [1, 0, 0, 0, 0", samples), YAML::Exception);
+  EXPECT_EQ(samples.effector_wrt_world.size(), 1u);
+}
+
+TEST(HandEyeYamlLoader, SampleTypeError)
+{
+  Samples samples;
+  EXPECT_THROW(parseSamples(std::string("- effector_wrt_world: [1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, one]\n"
+                                        "  object_wrt_sensor: ") +
+                                IDENTITY + "\n",
+                            samples),
+               YAML::Exception);
+  EXPECT_TRUE(samples.effector_wrt_world.empty());
+}
+
+TEST(HandEyeYamlLoader, JointStates)
+{
+  JointStates joint_states;
+  ASSERT_NO_THROW(parseJointStates("joint_names: [joint_1, joint_2]\n"
+                                   "joint_values:\n"
+                                   "  - [0.5, -1]\n"
+                                   "  - [0.25]\n"
+                                   "  - - 1.5\n"
+                                   "    - 2\n",
+                                   joint_states));
+  EXPECT_EQ(joint_states.joint_names, std::vector<std::string>({ "joint_1", "joint_2" }));
+
+  // Joint states with the wrong number of values are skipped
+  ASSERT_EQ(joint_states.joint_states.size(), 2u);
+  EXPECT_EQ(joint_states.joint_states[0], std::vector<double>({ 0.5, -1. }));
+  EXPECT_EQ(joint_states.joint_states[1], std::vector<double>({ 1.5, 2. }));
+}
+
+TEST(HandEyeYamlLoader, TruncatedJointStates)
+{
+  JointStates joint_states;
+  EXPECT_THROW(parseJointStates("joint_names: [joint_1, joint_2]\n", joint_states), YAML::Exception);
+  EXPECT_THROW(parseJointStates("joint_values:\n  - [0.5, -1]\n", joint_states), YAML::Exception);
+
+  joint_states = JointStates();
+  EXPECT_THROW(parseJointStates("joint_names: [joint_1, joint_2]\n"
+                                "joint_values:\n"
+                                "  - [0.5, -1]\n"
+                                "  - [0.25, ",
+                                joint_states),
+               YAML::Exception);
+  EXPECT_EQ(joint_states.joint_states.size(), 1u);
+}
+
+TEST(HandEyeYamlLoader, JointStateTypeError)
+{
+  JointStates joint_states;
+  EXPECT_THROW(parseJointStates("joint_names: [joint_1, joint_2]\n"
+                                "joint_values:\n"
+                                "  - [0.5, true]\n",
+                                joint_states),
+               YAML::Exception);
+  EXPECT_TRUE(joint_states.joint_states.empty());
+}
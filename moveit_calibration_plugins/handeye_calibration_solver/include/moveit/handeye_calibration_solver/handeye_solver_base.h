@@ -36,6 +36,9 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <tf2_eigen/tf2_eigen.hpp>
 #include <rclcpp/rclcpp.hpp>
 
@@ -51,12 +54,39 @@ enum SensorMountType
   EYE_TO_HAND = 0,
   EYE_IN_HAND = 1,
 };
+
+enum MotionPairMode
+{
+  CONSECUTIVE_PAIRS = 0,  // Motions between consecutive samples, i -> i+1
+  ALL_PAIRS = 1,          // Motions between every two samples
+  SELECTED_PAIRS = 2,     // Well-conditioned subset of all pairs, chosen by rotation axis diversity
+};
+
+typedef std::vector<std::pair<std::size_t, std::size_t>> MotionPairs;
+
+/**
+ * @brief RMS rotation and translation error of a calibration, NaN if it could not be computed.
+ */
+struct CalibrationError
+{
+  double rotation = std::numeric_limits<double>::quiet_NaN();     // radians
+  double translation = std::numeric_limits<double>::quiet_NaN();  // meters
+};
+
 class HandEyeSolverBase
 {
 public:
   HandEyeSolverBase() = default;
   virtual ~HandEyeSolverBase() = default;
 
+  // Default number of selected motion pairs per sample, if no explicit maximum is given
+  static constexpr std::size_t DEFAULT_SELECTED_PAIRS_PER_SAMPLE = 4;
+  // Motions with a smaller rotation angle have an ill-defined rotation axis and are never selected
+  static constexpr double MIN_SELECTED_PAIR_ROTATION = M_PI / 36.;
+  // Number of latitude and longitude bins used to group rotation axes on the hemisphere
+  static constexpr std::size_t AXIS_BINS_LATITUDE = 6;
+  static constexpr std::size_t AXIS_BINS_LONGITUDE = 12;
+
   virtual void initialize() = 0;
 
   /**
@@ -89,20 +119,164 @@ public:
   virtual const Eigen::Isometry3d& getCameraRobotPose() const = 0;
 
   /**
-   * @brief Get the reprojection error for the given samples.
+   * @brief Get the calibration object pose estimated along with the camera pose, by solvers that calibrate robot-world
+   * and hand-eye simultaneously. For EYE_IN_HAND, the object pose is with respect to the robot base, for EYE_TO_HAND
+   * with respect to the end-effector.
+   * @param[out] object_robot_pose A 4X4 transform indicating the pose.
+   * @return True if the last calibration estimated the object pose, false otherwise.
+   */
+  virtual bool getObjectRobotPose(Eigen::Isometry3d& object_robot_pose) const
+  {
+    return false;
+  }
+
+  /**
+   * @brief Set which motions between samples are used by the solver and the reprojection error.
+   * @param mode Consecutive, all or selected motion pairs.
+   * @param max_pairs Maximum number of pairs in SELECTED_PAIRS mode, 0 to use DEFAULT_SELECTED_PAIRS_PER_SAMPLE
+   * pairs per sample.
+   */
+  virtual void setMotionPairMode(MotionPairMode mode, std::size_t max_pairs = 0)
+  {
+    motion_pair_mode_ = mode;
+    max_motion_pairs_ = max_pairs;
+  }
+
+  MotionPairMode getMotionPairMode() const
+  {
+    return motion_pair_mode_;
+  }
+
+  std::size_t getMaxMotionPairs() const
+  {
+    return max_motion_pairs_;
+  }
+
+  /**
+   * @brief Get the relative robot motion between two samples, i.e. the A of AX = XB.
+   */
+  static Eigen::Isometry3d getRobotMotion(const std::vector<Eigen::Isometry3d>& effector_wrt_world, std::size_t i,
+                                          std::size_t j, SensorMountType setup)
+  {
+    if (setup == EYE_IN_HAND)
+      return effector_wrt_world[i].inverse() * effector_wrt_world[j];
+    return effector_wrt_world[i] * effector_wrt_world[j].inverse();
+  }
+
+  /**
+   * @brief Get the relative object motion between two samples, i.e. the B of AX = XB.
+   */
+  static Eigen::Isometry3d getObjectMotion(const std::vector<Eigen::Isometry3d>& object_wrt_sensor, std::size_t i,
+                                           std::size_t j)
+  {
+    return object_wrt_sensor[i] * object_wrt_sensor[j].inverse();
+  }
+
+  /**
+   * @brief Get the sample index pairs whose motions are used for calibration.
+   * In SELECTED_PAIRS mode, the robot motions of all pairs are grouped by rotation axis direction, and the pairs with
+   * the largest rotation are taken from each group in turn, so the selection covers as many axes as possible.
+   * @param effector_wrt_world End-effector pose (4X4 transform) with respect to the world (or robot base).
+   * @param setup Camera mount type, {EYE_TO_HAND, EYE_IN_HAND}.
+   * @param mode Consecutive, all or selected motion pairs.
+   * @param max_pairs Maximum number of pairs in SELECTED_PAIRS mode, 0 for the default.
+   * @return List of (i, j) sample index pairs, with i < j.
+   */
+  static MotionPairs getMotionPairs(const std::vector<Eigen::Isometry3d>& effector_wrt_world, SensorMountType setup,
+                                    MotionPairMode mode, std::size_t max_pairs = 0)
+  {
+    MotionPairs pairs;
+    const std::size_t num_samples = effector_wrt_world.size();
+    if (num_samples < 2)
+      return pairs;
+
+    if (mode == CONSECUTIVE_PAIRS)
+    {
+      for (std::size_t i = 0; i + 1 < num_samples; ++i)
+        pairs.emplace_back(i, i + 1);
+      return pairs;
+    }
+
+    if (mode == ALL_PAIRS)
+    {
+      pairs.reserve(num_samples * (num_samples - 1) / 2);
+      for (std::size_t i = 0; i < num_samples; ++i)
+        for (std::size_t j = i + 1; j < num_samples; ++j)
+          pairs.emplace_back(i, j);
+      return pairs;
+    }
+
+    if (max_pairs == 0)
+      max_pairs = DEFAULT_SELECTED_PAIRS_PER_SAMPLE * num_samples;
+
+    // Group the candidate pairs by the direction of their rotation axis. The axis sign is ambiguous, so the axes are
+    // mapped onto the upper hemisphere and binned by latitude and longitude.
+    struct Candidate
+    {
+      double angle;
+      std::size_t i;
+      std::size_t j;
+    };
+    std::vector<std::vector<Candidate>> bins(AXIS_BINS_LATITUDE * AXIS_BINS_LONGITUDE);
+    for (std::size_t i = 0; i < num_samples; ++i)
+    {
+      for (std::size_t j = i + 1; j < num_samples; ++j)
+      {
+        Eigen::AngleAxisd rot(getRobotMotion(effector_wrt_world, i, j, setup).rotation());
+        if (rot.angle() < MIN_SELECTED_PAIR_ROTATION)
+          continue;
+        Eigen::Vector3d axis = rot.axis();
+        if (axis.z() < 0)
+          axis = -axis;
+        const double latitude = std::acos(std::min(1., axis.z()));       // [0, pi/2]
+        const double longitude = std::atan2(axis.y(), axis.x()) + M_PI;  // [0, 2pi]
+        std::size_t lat_bin =
+            std::min<std::size_t>(latitude / (M_PI / 2.) * AXIS_BINS_LATITUDE, AXIS_BINS_LATITUDE - 1);
+        std::size_t lon_bin =
+            std::min<std::size_t>(longitude / (2. * M_PI) * AXIS_BINS_LONGITUDE, AXIS_BINS_LONGITUDE - 1);
+        bins[lat_bin * AXIS_BINS_LONGITUDE + lon_bin].push_back({ rot.angle(), i, j });
+      }
+    }
+
+    // Largest rotations first within each bin
+    for (auto& bin : bins)
+      std::sort(bin.begin(), bin.end(), [](const Candidate& a, const Candidate& b) { return a.angle > b.angle; });
+
+    // Take the best remaining pair of every bin in turn, until enough pairs are selected
+    std::vector<std::size_t> next(bins.size(), 0);
+    bool added = true;
+    while (pairs.size() < max_pairs && added)
+    {
+      added = false;
+      for (std::size_t b = 0; b < bins.size() && pairs.size() < max_pairs; ++b)
+      {
+        if (next[b] < bins[b].size())
+        {
+          const Candidate& c = bins[b][next[b]++];
+          pairs.emplace_back(c.i, c.j);
+          added = true;
+        }
+      }
+    }
+    std::sort(pairs.begin(), pairs.end());
+    return pairs;
+  }
+
+  /**
+   * @brief Get the reprojection error for the given samples, using the motion pairs of the current motion pair mode.
    * @param effector_wrt_world End-effector pose (4X4 transform) with respect to
    * the world (or robot base).
    * @param object_wrt_sensor Object (calibration board) pose (4X4 transform)
    * with respect to the camera.
    * @param X The calibration, as a 4X4 transform.
    * @param setup Camera mount type, {EYE_TO_HAND, EYE_IN_HAND}.
-   * @return Pair of translation and rotation reprojection error in meters and radians, or NaNs on error.
+   * @return Rotation and translation reprojection error in radians and meters, or NaNs on error.
    */
-  std::pair<double, double> getReprojectionError(const std::vector<Eigen::Isometry3d>& effector_wrt_world,
-                                                 const std::vector<Eigen::Isometry3d>& object_wrt_sensor,
-                                                 const Eigen::Isometry3d& X, SensorMountType setup = EYE_TO_HAND)
+  CalibrationError getCalibrationError(const std::vector<Eigen::Isometry3d>& effector_wrt_world,
+                                       const std::vector<Eigen::Isometry3d>& object_wrt_sensor,
+                                       const Eigen::Isometry3d& X, SensorMountType setup = EYE_TO_HAND)
   {
-    auto ret = std::make_pair(std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::quiet_NaN());
+    CalibrationError ret;
     if (effector_wrt_world.size() != object_wrt_sensor.size())
     {
       RCLCPP_ERROR(LOGGER_CALIBRATION_SOLVER,
@@ -115,19 +289,41 @@ public:
       return ret;
     }
 
+    return getCalibrationError(effector_wrt_world, object_wrt_sensor, X,
+                               getMotionPairs(effector_wrt_world, setup, motion_pair_mode_, max_motion_pairs_), setup);
+  }
+
+  /**
+   * @brief Get the reprojection error for the given samples, over an explicit list of motion pairs.
+   * @param effector_wrt_world End-effector pose (4X4 transform) with respect to
+   * the world (or robot base).
+   * @param object_wrt_sensor Object (calibration board) pose (4X4 transform)
+   * with respect to the camera.
+   * @param X The calibration, as a 4X4 transform.
+   * @param pairs Sample index pairs (i, j) whose motions are evaluated.
+   * @param setup Camera mount type, {EYE_TO_HAND, EYE_IN_HAND}.
+   * @return Rotation and translation reprojection error in radians and meters, or NaNs on error.
+   */
+  static CalibrationError getCalibrationError(const std::vector<Eigen::Isometry3d>& effector_wrt_world,
+                                              const std::vector<Eigen::Isometry3d>& object_wrt_sensor,
+                                              const Eigen::Isometry3d& X, const MotionPairs& pairs,
+                                              SensorMountType setup = EYE_TO_HAND)
+  {
+    CalibrationError ret;
+    if (effector_wrt_world.size() != object_wrt_sensor.size() || pairs.empty())
+    {
+      return ret;
+    }
+
     double rotation_err = 0;
     double translation_err = 0;
 
-    const size_t num_motions = effector_wrt_world.size() - 1;
-    for (size_t i = 0; i < num_motions; ++i)
+    const size_t num_motions = pairs.size();
+    for (const auto& pair : pairs)
     {
       // Calculate both sides of AX = XB
-      Eigen::Isometry3d A;
-      if (setup == EYE_IN_HAND)
-        A = effector_wrt_world[i].inverse() * effector_wrt_world[i + 1];
-      else
-        A = effector_wrt_world[i] * effector_wrt_world[i + 1].inverse();
-      Eigen::Isometry3d B = object_wrt_sensor[i] * object_wrt_sensor[i + 1].inverse();
+      Eigen::Isometry3d A = getRobotMotion(effector_wrt_world, pair.first, pair.second, setup);
+      Eigen::Isometry3d B = getObjectMotion(object_wrt_sensor, pair.first, pair.second);
 
       Eigen::Isometry3d AX = A * X;
       Eigen::Isometry3d XB = X * B;
@@ -142,9 +338,41 @@ public:
                      2.;
       translation_err += t_err * t_err;
     }
-    ret = std::make_pair(std::sqrt(rotation_err / num_motions), std::sqrt(translation_err / num_motions));
+    ret.rotation = std::sqrt(rotation_err / num_motions);
+    ret.translation = std::sqrt(translation_err / num_motions);
     return ret;
   }
+
+  /**
+   * @brief Get the reprojection error for the given samples, using the motion pairs of the current motion pair mode.
+   * @return Pair of the rotation and translation reprojection error in radians and meters, or NaNs on error.
+   * @see getCalibrationError
+   */
+  std::pair<double, double> getReprojectionError(const std::vector<Eigen::Isometry3d>& effector_wrt_world,
+                                                 const std::vector<Eigen::Isometry3d>& object_wrt_sensor,
+                                                 const Eigen::Isometry3d& X, SensorMountType setup = EYE_TO_HAND)
+  {
+    const CalibrationError error = getCalibrationError(effector_wrt_world, object_wrt_sensor, X, setup);
+    return std::make_pair(error.rotation, error.translation);
+  }
+
+  /**
+   * @brief Get the reprojection error for the given samples, over an explicit list of motion pairs.
+   * @return Pair of the rotation and translation reprojection error in radians and meters, or NaNs on error.
+   * @see getCalibrationError
+   */
+  static std::pair<double, double> getReprojectionError(const std::vector<Eigen::Isometry3d>& effector_wrt_world,
+                                                        const std::vector<Eigen::Isometry3d>& object_wrt_sensor,
+                                                        const Eigen::Isometry3d& X, const MotionPairs& pairs,
+                                                        SensorMountType setup = EYE_TO_HAND)
+  {
+    const CalibrationError error = getCalibrationError(effector_wrt_world, object_wrt_sensor, X, pairs, setup);
+    return std::make_pair(error.rotation, error.translation);
+  }
+
+protected:
+  MotionPairMode motion_pair_mode_ = CONSECUTIVE_PAIRS;
+  std::size_t max_motion_pairs_ = 0;
 };
 
 }  // namespace moveit_handeye_calibration
@@ -0,0 +1,100 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt Calibration contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#pragma once
+
+#include <moveit/handeye_calibration_solver/handeye_solver_base.h>
+
+namespace moveit_handeye_calibration
+{
+/**
+ * @brief Pose of the calibration object observed by one camera in one sample.
+ */
+struct CameraObservation
+{
+  std::size_t camera;                   // Index of the observing camera
+  std::size_t sample;                   // Index of the robot pose sample the observation was taken at
+  Eigen::Isometry3d object_wrt_sensor;  // Object (calibration board) pose with respect to the camera
+};
+
+/**
+ * @brief Joint calibration of several cameras observing the same calibration object.
+ *
+ * Every observation of camera c in sample i constrains M_i X_c C_ci = Z, where M_i is the end-effector pose
+ * (EYE_IN_HAND) or its inverse (EYE_TO_HAND), X_c the camera pose and Z the object pose shared by all cameras. Each
+ * residual only depends on one camera pose and the object pose, so the normal equations have an arrow structure. The
+ * camera blocks are eliminated by a Schur complement, which makes each iteration linear in the number of cameras.
+ */
+class HandEyeMultiCameraSolver
+{
+public:
+  HandEyeMultiCameraSolver() = default;
+  ~HandEyeMultiCameraSolver() = default;
+
+  /**
+   * @brief Calculate the poses of all cameras from synchronized samples.
+   * @param effector_wrt_world End-effector pose (4X4 transform) with respect to the world (or robot base), one per
+   * sample.
+   * @param observations Object poses observed by the cameras, any subset of cameras per sample.
+   * @param num_cameras Number of cameras, every camera must have at least one observation.
+   * @param setup Camera mount type, {EYE_TO_HAND, EYE_IN_HAND}, shared by all cameras.
+   * @param[out] error_message Description of error, if solver fails
+   * @return If the calculation succeeds, return true. Otherwise, return false.
+   */
+  bool solve(const std::vector<Eigen::Isometry3d>& effector_wrt_world,
+             const std::vector<CameraObservation>& observations, std::size_t num_cameras,
+             SensorMountType setup = EYE_TO_HAND, std::string* error_message = nullptr);
+
+  /**
+   * @brief Get the camera poses with respect to the robot, indexed by camera.
+   */
+  const std::vector<Eigen::Isometry3d>& getCameraRobotPoses() const;
+
+  /**
+   * @brief Get the object pose with respect to the robot base (EYE_IN_HAND) or end-effector (EYE_TO_HAND).
+   */
+  const Eigen::Isometry3d& getObjectRobotPose() const;
+
+  /**
+   * @brief Get the RMS rotation and translation error of all observations, in radians and meters.
+   */
+  const CalibrationError& getResidualError() const;
+
+private:
+  std::vector<Eigen::Isometry3d> camera_robot_poses_;
+  Eigen::Isometry3d object_robot_pose_ = Eigen::Isometry3d::Identity();
+  CalibrationError residual_error_;
+};
+
+}  // namespace moveit_handeye_calibration
@@ -0,0 +1,122 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt Calibration contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#pragma once
+
+#include <functional>
+#include <moveit/handeye_calibration_solver/handeye_solver_base.h>
+
+namespace moveit_handeye_calibration
+{
+typedef Eigen::Matrix<double, 6, 1> Vector6d;
+
+/**
+ * @brief Fills the residual vector for a given set of poses. The number of residuals must not depend on the poses.
+ */
+typedef std::function<void(const std::vector<Eigen::Isometry3d>& poses, Eigen::VectorXd& residuals)>
+    PoseResidualFunction;
+
+/**
+ * @brief Get the rotation vector (axis times angle) of a rotation matrix.
+ */
+Eigen::Vector3d getRotationVector(const Eigen::Matrix3d& rotation);
+
+/**
+ * @brief Apply a 6D increment to a pose.
+ * @param pose The pose to be updated.
+ * @param delta Rotation vector (applied on the right of the pose rotation) followed by the translation increment.
+ * @return The updated pose.
+ */
+Eigen::Isometry3d applyPoseIncrement(const Eigen::Isometry3d& pose, const Vector6d& delta);
+
+/**
+ * @brief Refine a set of poses by Levenberg-Marquardt minimization of the squared residuals.
+ * @param[in,out] poses Initial guess, replaced with the refined poses.
+ * @param residual_function Residuals of the cost function.
+ * @param max_iterations Maximum number of iterations.
+ * @return True if the residuals could be evaluated and the poses were refined, false otherwise.
+ */
+bool refinePoses(std::vector<Eigen::Isometry3d>& poses, const PoseResidualFunction& residual_function,
+                 std::size_t max_iterations = 50);
+
+/**
+ * @brief Compute the AX = XB residuals of a set of motion pairs: the rotation vector and the translation difference
+ * between AX and XB, 6 values per pair.
+ */
+void computeAXXBResiduals(const std::vector<Eigen::Isometry3d>& effector_wrt_world,
+                          const std::vector<Eigen::Isometry3d>& object_wrt_sensor, const Eigen::Isometry3d& X,
+                          const MotionPairs& pairs, SensorMountType setup, Eigen::VectorXd& residuals);
+
+/**
+ * @brief Refine an AX = XB calibration over a set of motion pairs.
+ * @param effector_wrt_world End-effector pose (4X4 transform) with respect to the world (or robot base).
+ * @param object_wrt_sensor Object (calibration board) pose (4X4 transform) with respect to the camera.
+ * @param pairs Sample index pairs (i, j) whose motions are used.
+ * @param setup Camera mount type, {EYE_TO_HAND, EYE_IN_HAND}.
+ * @param[in,out] X Initial calibration, replaced with the refined calibration.
+ * @return True if the refinement succeeded, false otherwise.
+ */
+bool refineAXXB(const std::vector<Eigen::Isometry3d>& effector_wrt_world,
+                const std::vector<Eigen::Isometry3d>& object_wrt_sensor, const MotionPairs& pairs,
+                SensorMountType setup, Eigen::Isometry3d& X);
+
+/**
+ * @brief Get the robot pose M of the robot-world / hand-eye equation M X C = Z for one sample, i.e. the end-effector
+ * pose for EYE_IN_HAND and its inverse for EYE_TO_HAND.
+ */
+Eigen::Isometry3d getRobotWorldRobotPose(const Eigen::Isometry3d& effector_wrt_world, SensorMountType setup);
+
+/**
+ * @brief Compute the M X C = Z residuals of all samples: the rotation vector and the translation difference between
+ * M X C and Z, 6 values per sample.
+ */
+void computeAXZBResiduals(const std::vector<Eigen::Isometry3d>& effector_wrt_world,
+                          const std::vector<Eigen::Isometry3d>& object_wrt_sensor, const Eigen::Isometry3d& X,
+                          const Eigen::Isometry3d& Z, SensorMountType setup, Eigen::VectorXd& residuals);
+
+/**
+ * @brief Jointly refine a hand-eye calibration X and the calibration object pose Z over all samples.
+ * @param effector_wrt_world End-effector pose (4X4 transform) with respect to the world (or robot base).
+ * @param object_wrt_sensor Object (calibration board) pose (4X4 transform) with respect to the camera.
+ * @param setup Camera mount type, {EYE_TO_HAND, EYE_IN_HAND}.
+ * @param[in,out] X Initial calibration, replaced with the refined calibration.
+ * @param[in,out] Z Initial object pose with respect to the robot base (EYE_IN_HAND) or end-effector (EYE_TO_HAND),
+ * replaced with the refined pose.
+ * @return True if the refinement succeeded, false otherwise.
+ */
+bool refineAXZB(const std::vector<Eigen::Isometry3d>& effector_wrt_world,
+                const std::vector<Eigen::Isometry3d>& object_wrt_sensor, SensorMountType setup, Eigen::Isometry3d& X,
+                Eigen::Isometry3d& Z);
+
+}  // namespace moveit_handeye_calibration
@@ -0,0 +1,88 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt Calibration contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <moveit/handeye_calibration_solver/handeye_solver_base.h>
+
+namespace moveit_handeye_calibration
+{
+enum UncertaintyMethod
+{
+  BOOTSTRAP = 0,  // Resample the sample set with replacement
+  JACKKNIFE = 1,  // Leave out one sample at a time
+};
+
+// Resamples with fewer distinct samples have at most one independent motion, which does not determine a calibration
+constexpr std::size_t MIN_RESAMPLE_DISTINCT_SAMPLES = 3;
+
+struct CalibrationUncertainty
+{
+  // Standard deviation of the camera position, per axis of the frame the camera pose is expressed in, in meters
+  Eigen::Vector3d translation_stddev = Eigen::Vector3d::Zero();
+  // Standard deviation of the camera orientation, as rotation vector components in the camera frame, in radians
+  Eigen::Vector3d rotation_stddev = Eigen::Vector3d::Zero();
+  // Number of resampled sample sets that were solved successfully
+  std::size_t num_resamples = 0;
+};
+
+/**
+ * @brief Estimate the uncertainty of a calibration by resampling the sample set and solving it again.
+ * The resampled sets are solved in parallel, one thread per solver instance. Each solver must be initialized and
+ * configured (e.g. motion pair mode) like the one that produced the calibration. Resample k is drawn from a generator
+ * seeded with seed + k, so the result does not depend on the number of threads. Each bootstrap resample keeps every
+ * drawn sample once. Resamples with fewer than MIN_RESAMPLE_DISTINCT_SAMPLES distinct samples are skipped.
+ * @param solvers Solver instances, one per worker thread.
+ * @param effector_wrt_world End-effector pose (4X4 transform) with respect to the world (or robot base).
+ * @param object_wrt_sensor Object (calibration board) pose (4X4 transform) with respect to the camera.
+ * @param X The calibration found from all samples.
+ * @param setup Camera mount type, {EYE_TO_HAND, EYE_IN_HAND}.
+ * @param solver_name The algorithm used in the calculation.
+ * @param method Bootstrap or jackknife resampling.
+ * @param num_resamples Number of bootstrap resamples; the jackknife always uses one resample per sample.
+ * @param[out] uncertainty Per-axis standard deviations of the calibration.
+ * @param seed Seed of the bootstrap resampling.
+ * @param cancel If given and set while the estimate is running, the remaining resamples are skipped.
+ * @return True if at least two resamples were solved and the estimate was not canceled, false otherwise.
+ */
+bool estimateCalibrationUncertainty(const std::vector<HandEyeSolverBase*>& solvers,
+                                    const std::vector<Eigen::Isometry3d>& effector_wrt_world,
+                                    const std::vector<Eigen::Isometry3d>& object_wrt_sensor,
+                                    const Eigen::Isometry3d& X, SensorMountType setup, const std::string& solver_name,
+                                    UncertaintyMethod method, std::size_t num_resamples,
+                                    CalibrationUncertainty& uncertainty, unsigned int seed = 0,
+                                    const std::atomic<bool>* cancel = nullptr);
+
+}  // namespace moveit_handeye_calibration
@@ -0,0 +1,288 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt Calibration contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <moveit/handeye_calibration_solver/handeye_solver_multi_camera.h>
+#include <moveit/handeye_calibration_solver/handeye_solver_refinement.h>
+#include <moveit/handeye_calibration_solver/handeye_solver_robot_world.h>
+
+namespace moveit_handeye_calibration
+{
+namespace
+{
+constexpr std::size_t MIN_REFERENCE_OBSERVATIONS = 3;  // Observations needed to initialize the reference camera
+constexpr std::size_t MAX_ITERATIONS = 50;             // Maximum number of Levenberg-Marquardt iterations
+constexpr double JACOBIAN_STEP = 1e-6;                 // Central difference step of the numerical Jacobian
+constexpr double INITIAL_DAMPING = 1e-3;               // Initial Levenberg-Marquardt damping factor
+constexpr double MAX_DAMPING = 1e10;                   // Stop once steps are too small to reduce the cost
+constexpr double MIN_STEP_NORM = 1e-12;                // Stop once the increment is negligible
+
+typedef Eigen::Matrix<double, 6, 6> Matrix6d;
+
+// Residual of M X C = Z for a single observation
+Vector6d computeObservationResidual(const Eigen::Isometry3d& M, const Eigen::Isometry3d& X, const Eigen::Isometry3d& C,
+                                   const Eigen::Isometry3d& Z)
+{
+  const Eigen::Isometry3d MXC = M * X * C;
+  Vector6d residual;
+  residual.head<3>() = getRotationVector(MXC.linear().transpose() * Z.linear());
+  residual.tail<3>() = MXC.translation() - Z.translation();
+  return residual;
+}
+
+double computeCost(const std::vector<Eigen::Isometry3d>& robot_poses,
+                   const std::vector<CameraObservation>& observations, const std::vector<Eigen::Isometry3d>& X,
+                   const Eigen::Isometry3d& Z)
+{
+  double cost = 0.;
+  for (const CameraObservation& observation : observations)
+    cost += computeObservationResidual(robot_poses[observation.sample], X[observation.camera],
+                                       observation.object_wrt_sensor, Z)
+                .squaredNorm();
+  return cost;
+}
+
+// Normal equations of one camera block and its coupling with the object pose block
+struct CameraBlock
+{
+  Matrix6d H_xx = Matrix6d::Zero();
+  Matrix6d H_xz = Matrix6d::Zero();
+  Vector6d g_x = Vector6d::Zero();
+};
+}  // namespace
+
+bool HandEyeMultiCameraSolver::solve(const std::vector<Eigen::Isometry3d>& effector_wrt_world,
+                                     const std::vector<CameraObservation>& observations, std::size_t num_cameras,
+                                     SensorMountType setup, std::string* error_message)
+{
+  std::string local_error_message;
+  if (!error_message)
+  {
+    error_message = &local_error_message;
+  }
+
+  if (setup != EYE_IN_HAND && setup != EYE_TO_HAND)
+  {
+    *error_message = "Invalid sensor mount configuration (must be eye-to-hand or eye-in-hand)";
+    RCLCPP_ERROR_STREAM(LOGGER_CALIBRATION_SOLVER, *error_message);
+    return false;
+  }
+
+  std::vector<std::size_t> num_observations(num_cameras, 0);
+  for (const CameraObservation& observation : observations)
+  {
+    if (observation.camera >= num_cameras || observation.sample >= effector_wrt_world.size())
+    {
+      *error_message = "Observation of camera " + std::to_string(observation.camera) + " in sample " +
+                       std::to_string(observation.sample) + " is out of range";
+      RCLCPP_ERROR_STREAM(LOGGER_CALIBRATION_SOLVER, *error_message);
+      return false;
+    }
+    ++num_observations[observation.camera];
+  }
+
+  if (num_cameras == 0 || std::find(num_observations.begin(), num_observations.end(), 0) != num_observations.end())
+  {
+    *error_message = "Every camera needs at least one observation";
+    RCLCPP_ERROR_STREAM(LOGGER_CALIBRATION_SOLVER, *error_message);
+    return false;
+  }
+
+  // Initialize the shared object pose from the camera with the most observations
+  const std::size_t reference =
+      std::max_element(num_observations.begin(), num_observations.end()) - num_observations.begin();
+  if (num_observations[reference] < MIN_REFERENCE_OBSERVATIONS)
+  {
+    *error_message = "At least one camera needs " + std::to_string(MIN_REFERENCE_OBSERVATIONS) + " observations";
+    RCLCPP_ERROR_STREAM(LOGGER_CALIBRATION_SOLVER, *error_message);
+    return false;
+  }
+
+  std::vector<Eigen::Isometry3d> reference_effector_wrt_world, reference_object_wrt_sensor;
+  for (const CameraObservation& observation : observations)
+  {
+    if (observation.camera == reference)
+    {
+      reference_effector_wrt_world.push_back(effector_wrt_world[observation.sample]);
+      reference_object_wrt_sensor.push_back(observation.object_wrt_sensor);
+    }
+  }
+  HandEyeSolverRobotWorld reference_solver;
+  reference_solver.initialize();
+  if (!reference_solver.solve(reference_effector_wrt_world, reference_object_wrt_sensor, setup,
+                              reference_solver.getSolverNames().front(), error_message))
+    return false;
+
+  Eigen::Isometry3d Z;
+  reference_solver.getObjectRobotPose(Z);
+  std::vector<Eigen::Isometry3d> robot_poses;
+  robot_poses.reserve(effector_wrt_world.size());
+  for (const Eigen::Isometry3d& pose : effector_wrt_world)
+    robot_poses.push_back(getRobotWorldRobotPose(pose, setup));
+
+  // Initialize the other cameras from their first observation of the object
+  std::vector<Eigen::Isometry3d> X(num_cameras);
+  std::vector<bool> initialized(num_cameras, false);
+  X[reference] = reference_solver.getCameraRobotPose();
+  initialized[reference] = true;
+  for (const CameraObservation& observation : observations)
+  {
+    if (!initialized[observation.camera])
+    {
+      X[observation.camera] =
+          robot_poses[observation.sample].inverse() * Z * observation.object_wrt_sensor.inverse();
+      initialized[observation.camera] = true;
+    }
+  }
+
+  // Levenberg-Marquardt over all camera poses and the object pose, the camera blocks are eliminated per iteration
+  double cost = computeCost(robot_poses, observations, X, Z);
+  double damping = INITIAL_DAMPING;
+  std::vector<CameraBlock> blocks(num_cameras);
+  for (std::size_t iteration = 0; iteration < MAX_ITERATIONS; ++iteration)
+  {
+    std::fill(blocks.begin(), blocks.end(), CameraBlock());
+    Matrix6d H_zz = Matrix6d::Zero();
+    Vector6d g_z = Vector6d::Zero();
+    for (const CameraObservation& observation : observations)
+    {
+      const Eigen::Isometry3d& M = robot_poses[observation.sample];
+      const Eigen::Isometry3d& C = observation.object_wrt_sensor;
+      const Eigen::Isometry3d& X_c = X[observation.camera];
+      const Vector6d residual = computeObservationResidual(M, X_c, C, Z);
+
+      // Numerical Jacobians by central differences
+      Matrix6d J_x, J_z;
+      for (Eigen::Index k = 0; k < 6; ++k)
+      {
+        Vector6d delta = Vector6d::Zero();
+        delta[k] = JACOBIAN_STEP;
+        J_x.col(k) = (computeObservationResidual(M, applyPoseIncrement(X_c, delta), C, Z) -
+                      computeObservationResidual(M, applyPoseIncrement(X_c, -delta), C, Z)) /
+                     (2. * JACOBIAN_STEP);
+        J_z.col(k) = (computeObservationResidual(M, X_c, C, applyPoseIncrement(Z, delta)) -
+                      computeObservationResidual(M, X_c, C, applyPoseIncrement(Z, -delta))) /
+                     (2. * JACOBIAN_STEP);
+      }
+
+      CameraBlock& block = blocks[observation.camera];
+      block.H_xx += J_x.transpose() * J_x;
+      block.H_xz += J_x.transpose() * J_z;
+      block.g_x += J_x.transpose() * residual;
+      H_zz += J_z.transpose() * J_z;
+      g_z += J_z.transpose() * residual;
+    }
+
+    // Increase the damping until the step reduces the cost
+    bool improved = false;
+    double step_norm = 0.;
+    while (!improved && damping < MAX_DAMPING)
+    {
+      // Reduced system of the object pose: (H_zz - sum H_xz^T H_xx^-1 H_xz) dz = -g_z + sum H_xz^T H_xx^-1 g_x
+      std::vector<Matrix6d> H_xx_inverse(num_cameras);
+      Matrix6d schur = H_zz;
+      schur.diagonal() += damping * (H_zz.diagonal().array() + 1.).matrix();
+      Vector6d schur_rhs = -g_z;
+      for (std::size_t c = 0; c < num_cameras; ++c)
+      {
+        Matrix6d H_xx = blocks[c].H_xx;
+        H_xx.diagonal() += damping * (blocks[c].H_xx.diagonal().array() + 1.).matrix();
+        H_xx_inverse[c] = H_xx.inverse();
+        schur -= blocks[c].H_xz.transpose() * H_xx_inverse[c] * blocks[c].H_xz;
+        schur_rhs += blocks[c].H_xz.transpose() * H_xx_inverse[c] * blocks[c].g_x;
+      }
+      const Vector6d step_z = schur.ldlt().solve(schur_rhs);
+
+      // Back-substitution of the camera steps
+      std::vector<Eigen::Isometry3d> candidate_X(num_cameras);
+      step_norm = step_z.squaredNorm();
+      for (std::size_t c = 0; c < num_cameras; ++c)
+      {
+        const Vector6d step_x = H_xx_inverse[c] * (-blocks[c].g_x - blocks[c].H_xz * step_z);
+        candidate_X[c] = applyPoseIncrement(X[c], step_x);
+        step_norm += step_x.squaredNorm();
+      }
+      const Eigen::Isometry3d candidate_Z = applyPoseIncrement(Z, step_z);
+      step_norm = std::sqrt(step_norm);
+
+      const double candidate_cost = computeCost(robot_poses, observations, candidate_X, candidate_Z);
+      if (std::isfinite(candidate_cost) && candidate_cost < cost)
+      {
+        X = candidate_X;
+        Z = candidate_Z;
+        cost = candidate_cost;
+        damping = std::max(damping / 10., 1e-12);
+        improved = true;
+      }
+      else
+      {
+        damping *= 10.;
+      }
+    }
+
+    if (!improved || step_norm < MIN_STEP_NORM)
+      break;
+  }
+
+  double rotation_error = 0.;
+  double translation_error = 0.;
+  for (const CameraObservation& observation : observations)
+  {
+    const Vector6d residual = computeObservationResidual(robot_poses[observation.sample], X[observation.camera],
+                                                         observation.object_wrt_sensor, Z);
+    rotation_error += residual.head<3>().squaredNorm();
+    translation_error += residual.tail<3>().squaredNorm();
+  }
+  residual_error_.rotation = std::sqrt(rotation_error / observations.size());
+  residual_error_.translation = std::sqrt(translation_error / observations.size());
+  camera_robot_poses_ = X;
+  object_robot_pose_ = Z;
+  return true;
+}
+
+const std::vector<Eigen::Isometry3d>& HandEyeMultiCameraSolver::getCameraRobotPoses() const
+{
+  return camera_robot_poses_;
+}
+
+const Eigen::Isometry3d& HandEyeMultiCameraSolver::getObjectRobotPose() const
+{
+  return object_robot_pose_;
+}
+
+const CalibrationError& HandEyeMultiCameraSolver::getResidualError() const
+{
+  return residual_error_;
+}
+
+}  // namespace moveit_handeye_calibration
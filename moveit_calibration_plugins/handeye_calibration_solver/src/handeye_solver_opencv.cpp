@@ -35,6 +35,7 @@
 /* Author: Andrej Orsula */
 
 #include <moveit/handeye_calibration_solver/handeye_solver_opencv.h>
+#include <moveit/handeye_calibration_solver/handeye_solver_refinement.h>
 #include <rclcpp/rclcpp.hpp>
 
 std::vector<cv::Mat> convertToCVMatrixRotation(const std::vector<Eigen::Isometry3d>& transformations)
@@ -178,6 +179,18 @@ bool HandEyeSolverDefault::solve(const std::vector<Eigen::Isometry3d>& effector_
 
   camera_robot_pose_ = convertToIsometry(R_cam2gripper, t_cam2gripper);
 
+  // OpenCV only accepts absolute poses, so the motion pairs of the current mode are used to refine its estimate
+  if (motion_pair_mode_ != CONSECUTIVE_PAIRS)
+  {
+    const MotionPairs pairs = getMotionPairs(effector_wrt_world, setup, motion_pair_mode_, max_motion_pairs_);
+    Eigen::Isometry3d refined_pose = camera_robot_pose_;
+    if (refineAXXB(effector_wrt_world, object_wrt_sensor, pairs, setup, refined_pose))
+      camera_robot_pose_ = refined_pose;
+    else
+      RCLCPP_WARN_STREAM(LOGGER_CALIBRATION_SOLVER, "Could not refine the calibration over " << pairs.size()
+                                                                                           << " motion pairs.");
+  }
+
   return true;
 }
 
@@ -0,0 +1,203 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt Calibration contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <moveit/handeye_calibration_solver/handeye_solver_refinement.h>
+
+namespace moveit_handeye_calibration
+{
+namespace
+{
+constexpr double JACOBIAN_STEP = 1e-6;    // Central difference step of the numerical Jacobian
+constexpr double INITIAL_DAMPING = 1e-3;  // Initial Levenberg-Marquardt damping factor
+constexpr double MAX_DAMPING = 1e10;      // Stop once steps are too small to reduce the cost
+constexpr double MIN_STEP_NORM = 1e-12;   // Stop once the increment is negligible
+}  // namespace
+
+Eigen::Vector3d getRotationVector(const Eigen::Matrix3d& rotation)
+{
+  Eigen::AngleAxisd angle_axis(rotation);
+  return angle_axis.angle() * angle_axis.axis();
+}
+
+Eigen::Isometry3d applyPoseIncrement(const Eigen::Isometry3d& pose, const Vector6d& delta)
+{
+  Eigen::Isometry3d result = pose;
+  const Eigen::Vector3d rotation_vector = delta.head<3>();
+  const double angle = rotation_vector.norm();
+  if (angle > 0.)
+    result.linear() = pose.linear() * Eigen::AngleAxisd(angle, rotation_vector / angle).toRotationMatrix();
+  result.translation() += delta.tail<3>();
+  return result;
+}
+
+bool refinePoses(std::vector<Eigen::Isometry3d>& poses, const PoseResidualFunction& residual_function,
+                 std::size_t max_iterations)
+{
+  const Eigen::Index num_params = 6 * poses.size();
+  Eigen::VectorXd residuals;
+  residual_function(poses, residuals);
+  if (num_params == 0 || residuals.size() == 0 || !residuals.allFinite())
+    return false;
+
+  double cost = residuals.squaredNorm();
+  double damping = INITIAL_DAMPING;
+  Eigen::MatrixXd jacobian(residuals.size(), num_params);
+  Eigen::VectorXd residuals_plus, residuals_minus;
+  std::vector<Eigen::Isometry3d> perturbed = poses;
+
+  for (std::size_t iteration = 0; iteration < max_iterations; ++iteration)
+  {
+    // Numerical Jacobian by central differences
+    for (Eigen::Index k = 0; k < num_params; ++k)
+    {
+      Vector6d delta = Vector6d::Zero();
+      delta[k % 6] = JACOBIAN_STEP;
+      perturbed[k / 6] = applyPoseIncrement(poses[k / 6], delta);
+      residual_function(perturbed, residuals_plus);
+      perturbed[k / 6] = applyPoseIncrement(poses[k / 6], -delta);
+      residual_function(perturbed, residuals_minus);
+      perturbed[k / 6] = poses[k / 6];
+      jacobian.col(k) = (residuals_plus - residuals_minus) / (2. * JACOBIAN_STEP);
+    }
+
+    const Eigen::MatrixXd hessian = jacobian.transpose() * jacobian;
+    const Eigen::VectorXd gradient = jacobian.transpose() * residuals;
+
+    // Increase the damping until the step reduces the cost
+    bool improved = false;
+    Eigen::VectorXd step;
+    while (!improved && damping < MAX_DAMPING)
+    {
+      Eigen::MatrixXd damped = hessian;
+      damped.diagonal() += damping * (hessian.diagonal().array() + 1.).matrix();
+      step = damped.ldlt().solve(-gradient);
+
+      for (std::size_t p = 0; p < poses.size(); ++p)
+        perturbed[p] = applyPoseIncrement(poses[p], step.segment<6>(6 * p));
+      Eigen::VectorXd candidate_residuals;
+      residual_function(perturbed, candidate_residuals);
+      const double candidate_cost = candidate_residuals.squaredNorm();
+      if (std::isfinite(candidate_cost) && candidate_cost < cost)
+      {
+        poses = perturbed;
+        residuals = candidate_residuals;
+        cost = candidate_cost;
+        damping = std::max(damping / 10., 1e-12);
+        improved = true;
+      }
+      else
+      {
+        perturbed = poses;
+        damping *= 10.;
+      }
+    }
+
+    if (!improved || step.norm() < MIN_STEP_NORM)
+      break;
+  }
+  return true;
+}
+
+void computeAXXBResiduals(const std::vector<Eigen::Isometry3d>& effector_wrt_world,
+                          const std::vector<Eigen::Isometry3d>& object_wrt_sensor, const Eigen::Isometry3d& X,
+                          const MotionPairs& pairs, SensorMountType setup, Eigen::VectorXd& residuals)
+{
+  residuals.resize(6 * pairs.size());
+  for (std::size_t k = 0; k < pairs.size(); ++k)
+  {
+    const Eigen::Isometry3d A =
+        HandEyeSolverBase::getRobotMotion(effector_wrt_world, pairs[k].first, pairs[k].second, setup);
+    const Eigen::Isometry3d B = HandEyeSolverBase::getObjectMotion(object_wrt_sensor, pairs[k].first, pairs[k].second);
+    residuals.segment<3>(6 * k) = getRotationVector((A.linear() * X.linear()).transpose() * X.linear() * B.linear());
+    residuals.segment<3>(6 * k + 3) =
+        A.linear() * X.translation() + A.translation() - X.linear() * B.translation() - X.translation();
+  }
+}
+
+bool refineAXXB(const std::vector<Eigen::Isometry3d>& effector_wrt_world,
+                const std::vector<Eigen::Isometry3d>& object_wrt_sensor, const MotionPairs& pairs,
+                SensorMountType setup, Eigen::Isometry3d& X)
+{
+  if (effector_wrt_world.size() != object_wrt_sensor.size() || pairs.empty())
+    return false;
+
+  std::vector<Eigen::Isometry3d> poses = { X };
+  auto residual_function = [&](const std::vector<Eigen::Isometry3d>& p, Eigen::VectorXd& residuals) {
+    computeAXXBResiduals(effector_wrt_world, object_wrt_sensor, p[0], pairs, setup, residuals);
+  };
+  if (!refinePoses(poses, residual_function))
+    return false;
+  X = poses[0];
+  return true;
+}
+
+Eigen::Isometry3d getRobotWorldRobotPose(const Eigen::Isometry3d& effector_wrt_world, SensorMountType setup)
+{
+  if (setup == EYE_IN_HAND)
+    return effector_wrt_world;
+  return effector_wrt_world.inverse();
+}
+
+void computeAXZBResiduals(const std::vector<Eigen::Isometry3d>& effector_wrt_world,
+                          const std::vector<Eigen::Isometry3d>& object_wrt_sensor, const Eigen::Isometry3d& X,
+                          const Eigen::Isometry3d& Z, SensorMountType setup, Eigen::VectorXd& residuals)
+{
+  residuals.resize(6 * effector_wrt_world.size());
+  for (std::size_t k = 0; k < effector_wrt_world.size(); ++k)
+  {
+    const Eigen::Isometry3d MXC = getRobotWorldRobotPose(effector_wrt_world[k], setup) * X * object_wrt_sensor[k];
+    residuals.segment<3>(6 * k) = getRotationVector(MXC.linear().transpose() * Z.linear());
+    residuals.segment<3>(6 * k + 3) = MXC.translation() - Z.translation();
+  }
+}
+
+bool refineAXZB(const std::vector<Eigen::Isometry3d>& effector_wrt_world,
+                const std::vector<Eigen::Isometry3d>& object_wrt_sensor, SensorMountType setup, Eigen::Isometry3d& X,
+                Eigen::Isometry3d& Z)
+{
+  if (effector_wrt_world.size() != object_wrt_sensor.size() || effector_wrt_world.empty())
+    return false;
+
+  std::vector<Eigen::Isometry3d> poses = { X, Z };
+  auto residual_function = [&](const std::vector<Eigen::Isometry3d>& p, Eigen::VectorXd& residuals) {
+    computeAXZBResiduals(effector_wrt_world, object_wrt_sensor, p[0], p[1], setup, residuals);
+  };
+  if (!refinePoses(poses, residual_function))
+    return false;
+  X = poses[0];
+  Z = poses[1];
+  return true;
+}
+
+}  // namespace moveit_handeye_calibration
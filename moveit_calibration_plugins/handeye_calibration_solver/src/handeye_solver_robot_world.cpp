@@ -0,0 +1,173 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt Calibration contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <moveit/handeye_calibration_solver/handeye_solver_robot_world.h>
+#include <moveit/handeye_calibration_solver/handeye_solver_refinement.h>
+
+namespace moveit_handeye_calibration
+{
+namespace
+{
+constexpr std::size_t MIN_ROBOT_WORLD_SAMPLES = 3;  // Smallest number of samples accepted by OpenCV
+
+void appendCVTransform(const Eigen::Isometry3d& transform, std::vector<cv::Mat>& rotations,
+                       std::vector<cv::Mat>& translations)
+{
+  cv::Mat rotation, translation;
+  cv::eigen2cv(Eigen::Matrix3d(transform.linear()), rotation);
+  cv::eigen2cv(Eigen::Vector3d(transform.translation()), translation);
+  rotations.push_back(rotation);
+  translations.push_back(translation);
+}
+
+Eigen::Isometry3d convertToIsometry(const cv::Mat& rotation, const cv::Mat& translation)
+{
+  Eigen::Matrix3d eigen_rotation;
+  Eigen::Vector3d eigen_translation;
+  cv::cv2eigen(rotation, eigen_rotation);
+  cv::cv2eigen(translation, eigen_translation);
+  Eigen::Isometry3d transform = Eigen::Isometry3d::Identity();
+  transform.linear() = eigen_rotation;
+  transform.translation() = eigen_translation;
+  return transform;
+}
+}  // namespace
+
+void HandEyeSolverRobotWorld::initialize()
+{
+  solver_names_ = { "Shah2013", "Li2010" };
+  solvers_["Shah2013"] = cv::CALIB_ROBOT_WORLD_HAND_EYE_SHAH;
+  solvers_["Li2010"] = cv::CALIB_ROBOT_WORLD_HAND_EYE_LI;
+  camera_robot_pose_ = Eigen::Isometry3d::Identity();
+  object_robot_pose_ = Eigen::Isometry3d::Identity();
+  object_robot_pose_valid_ = false;
+}
+
+const std::vector<std::string>& HandEyeSolverRobotWorld::getSolverNames() const
+{
+  return solver_names_;
+}
+
+const Eigen::Isometry3d& HandEyeSolverRobotWorld::getCameraRobotPose() const
+{
+  return camera_robot_pose_;
+}
+
+bool HandEyeSolverRobotWorld::getObjectRobotPose(Eigen::Isometry3d& object_robot_pose) const
+{
+  if (object_robot_pose_valid_)
+    object_robot_pose = object_robot_pose_;
+  return object_robot_pose_valid_;
+}
+
+bool HandEyeSolverRobotWorld::solve(const std::vector<Eigen::Isometry3d>& effector_wrt_world,
+                                    const std::vector<Eigen::Isometry3d>& object_wrt_sensor, SensorMountType setup,
+                                    const std::string& solver_name, std::string* error_message)
+{
+  std::string local_error_message;
+  if (!error_message)
+  {
+    error_message = &local_error_message;
+  }
+  object_robot_pose_valid_ = false;
+
+  // Check the size of the two sets of pose sample equal
+  if (effector_wrt_world.size() != object_wrt_sensor.size())
+  {
+    *error_message = "The sizes of the two input pose sample vectors are not equal: effector_wrt_world.size() = " +
+                     std::to_string(effector_wrt_world.size()) +
+                     " and object_wrt_sensor.size() == " + std::to_string(object_wrt_sensor.size());
+    RCLCPP_ERROR_STREAM(LOGGER_CALIBRATION_SOLVER, *error_message);
+    return false;
+  }
+
+  if (effector_wrt_world.size() < MIN_ROBOT_WORLD_SAMPLES)
+  {
+    *error_message = "At least " + std::to_string(MIN_ROBOT_WORLD_SAMPLES) +
+                     " pose samples are required, got " + std::to_string(effector_wrt_world.size());
+    RCLCPP_ERROR_STREAM(LOGGER_CALIBRATION_SOLVER, *error_message);
+    return false;
+  }
+
+  // Determine method
+  auto solver = solvers_.find(solver_name);
+  if (solver == solvers_.end())
+  {
+    *error_message = "Unknown handeye solver name: " + solver_name;
+    RCLCPP_ERROR_STREAM(LOGGER_CALIBRATION_SOLVER, *error_message);
+    return false;
+  }
+
+  if (setup != EYE_IN_HAND && setup != EYE_TO_HAND)
+  {
+    *error_message = "Invalid sensor mount configuration (must be eye-to-hand or eye-in-hand)";
+    RCLCPP_ERROR_STREAM(LOGGER_CALIBRATION_SOLVER, *error_message);
+    return false;
+  }
+
+  // OpenCV solves A X' = Z' B with A = C_i and B = M_i^-1, so that X' = Z^-1 and Z' = X^-1
+  std::vector<cv::Mat> R_world2cam, t_world2cam, R_base2gripper, t_base2gripper;
+  for (std::size_t i = 0; i < effector_wrt_world.size(); ++i)
+  {
+    appendCVTransform(object_wrt_sensor[i], R_world2cam, t_world2cam);
+    appendCVTransform(getRobotWorldRobotPose(effector_wrt_world[i], setup).inverse(), R_base2gripper, t_base2gripper);
+  }
+
+  cv::Mat R_base2world, t_base2world, R_gripper2cam, t_gripper2cam;
+  try
+  {
+    cv::calibrateRobotWorldHandEye(R_world2cam, t_world2cam, R_base2gripper, t_base2gripper, R_base2world,
+                                   t_base2world, R_gripper2cam, t_gripper2cam, solver->second);
+  }
+  catch (const cv::Exception& ex)
+  {
+    *error_message = std::string("Robot-world hand-eye calibration failed: ") + ex.what();
+    RCLCPP_ERROR_STREAM(LOGGER_CALIBRATION_SOLVER, *error_message);
+    return false;
+  }
+
+  Eigen::Isometry3d X = convertToIsometry(R_gripper2cam, t_gripper2cam).inverse();
+  Eigen::Isometry3d Z = convertToIsometry(R_base2world, t_base2world).inverse();
+
+  // The closed-form estimate decouples rotation and translation, refine both transforms jointly
+  if (!refineAXZB(effector_wrt_world, object_wrt_sensor, setup, X, Z))
+    RCLCPP_WARN(LOGGER_CALIBRATION_SOLVER, "Could not refine the robot-world hand-eye calibration.");
+
+  camera_robot_pose_ = X;
+  object_robot_pose_ = Z;
+  object_robot_pose_valid_ = true;
+  return true;
+}
+
+}  // namespace moveit_handeye_calibration
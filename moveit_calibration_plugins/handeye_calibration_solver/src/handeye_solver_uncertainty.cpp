@@ -0,0 +1,152 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt Calibration contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <random>
+#include <thread>
+#include <moveit/handeye_calibration_solver/handeye_solver_refinement.h>
+#include <moveit/handeye_calibration_solver/handeye_solver_uncertainty.h>
+
+namespace moveit_handeye_calibration
+{
+bool estimateCalibrationUncertainty(const std::vector<HandEyeSolverBase*>& solvers,
+                                    const std::vector<Eigen::Isometry3d>& effector_wrt_world,
+                                    const std::vector<Eigen::Isometry3d>& object_wrt_sensor,
+                                    const Eigen::Isometry3d& X, SensorMountType setup, const std::string& solver_name,
+                                    UncertaintyMethod method, std::size_t num_resamples,
+                                    CalibrationUncertainty& uncertainty, unsigned int seed,
+                                    const std::atomic<bool>* cancel)
+{
+  const std::size_t num_samples = effector_wrt_world.size();
+  if (solvers.empty() || num_samples != object_wrt_sensor.size() || num_samples < 3)
+    return false;
+
+  if (method == JACKKNIFE)
+    num_resamples = num_samples;
+
+  // Deviation of every resampled solution from X, as (rotation vector, translation)
+  std::vector<Vector6d> deviations(num_resamples, Vector6d::Zero());
+  std::vector<char> solved(num_resamples, false);
+  std::atomic<std::size_t> next_resample(0);
+
+  auto worker = [&](HandEyeSolverBase* solver) {
+    std::vector<Eigen::Isometry3d> effector_resampled, object_resampled;
+    std::vector<std::size_t> indices;
+    for (std::size_t k = next_resample++; k < num_resamples; k = next_resample++)
+    {
+      if (cancel && *cancel)
+        return;
+
+      indices.clear();
+      if (method == JACKKNIFE)
+      {
+        for (std::size_t i = 0; i < num_samples; ++i)
+          if (i != k)
+            indices.push_back(i);
+      }
+      else
+      {
+        std::mt19937 generator(seed + k);
+        std::uniform_int_distribution<std::size_t> distribution(0, num_samples - 1);
+        for (std::size_t i = 0; i < num_samples; ++i)
+          indices.push_back(distribution(generator));
+        // Keep the capture order, which matters for consecutive motion pairs
+        std::sort(indices.begin(), indices.end());
+        // A sample drawn twice only adds identity motions, which would pull the solution toward X and shrink the spread
+        indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+      }
+      if (indices.size() < MIN_RESAMPLE_DISTINCT_SAMPLES)
+        continue;
+
+      effector_resampled.clear();
+      object_resampled.clear();
+      for (std::size_t i : indices)
+      {
+        effector_resampled.push_back(effector_wrt_world[i]);
+        object_resampled.push_back(object_wrt_sensor[i]);
+      }
+
+      std::string error_message;
+      if (!solver->solve(effector_resampled, object_resampled, setup, solver_name, &error_message))
+        continue;
+
+      const Eigen::Isometry3d& pose = solver->getCameraRobotPose();
+      if (!pose.matrix().allFinite())
+        continue;
+      deviations[k].head<3>() = getRotationVector(X.linear().transpose() * pose.linear());
+      deviations[k].tail<3>() = pose.translation() - X.translation();
+      solved[k] = true;
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (std::size_t t = 1; t < solvers.size(); ++t)
+    threads.emplace_back(worker, solvers[t]);
+  worker(solvers[0]);
+  for (std::thread& thread : threads)
+    thread.join();
+  if (cancel && *cancel)
+    return false;
+
+  Vector6d mean = Vector6d::Zero();
+  std::size_t count = 0;
+  for (std::size_t k = 0; k < num_resamples; ++k)
+    if (solved[k])
+    {
+      mean += deviations[k];
+      ++count;
+    }
+  if (count < 2)
+    return false;
+  mean /= count;
+
+  Vector6d variance = Vector6d::Zero();
+  for (std::size_t k = 0; k < num_resamples; ++k)
+    if (solved[k])
+      variance += (deviations[k] - mean).cwiseAbs2();
+
+  // Jackknife resamples overlap in all but one sample, so their spread is scaled up by (n - 1)
+  if (method == JACKKNIFE)
+    variance *= double(count - 1) / count;
+  else
+    variance /= count - 1;
+
+  uncertainty.rotation_stddev = variance.head<3>().cwiseSqrt();
+  uncertainty.translation_stddev = variance.tail<3>().cwiseSqrt();
+  uncertainty.num_resamples = count;
+  return true;
+}
+
+}  // namespace moveit_handeye_calibration
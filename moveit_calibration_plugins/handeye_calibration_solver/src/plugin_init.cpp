@@ -35,5 +35,8 @@
 /* Author: Yu Yan */
 #include <pluginlib/class_list_macros.hpp>
 #include <moveit/handeye_calibration_solver/handeye_solver_opencv.h>
+#include <moveit/handeye_calibration_solver/handeye_solver_robot_world.h>
 
 PLUGINLIB_EXPORT_CLASS(moveit_handeye_calibration::HandEyeSolverDefault, moveit_handeye_calibration::HandEyeSolverBase)
+PLUGINLIB_EXPORT_CLASS(moveit_handeye_calibration::HandEyeSolverRobotWorld,
+                       moveit_handeye_calibration::HandEyeSolverBase)
@@ -0,0 +1,241 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt Calibration contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <benchmark/benchmark.h>
+#include <moveit/handeye_calibration_solver/handeye_solver_opencv.h>
+#include <moveit/handeye_calibration_solver/handeye_solver_robot_world.h>
+#include <moveit/handeye_calibration_tools/handeye_synthetic_data.h>
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <sstream>
+
+namespace mhc = moveit_handeye_calibration;
+
+// Throughput and accuracy of every solver on synthetic AX = XB samples with a known calibration. The noise levels are
+// set with --noise=<rotation (rad)>:<translation (m)>, which can be repeated. Run with --benchmark_out=<file>
+// --benchmark_out_format=json to track the results.
+namespace
+{
+using SolverFactory = std::function<std::unique_ptr<mhc::HandEyeSolverBase>()>;
+
+struct Noise
+{
+  double rotation;     // Standard deviation of the rotation vector components of the object pose, in rad
+  double translation;  // Standard deviation of the translation components of the object pose, in m
+};
+
+struct SyntheticSamples
+{
+  Eigen::Isometry3d camera_robot_pose;
+  std::vector<Eigen::Isometry3d> effector_wrt_world;
+  std::vector<Eigen::Isometry3d> object_wrt_sensor;
+};
+
+const std::vector<int64_t> NUM_SAMPLES = { 5, 10, 100, 1000, 10000, 100000 };
+const mhc::SensorMountType SETUP = mhc::EYE_TO_HAND;
+
+std::vector<Noise> noise_levels = { { 0., 0. }, { 1e-3, 1e-3 }, { 5e-3, 5e-3 } };
+
+/**
+ * @brief Eye-to-hand samples from the synthetic data generator, without images. The noise is applied to the object
+ * poses, as the camera is the less accurate sensor.
+ */
+SyntheticSamples generateSamples(std::size_t num_samples, const Noise& noise)
+{
+  sensor_msgs::msg::CameraInfo camera_info;
+  camera_info.width = 640;
+  camera_info.height = 480;
+  camera_info.k = { 600., 0., 320., 0., 600., 240., 0., 0., 1. };
+
+  mhc::SyntheticDataOptions options;
+  options.setup = SETUP;
+  options.num_samples = num_samples;
+  options.rotation_noise = noise.rotation;
+  options.translation_noise = noise.translation;
+  options.render_images = false;
+  options.seed = 42;
+  mhc::SyntheticDataset dataset;
+  mhc::generateSyntheticData(nullptr, camera_info, options, dataset);
+
+  const mhc::SampleSet sample_set = mhc::getSampleSet(dataset);
+  SyntheticSamples samples;
+  samples.camera_robot_pose = dataset.camera_robot_pose;
+  samples.effector_wrt_world = sample_set.effector_wrt_world;
+  samples.object_wrt_sensor = sample_set.object_wrt_sensor;
+  return samples;
+}
+
+/**
+ * @brief Samples shared by all solvers, generated on first use.
+ */
+const SyntheticSamples& getSamples(std::size_t num_samples, std::size_t noise_level)
+{
+  static std::map<std::pair<std::size_t, std::size_t>, SyntheticSamples> samples;
+  auto it = samples.find({ num_samples, noise_level });
+  if (it == samples.end())
+    it = samples.emplace(std::make_pair(num_samples, noise_level),
+                         generateSamples(num_samples, noise_levels[noise_level]))
+             .first;
+  return it->second;
+}
+
+void setNoiseLabel(benchmark::State& state, const Noise& noise)
+{
+  std::ostringstream label;
+  label << "noise " << noise.rotation << " rad, " << noise.translation << " m";
+  state.SetLabel(label.str());
+}
+
+/**
+ * @brief Solve the samples, with the number of samples and the noise level as arguments.
+ */
+void BM_Solve(benchmark::State& state, const SolverFactory& factory, const std::string& solver_name)
+{
+  const SyntheticSamples& samples = getSamples(state.range(0), state.range(1));
+  std::unique_ptr<mhc::HandEyeSolverBase> solver = factory();
+  solver->initialize();
+
+  for (auto _ : state)
+  {
+    std::string error_message;
+    if (!solver->solve(samples.effector_wrt_world, samples.object_wrt_sensor, SETUP, solver_name, &error_message))
+    {
+      state.SkipWithError(error_message.c_str());
+      return;
+    }
+  }
+
+  // Accuracy with respect to the true calibration
+  const Eigen::Isometry3d& pose = solver->getCameraRobotPose();
+  state.counters["rotation_error_rad"] =
+      Eigen::AngleAxisd(pose.rotation().transpose() * samples.camera_robot_pose.rotation()).angle();
+  state.counters["translation_error_m"] = (pose.translation() - samples.camera_robot_pose.translation()).norm();
+  state.counters["samples_per_second"] =
+      benchmark::Counter(state.range(0), benchmark::Counter::kIsIterationInvariantRate);
+  setNoiseLabel(state, noise_levels[state.range(1)]);
+}
+
+/**
+ * @brief Reprojection error of the true calibration over the consecutive motion pairs.
+ */
+void BM_ReprojectionError(benchmark::State& state)
+{
+  const SyntheticSamples& samples = getSamples(state.range(0), state.range(1));
+  mhc::HandEyeSolverDefault solver;
+  solver.initialize();
+
+  mhc::CalibrationError error;
+  for (auto _ : state)
+  {
+    error = solver.getCalibrationError(samples.effector_wrt_world, samples.object_wrt_sensor,
+                                       samples.camera_robot_pose, SETUP);
+    benchmark::DoNotOptimize(error);
+  }
+  state.counters["reprojection_rotation_rad"] = error.rotation;
+  state.counters["reprojection_translation_m"] = error.translation;
+  state.counters["samples_per_second"] =
+      benchmark::Counter(state.range(0), benchmark::Counter::kIsIterationInvariantRate);
+  setNoiseLabel(state, noise_levels[state.range(1)]);
+}
+
+/**
+ * @brief Remove the --noise arguments, which replace the default noise levels.
+ */
+bool parseNoiseArguments(int& argc, char** argv)
+{
+  const std::string prefix = "--noise=";
+  std::vector<Noise> levels;
+  int num_args = 1;
+  for (int i = 1; i < argc; ++i)
+  {
+    const std::string arg = argv[i];
+    if (arg.compare(0, prefix.size(), prefix) != 0)
+    {
+      argv[num_args++] = argv[i];
+      continue;
+    }
+    Noise noise;
+    char separator;
+    std::istringstream value(arg.substr(prefix.size()));
+    if (!(value >> noise.rotation >> separator >> noise.translation) || separator != ':')
+    {
+      std::cerr << "Invalid argument " << arg << ", expected --noise=<rotation (rad)>:<translation (m)>" << std::endl;
+      return false;
+    }
+    levels.push_back(noise);
+  }
+  argc = num_args;
+  if (!levels.empty())
+    noise_levels = levels;
+  return true;
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+  if (!parseNoiseArguments(argc, argv))
+    return 1;
+
+  std::vector<int64_t> noise_indices;
+  for (std::size_t i = 0; i < noise_levels.size(); ++i)
+    noise_indices.push_back(i);
+
+  // One benchmark per solver name of every solver
+  const std::vector<std::pair<std::string, SolverFactory>> factories = {
+    { "OpenCV", [] { return std::make_unique<mhc::HandEyeSolverDefault>(); } },
+    { "RobotWorld", [] { return std::make_unique<mhc::HandEyeSolverRobotWorld>(); } },
+  };
+  for (const auto& factory : factories)
+  {
+    std::unique_ptr<mhc::HandEyeSolverBase> solver = factory.second();
+    solver->initialize();
+    for (const std::string& solver_name : solver->getSolverNames())
+      benchmark::RegisterBenchmark(("BM_Solve/" + factory.first + "/" + solver_name).c_str(), BM_Solve,
+                                   factory.second, solver_name)
+          ->ArgsProduct({ NUM_SAMPLES, noise_indices })
+          ->Unit(benchmark::kMillisecond);
+  }
+  benchmark::RegisterBenchmark("BM_ReprojectionError", BM_ReprojectionError)
+      ->ArgsProduct({ NUM_SAMPLES, noise_indices })
+      ->Unit(benchmark::kMicrosecond);
+
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    return 1;
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return 0;
+}
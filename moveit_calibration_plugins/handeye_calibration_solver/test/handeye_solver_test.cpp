@@ -38,6 +38,7 @@
 #include <gtest/gtest.h>
 #include <jsoncpp/json/json.h>
 #include <moveit/handeye_calibration_solver/handeye_solver_base.h>
+#include <moveit/handeye_calibration_solver/handeye_solver_multi_camera.h>
 #include <pluginlib/class_loader.hpp>
 #include <rclcpp/rclcpp.hpp>
 #include <ament_index_cpp/get_package_share_directory.hpp>
@@ -89,6 +90,19 @@ protected:
   {
   }
 
+  void loadSamples(std::vector<Eigen::Isometry3d>& eef_wrt_world, std::vector<Eigen::Isometry3d>& obj_wrt_sensor)
+  {
+    eef_wrt_world.assign(root_.size(), Eigen::Isometry3d::Identity());
+    obj_wrt_sensor.assign(root_.size(), Eigen::Isometry3d::Identity());
+    for (int i = 0; i < root_.size(); ++i)
+      for (int m = 0; m < 4; ++m)
+        for (int n = 0; n < 4; ++n)
+        {
+          eef_wrt_world[i](m, n) = root_[i][0][m][n].asDouble();
+          obj_wrt_sensor[i](m, n) = root_[i][1][m][n].asDouble();
+        }
+  }
+
 protected:
   pluginlib::UniquePtr<moveit_handeye_calibration::HandEyeSolverBase> solver_;
   std::unique_ptr<pluginlib::ClassLoader<moveit_handeye_calibration::HandEyeSolverBase>> solver_plugins_loader_;
@@ -158,6 +172,104 @@ TEST_F(MoveItHandEyeSolverTester, SolveAXEQXB)
   }
 }
 
+TEST_F(MoveItHandEyeSolverTester, MotionPairModes)
+{
+  std::vector<Eigen::Isometry3d> eef_wrt_world, obj_wrt_sensor;
+  loadSamples(eef_wrt_world, obj_wrt_sensor);
+  const std::size_t n = eef_wrt_world.size();
+
+  using moveit_handeye_calibration::HandEyeSolverBase;
+  auto pairs = HandEyeSolverBase::getMotionPairs(eef_wrt_world, moveit_handeye_calibration::EYE_TO_HAND,
+                                                 moveit_handeye_calibration::CONSECUTIVE_PAIRS);
+  ASSERT_EQ(pairs.size(), n - 1);
+  pairs = HandEyeSolverBase::getMotionPairs(eef_wrt_world, moveit_handeye_calibration::EYE_TO_HAND,
+                                            moveit_handeye_calibration::ALL_PAIRS);
+  ASSERT_EQ(pairs.size(), n * (n - 1) / 2);
+  pairs = HandEyeSolverBase::getMotionPairs(eef_wrt_world, moveit_handeye_calibration::EYE_TO_HAND,
+                                            moveit_handeye_calibration::SELECTED_PAIRS, 60);
+  ASSERT_EQ(pairs.size(), 60);
+  for (const auto& pair : pairs)
+    ASSERT_LT(pair.first, pair.second);
+
+  Eigen::Vector3d t(0.659, -0.249, 0.830);
+  for (auto mode : { moveit_handeye_calibration::ALL_PAIRS, moveit_handeye_calibration::SELECTED_PAIRS })
+  {
+    solver_->setMotionPairMode(mode);
+    const std::string& name = solver_->getSolverNames().front();
+    ASSERT_TRUE(solver_->solve(eef_wrt_world, obj_wrt_sensor, moveit_handeye_calibration::EYE_TO_HAND, name));
+    ASSERT_TRUE(solver_->getCameraRobotPose().translation().isApprox(t, 0.01));
+    auto error = solver_->getCalibrationError(eef_wrt_world, obj_wrt_sensor, solver_->getCameraRobotPose(),
+                                              moveit_handeye_calibration::EYE_TO_HAND);
+    ASSERT_TRUE(std::isfinite(error.rotation) && std::isfinite(error.translation));
+    auto error_pair = solver_->getReprojectionError(eef_wrt_world, obj_wrt_sensor, solver_->getCameraRobotPose(),
+                                                    moveit_handeye_calibration::EYE_TO_HAND);
+    ASSERT_DOUBLE_EQ(error_pair.first, error.rotation);
+    ASSERT_DOUBLE_EQ(error_pair.second, error.translation);
+  }
+}
+
+TEST_F(MoveItHandEyeSolverTester, SolveRobotWorld)
+{
+  std::vector<Eigen::Isometry3d> eef_wrt_world, obj_wrt_sensor;
+  loadSamples(eef_wrt_world, obj_wrt_sensor);
+
+  pluginlib::UniquePtr<moveit_handeye_calibration::HandEyeSolverBase> solver =
+      solver_plugins_loader_->createUniqueInstance("RobotWorld");
+  solver->initialize();
+  Eigen::Isometry3d object_robot_pose;
+  ASSERT_FALSE(solver->getObjectRobotPose(object_robot_pose));
+  ASSERT_FALSE(solver_->getObjectRobotPose(object_robot_pose));
+
+  Eigen::Vector3d t(0.659, -0.249, 0.830);
+  for (const std::string& name : solver->getSolverNames())
+  {
+    std::string error_message;
+    ASSERT_TRUE(
+        solver->solve(eef_wrt_world, obj_wrt_sensor, moveit_handeye_calibration::EYE_TO_HAND, name, &error_message));
+    const Eigen::Isometry3d& X = solver->getCameraRobotPose();
+    ASSERT_TRUE(X.translation().isApprox(t, 0.01));
+    ASSERT_TRUE(solver->getObjectRobotPose(object_robot_pose));
+
+    // The object pose w.r.t. the end-effector must agree with every sample
+    for (std::size_t i = 0; i < eef_wrt_world.size(); ++i)
+    {
+      Eigen::Isometry3d predicted = eef_wrt_world[i].inverse() * X * obj_wrt_sensor[i];
+      ASSERT_LT((predicted.translation() - object_robot_pose.translation()).norm(), 0.05);
+    }
+  }
+}
+
+TEST_F(MoveItHandEyeSolverTester, SolveMultiCamera)
+{
+  std::vector<Eigen::Isometry3d> eef_wrt_world, obj_wrt_sensor;
+  loadSamples(eef_wrt_world, obj_wrt_sensor);
+
+  // A second camera rigidly attached to the first one, which only sees the object in every other sample
+  Eigen::Isometry3d offset = Eigen::Isometry3d::Identity();
+  offset.translate(Eigen::Vector3d(0.1, -0.05, 0.02));
+  offset.rotate(Eigen::AngleAxisd(0.3, Eigen::Vector3d::UnitZ()));
+  std::vector<moveit_handeye_calibration::CameraObservation> observations;
+  for (std::size_t i = 0; i < eef_wrt_world.size(); ++i)
+  {
+    observations.push_back({ 0, i, obj_wrt_sensor[i] });
+    if (i % 2 == 0)
+      observations.push_back({ 1, i, offset.inverse() * obj_wrt_sensor[i] });
+  }
+
+  moveit_handeye_calibration::HandEyeMultiCameraSolver solver;
+  std::string error_message;
+  ASSERT_TRUE(solver.solve(eef_wrt_world, observations, 2, moveit_handeye_calibration::EYE_TO_HAND, &error_message));
+  const std::vector<Eigen::Isometry3d>& poses = solver.getCameraRobotPoses();
+  ASSERT_EQ(poses.size(), 2);
+  ASSERT_TRUE(poses[0].translation().isApprox(Eigen::Vector3d(0.659, -0.249, 0.830), 0.01));
+  ASSERT_TRUE((poses[0] * offset).translation().isApprox(poses[1].translation(), 1e-3));
+  const moveit_handeye_calibration::CalibrationError& error = solver.getResidualError();
+  ASSERT_TRUE(std::isfinite(error.rotation) && std::isfinite(error.translation));
+
+  // Cameras without observations cannot be calibrated
+  ASSERT_FALSE(solver.solve(eef_wrt_world, observations, 3, moveit_handeye_calibration::EYE_TO_HAND));
+}
+
 int main(int argc, char** argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
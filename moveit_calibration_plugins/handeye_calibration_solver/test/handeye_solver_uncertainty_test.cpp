@@ -0,0 +1,281 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt Calibration contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+
+#include <gtest/gtest.h>
+#include <moveit/handeye_calibration_solver/handeye_solver_refinement.h>
+#include <moveit/handeye_calibration_solver/handeye_solver_uncertainty.h>
+#include <random>
+
+namespace mhc = moveit_handeye_calibration;
+
+namespace
+{
+// Applies a pose difference drawn from the given noise generator
+Eigen::Isometry3d perturb(const Eigen::Isometry3d& pose, double rotation_noise, double translation_noise,
+                          std::mt19937& generator)
+{
+  std::normal_distribution<double> rotation(0., rotation_noise);
+  std::normal_distribution<double> translation(0., translation_noise);
+  const Eigen::Vector3d r(rotation(generator), rotation(generator), rotation(generator));
+  Eigen::Isometry3d noise = Eigen::Isometry3d::Identity();
+  if (r.norm() > 0.)
+    noise.linear() = Eigen::AngleAxisd(r.norm(), r.normalized()).toRotationMatrix();
+  noise.translation() = Eigen::Vector3d(translation(generator), translation(generator), translation(generator));
+  return pose * noise;
+}
+
+// Eye-to-hand samples of a known calibration X, with noise on the object poses
+struct Samples
+{
+  Eigen::Isometry3d X;
+  std::vector<Eigen::Isometry3d> effector_wrt_world;
+  std::vector<Eigen::Isometry3d> object_wrt_sensor;
+};
+
+Samples generateSamples(std::size_t num_samples, double rotation_noise, double translation_noise, unsigned int seed)
+{
+  Samples samples;
+  samples.X = Eigen::Translation3d(1.2, 0.3, 0.8) * Eigen::AngleAxisd(2.5, Eigen::Vector3d(0.2, 1., -0.3).normalized());
+  const Eigen::Isometry3d object_wrt_effector(Eigen::Translation3d(0.02, -0.01, 0.1) *
+                                              Eigen::AngleAxisd(0.4, Eigen::Vector3d::UnitX()));
+
+  // The robot poses are the same for every seed, only the noise changes
+  std::mt19937 pose_generator(0);
+  std::uniform_real_distribution<double> angle(-0.6, 0.6);
+  std::uniform_real_distribution<double> position(-0.2, 0.2);
+  std::mt19937 noise_generator(seed);
+  for (std::size_t i = 0; i < num_samples; ++i)
+  {
+    const Eigen::Isometry3d effector_wrt_world(
+        Eigen::Translation3d(0.5 + position(pose_generator), position(pose_generator), 0.4 + position(pose_generator)) *
+        Eigen::AngleAxisd(angle(pose_generator), Eigen::Vector3d::UnitX()) *
+        Eigen::AngleAxisd(angle(pose_generator), Eigen::Vector3d::UnitY()) *
+        Eigen::AngleAxisd(angle(pose_generator), Eigen::Vector3d::UnitZ()));
+    samples.effector_wrt_world.push_back(effector_wrt_world);
+    samples.object_wrt_sensor.push_back(perturb(samples.X.inverse() * effector_wrt_world * object_wrt_effector,
+                                                rotation_noise, translation_noise, noise_generator));
+  }
+  return samples;
+}
+
+// Least-squares AX = XB solution over consecutive motions, starting from the true calibration
+class RefinementSolver : public mhc::HandEyeSolverBase
+{
+public:
+  explicit RefinementSolver(const Eigen::Isometry3d& X) : X_(X), pose_(X)
+  {
+  }
+
+  void initialize() override
+  {
+  }
+
+  const std::vector<std::string>& getSolverNames() const override
+  {
+    return solver_names_;
+  }
+
+  bool solve(const std::vector<Eigen::Isometry3d>& effector_wrt_world,
+             const std::vector<Eigen::Isometry3d>& object_wrt_sensor, mhc::SensorMountType setup,
+             const std::string& solver_name, std::string* error_message) override
+  {
+    pose_ = X_;
+    return mhc::refineAXXB(effector_wrt_world, object_wrt_sensor,
+                           getMotionPairs(effector_wrt_world, setup, motion_pair_mode_, max_motion_pairs_), setup,
+                           pose_);
+  }
+
+  const Eigen::Isometry3d& getCameraRobotPose() const override
+  {
+    return pose_;
+  }
+
+private:
+  const std::vector<std::string> solver_names_ = { "Refinement" };
+  const Eigen::Isometry3d X_;
+  Eigen::Isometry3d pose_;
+};
+
+// Returns X offset by the mean end-effector position, and records the fewest distinct samples it was given
+class MeanSolver : public mhc::HandEyeSolverBase
+{
+public:
+  explicit MeanSolver(const Eigen::Isometry3d& X) : X_(X), pose_(X)
+  {
+  }
+
+  void initialize() override
+  {
+  }
+
+  const std::vector<std::string>& getSolverNames() const override
+  {
+    return solver_names_;
+  }
+
+  bool solve(const std::vector<Eigen::Isometry3d>& effector_wrt_world,
+             const std::vector<Eigen::Isometry3d>& object_wrt_sensor, mhc::SensorMountType setup,
+             const std::string& solver_name, std::string* error_message) override
+  {
+    std::size_t num_distinct = 0;
+    Eigen::Vector3d mean = Eigen::Vector3d::Zero();
+    for (std::size_t i = 0; i < effector_wrt_world.size(); ++i)
+    {
+      if (i == 0 || !effector_wrt_world[i].isApprox(effector_wrt_world[i - 1], 0.))
+        ++num_distinct;
+      mean += effector_wrt_world[i].translation();
+    }
+    min_distinct_samples = std::min(min_distinct_samples, num_distinct);
+    pose_ = X_;
+    pose_.translation() += mean / effector_wrt_world.size();
+    return true;
+  }
+
+  const Eigen::Isometry3d& getCameraRobotPose() const override
+  {
+    return pose_;
+  }
+
+  std::size_t min_distinct_samples = std::numeric_limits<std::size_t>::max();
+
+private:
+  const std::vector<std::string> solver_names_ = { "Mean" };
+  const Eigen::Isometry3d X_;
+  Eigen::Isometry3d pose_;
+};
+}  // namespace
+
+TEST(HandEyeSolverUncertainty, BootstrapMatchesNoise)
+{
+  const std::size_t num_samples = 20;
+  const double rotation_noise = 2e-3;
+  const double translation_noise = 2e-3;
+
+  const Eigen::Isometry3d X = generateSamples(num_samples, 0., 0., 0).X;
+  RefinementSolver solver_a(X), solver_b(X);
+  const std::vector<mhc::HandEyeSolverBase*> solvers = { &solver_a, &solver_b };
+
+  // Spread of the calibration over independent noise realizations
+  Eigen::Vector3d rotation_variance = Eigen::Vector3d::Zero();
+  Eigen::Vector3d translation_variance = Eigen::Vector3d::Zero();
+  const std::size_t num_trials = 50;
+  for (std::size_t seed = 1; seed <= num_trials; ++seed)
+  {
+    const Samples samples = generateSamples(num_samples, rotation_noise, translation_noise, seed);
+    ASSERT_TRUE(solver_a.solve(samples.effector_wrt_world, samples.object_wrt_sensor, mhc::EYE_TO_HAND, "", nullptr));
+    const Eigen::Isometry3d& pose = solver_a.getCameraRobotPose();
+    rotation_variance += mhc::getRotationVector(X.linear().transpose() * pose.linear()).cwiseAbs2();
+    translation_variance += (pose.translation() - X.translation()).cwiseAbs2();
+  }
+  const Eigen::Vector3d rotation_stddev = (rotation_variance / num_trials).cwiseSqrt();
+  const Eigen::Vector3d translation_stddev = (translation_variance / num_trials).cwiseSqrt();
+
+  // The bootstrap estimate from a single sample set should match it within a factor of two
+  const Samples samples = generateSamples(num_samples, rotation_noise, translation_noise, 0);
+  ASSERT_TRUE(solver_a.solve(samples.effector_wrt_world, samples.object_wrt_sensor, mhc::EYE_TO_HAND, "", nullptr));
+  const Eigen::Isometry3d calibration = solver_a.getCameraRobotPose();
+  mhc::CalibrationUncertainty uncertainty;
+  ASSERT_TRUE(mhc::estimateCalibrationUncertainty(solvers, samples.effector_wrt_world, samples.object_wrt_sensor,
+                                                  calibration, mhc::EYE_TO_HAND, "Refinement", mhc::BOOTSTRAP, 100,
+                                                  uncertainty));
+  EXPECT_GT(uncertainty.num_resamples, 90u);
+  for (Eigen::Index i = 0; i < 3; ++i)
+  {
+    EXPECT_GT(uncertainty.rotation_stddev[i], rotation_stddev[i] / 2.);
+    EXPECT_LT(uncertainty.rotation_stddev[i], rotation_stddev[i] * 2.);
+    EXPECT_GT(uncertainty.translation_stddev[i], translation_stddev[i] / 2.);
+    EXPECT_LT(uncertainty.translation_stddev[i], translation_stddev[i] * 2.);
+  }
+}
+
+TEST(HandEyeSolverUncertainty, JackknifeOfMean)
+{
+  const Samples samples = generateSamples(10, 0., 0., 0);
+  MeanSolver solver(samples.X);
+  mhc::CalibrationUncertainty uncertainty;
+  ASSERT_TRUE(mhc::estimateCalibrationUncertainty({ &solver }, samples.effector_wrt_world, samples.object_wrt_sensor,
+                                                  samples.X, mhc::EYE_TO_HAND, "Mean", mhc::JACKKNIFE, 0,
+                                                  uncertainty));
+  EXPECT_EQ(uncertainty.num_resamples, 10u);
+
+  // The jackknife standard error of the mean is the sample standard deviation over sqrt(n)
+  Eigen::Vector3d mean = Eigen::Vector3d::Zero();
+  for (const Eigen::Isometry3d& pose : samples.effector_wrt_world)
+    mean += pose.translation() / 10.;
+  Eigen::Vector3d variance = Eigen::Vector3d::Zero();
+  for (const Eigen::Isometry3d& pose : samples.effector_wrt_world)
+    variance += (pose.translation() - mean).cwiseAbs2() / 9.;
+  EXPECT_TRUE(uncertainty.translation_stddev.isApprox((variance / 10.).cwiseSqrt(), 1e-9));
+  EXPECT_TRUE(uncertainty.rotation_stddev.isZero());
+}
+
+TEST(HandEyeSolverUncertainty, RejectDegenerateResamples)
+{
+  // Bootstrap resamples of four samples often draw fewer than three distinct samples
+  const Samples samples = generateSamples(4, 0., 0., 0);
+  MeanSolver solver_a(samples.X), solver_b(samples.X);
+  mhc::CalibrationUncertainty uncertainty;
+  ASSERT_TRUE(mhc::estimateCalibrationUncertainty({ &solver_a, &solver_b }, samples.effector_wrt_world,
+                                                  samples.object_wrt_sensor, samples.X, mhc::EYE_TO_HAND, "Mean",
+                                                  mhc::BOOTSTRAP, 100, uncertainty));
+  EXPECT_GE(solver_a.min_distinct_samples, mhc::MIN_RESAMPLE_DISTINCT_SAMPLES);
+  EXPECT_GE(solver_b.min_distinct_samples, mhc::MIN_RESAMPLE_DISTINCT_SAMPLES);
+  EXPECT_GT(uncertainty.num_resamples, 1u);
+  EXPECT_LT(uncertainty.num_resamples, 100u);
+
+  // Leaving out one of three samples leaves a single motion, so no jackknife resample can be solved
+  const Samples three = generateSamples(3, 0., 0., 0);
+  EXPECT_FALSE(mhc::estimateCalibrationUncertainty({ &solver_a }, three.effector_wrt_world, three.object_wrt_sensor,
+                                                   three.X, mhc::EYE_TO_HAND, "Mean", mhc::JACKKNIFE, 0,
+                                                   uncertainty));
+}
+
+TEST(HandEyeSolverUncertainty, Cancel)
+{
+  const Samples samples = generateSamples(10, 0., 0., 0);
+  MeanSolver solver(samples.X);
+  const std::atomic<bool> cancel(true);
+  mhc::CalibrationUncertainty uncertainty;
+  EXPECT_FALSE(mhc::estimateCalibrationUncertainty({ &solver }, samples.effector_wrt_world, samples.object_wrt_sensor,
+                                                   samples.X, mhc::EYE_TO_HAND, "Mean", mhc::BOOTSTRAP, 100,
+                                                   uncertainty, 0, &cancel));
+  EXPECT_EQ(solver.min_distinct_samples, std::numeric_limits<std::size_t>::max());
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -36,6 +36,7 @@
 
 #pragma once
 
+#include <memory>
 #include <vector>
 #include <moveit/handeye_calibration_target/handeye_target_base.h>
 
@@ -54,6 +55,8 @@ public:
 
   virtual bool createTargetImage(cv::Mat& image) const override;
 
+  virtual bool getTargetImageTransform(cv::Matx23d& target_to_image) const override;
+
   virtual bool detectTargetPose(cv::Mat& image) override;
 
 protected:
@@ -72,18 +75,56 @@ private:
     { "DICT_ARUCO_ORIGINAL", cv::aruco::DICT_ARUCO_ORIGINAL }
   };
 
-  // Target intrinsic params
-  int markers_x_;                                        // Number of markers along X axis
-  int markers_y_;                                        // Number of markers along Y axis
-  int marker_size_;                                      // Marker size in pixels
-  int separation_;                                       // Marker separation distance in pixels
-  int border_bits_;                                      // Margin of boarder in bits
-  cv::aruco::PREDEFINED_DICTIONARY_NAME dictionary_id_;  // Marker dictionary id
+  /**
+   * @brief Immutable snapshot of the target configuration. The setters publish a new snapshot, and detection works
+   * on the snapshot it loaded, so configuration changes and detection never wait for each other.
+   */
+  struct BoardConfig
+  {
+    // Target intrinsic params
+    int markers_x = 0;                                      // Number of markers along X axis
+    int markers_y = 0;                                      // Number of markers along Y axis
+    int marker_size = 0;                                    // Marker size in pixels
+    int separation = 0;                                     // Marker separation in pixels
+    int border_bits = 0;                                    // Margin of boarder in bits
+    cv::aruco::PREDEFINED_DICTIONARY_NAME dictionary_id{};  // Marker dictionary id
+
+    // Target real dimensions in meters
+    double marker_size_real = 0.;        // Printed marker size
+    double marker_separation_real = 0.;  // Printed marker separation distance
+
+    // Detection objects, built from the params above once they are all set
+    cv::Ptr<cv::aruco::Dictionary> dictionary;
+    cv::Ptr<cv::aruco::GridBoard> board;
+    cv::Ptr<cv::aruco::DetectorParameters> detector_params;
+  };
+
+  std::shared_ptr<const BoardConfig> getBoardConfig() const
+  {
+    return std::atomic_load(&board_config_);
+  }
+
+  // Validate params and set them in a board config, without publishing it
+  bool fillTargetIntrinsicParams(BoardConfig& board_config, int markers_x, int markers_y, int marker_size,
+                                 int separation, int border_bits, const std::string& dictionary_id);
+  bool fillTargetDimension(BoardConfig& board_config, double marker_measured_size, double marker_measured_separation);
+
+  // Build the detection objects of a board config and publish it, call with aruco_mutex_ held
+  void publishBoardConfig(BoardConfig board_config);
+
+  std::shared_ptr<const BoardConfig> board_config_;
 
-  // Target real dimensions in meters
-  double marker_size_real_;        // Printed marker size
-  double marker_separation_real_;  // Printed marker separation distance
+  // Handles of the target parameters
+  ParameterHandle<int> markers_x_param_;
+  ParameterHandle<int> markers_y_param_;
+  ParameterHandle<int> marker_size_param_;
+  ParameterHandle<int> separation_param_;
+  ParameterHandle<int> border_bits_param_;
+  ParameterHandle<std::string> dictionary_param_;
+  ParameterHandle<double> marker_measured_size_param_;
+  ParameterHandle<double> marker_measured_separation_param_;
 
+  // Serializes board config updates, detection does not take it
   std::mutex aruco_mutex_;
 };
 
@@ -37,7 +37,13 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
+#include <functional>
+#include <limits>
+#include <memory>
 #include <mutex>
+#include <type_traits>
+#include <unordered_map>
 // Eigen/Dense should be included before opencv stuff
 // https://stackoverflow.com/questions/9876209/using-eigen-library-with-opencv-2-3-1
 #include <Eigen/Dense>
@@ -80,6 +86,9 @@ public:
       std::size_t e;
     } value_;
     const std::vector<std::string> enum_values_;
+    // Values accepted by setParameter for Int and Float parameters
+    double min_value_ = -std::numeric_limits<double>::infinity();
+    double max_value_ = std::numeric_limits<double>::infinity();
 
     Parameter(std::string name, ParameterType parameter_type, int default_value = 0)
       : name_(name), parameter_type_(parameter_type)
@@ -120,22 +129,101 @@ public:
       else
         RCLCPP_ERROR(LOGGER_CALIBRATION_TARGET, "Invalid default option for enum parameter %s", name.c_str());
     }
+
+    /**
+     * @brief Restrict the values of an Int or Float parameter to [min_value, max_value].
+     * @return This parameter, so the range can be given where the parameter is added.
+     */
+    Parameter& setRange(double min_value, double max_value = std::numeric_limits<double>::infinity())
+    {
+      min_value_ = min_value;
+      max_value_ = max_value;
+      return *this;
+    }
+
+    bool isInRange(double value) const
+    {
+      return min_value_ <= value && value <= max_value_;
+    }
+  };
+
+  /**
+   * @class ParameterHandle
+   * @brief Index of a target parameter, resolved once by name, to get and set the parameter without name lookups.
+   * The value type T is int for Int parameters, double for Float parameters and std::string for Enum parameters.
+   */
+  template <typename T>
+  class ParameterHandle
+  {
+  public:
+    bool isValid() const
+    {
+      return index_ != INVALID_INDEX;
+    }
+
+  private:
+    friend class HandEyeTargetBase;
+    static constexpr std::size_t INVALID_INDEX = std::numeric_limits<std::size_t>::max();
+    std::size_t index_ = INVALID_INDEX;
   };
 
+  // Called with the changed parameter whenever setParameter changes a parameter value
+  using ParameterCallback = std::function<void(const Parameter&)>;
+
   rclcpp::Clock clock;
   const std::size_t CAMERA_MATRIX_VECTOR_DIMENSION = 9;  // 3x3 camera intrinsic matrix
   const std::size_t CAMERA_MATRIX_WIDTH = 3;
   const std::size_t CAMERA_MATRIX_HEIGHT = 3;
-  const std::map<std::string, std::size_t> CAMERA_DISTORTION_MODELS_VECTOR_DIMENSIONS = { { "none", 0 },
-                                                                                          { "plumb_bob", 5 },
-                                                                                          { "rational_polynomial",
-                                                                                            8 } };
+  const std::map<std::string, std::size_t> CAMERA_DISTORTION_MODELS_VECTOR_DIMENSIONS = {
+    { "none", 0 }, { "plumb_bob", 5 }, { "rational_polynomial", 8 }, { "equidistant", 4 }, { "fisheye", 4 }
+  };
+
+  /**
+   * @brief Check for the equidistant fisheye model of cv::fisheye, with coefficients (k1, k2, k3, k4). Drivers name it
+   * "equidistant" or "fisheye".
+   */
+  static bool isFisheyeDistortionModel(const std::string& distortion_model)
+  {
+    return distortion_model == "equidistant" || distortion_model == "fisheye";
+  }
+
+  /**
+   * @brief Camera matrix and distortion coefficients of one camera info message. Published as an immutable snapshot,
+   * so detection can read it without taking base_mutex_.
+   */
+  struct CameraIntrinsics
+  {
+    // 3x3 floating-point camera matrix
+    //     [fx  0 cx]
+    // K = [ 0 fy cy]
+    //     [ 0  0  1]
+    cv::Mat camera_matrix;
+
+    // Vector of distortion coefficients, (k1, k2, t1, t2, k3) of the `plumb_bob` model, eight for
+    // `rational_polynomial` or (k1, k2, k3, k4) of the fisheye model
+    cv::Mat distortion_coeffs;
+
+    // Image size of the camera info message, empty if it has none
+    cv::Size image_size;
+
+    // Equidistant fisheye distortion, which the OpenCV pose estimation cannot model, so detection needs the remap
+    // tables
+    bool fisheye = false;
+
+    // Fixed-point remap tables to the undistorted image, which keeps camera_matrix. Empty unless image undistortion
+    // is enabled and the camera has distortion.
+    cv::Mat undistort_map1;
+    cv::Mat undistort_map2;
+  };
+  using CameraIntrinsicsConstPtr = std::shared_ptr<const CameraIntrinsics>;
 
   virtual ~HandEyeTargetBase() = default;
-  HandEyeTargetBase()
+  HandEyeTargetBase() : undistort_image_(false)
   {
-    camera_matrix_ = cv::Mat::eye(3, 3, CV_64F);
-    distortion_coeffs_ = cv::Mat::zeros(5, 1, CV_64F);
+    CameraIntrinsics intrinsics;
+    intrinsics.camera_matrix = cv::Mat::eye(3, 3, CV_64F);
+    intrinsics.distortion_coeffs = cv::Mat::zeros(5, 1, CV_64F);
+    camera_intrinsics_ = std::make_shared<const CameraIntrinsics>(std::move(intrinsics));
   }
 
   /**
@@ -151,6 +239,17 @@ public:
    */
   virtual bool createTargetImage(cv::Mat& image) const = 0;
 
+  /**
+   * @brief Get the map from the target frame to the pixels of the image created by createTargetImage, e.g. for
+   * rendering the target into synthetic camera views. A point (x, y, 0) of the target plane, in meters, is drawn at
+   * pixel target_to_image * (x, y, 1).
+   * @return True if the target provides the map, false otherwise.
+   */
+  virtual bool getTargetImageTransform(cv::Matx23d& /*target_to_image*/) const
+  {
+    return false;
+  }
+
   /**
    * @brief Given an image containing a target captured from a camera view point, get the target pose with respect to
    * the camera optical frame. Target parameters and camera intrinsic parameters should be correctly set
@@ -166,9 +265,22 @@ public:
    * @return A `TransformStamped` message.
    */
   virtual geometry_msgs::msg::TransformStamped getTransformStamped(const std::string& frame_id) const
+  {
+    return getTransformStamped(frame_id, rclcpp::Clock(RCL_ROS_TIME).now());
+  }
+
+  /**
+   * @brief Get `TransformStamped` message from the target detection result, stamped with the capture time of the
+   * image the target was detected in, so it can be matched with the robot pose at that time.
+   * @param frame_id The name of the frame this transform is with respect to.
+   * @param stamp The header stamp of the detection image.
+   * @return A `TransformStamped` message.
+   */
+  virtual geometry_msgs::msg::TransformStamped getTransformStamped(const std::string& frame_id,
+                                                                   const rclcpp::Time& stamp) const
   {
     geometry_msgs::msg::TransformStamped transform_stamped;
-    transform_stamped.header.stamp = rclcpp::Clock(RCL_ROS_TIME).now();  // Not sure if this is the right approach
+    transform_stamped.header.stamp = stamp;
     transform_stamped.header.frame_id = frame_id;
     transform_stamped.child_frame_id = "handeye_target";
 
@@ -178,6 +290,23 @@ public:
     return transform_stamped;
   }
 
+  /**
+   * @brief Marker count and pose fit of the last successful target detection.
+   */
+  struct DetectionInfo
+  {
+    std::size_t num_markers = 0;   // Detected markers belonging to the target
+    double reprojection_rms = 0.;  // RMS distance of the detected corners from the reprojected target, in pixels
+  };
+
+  /**
+   * @brief Get the marker count and pose fit of the last successful detectTargetPose call.
+   */
+  virtual DetectionInfo getDetectionInfo() const
+  {
+    return detection_info_;
+  }
+
   // Convert cv::Vec3d rotation vector to geometry_msgs::msg::Quaternion
   geometry_msgs::msg::Quaternion convertToQuaternionROSMsg(const cv::Vec3d& input_rvect) const
   {
@@ -258,24 +387,40 @@ public:
       return false;
     }
 
-    std::lock_guard<std::mutex> base_lock(base_mutex_);
+    // Fisheye images are always undistorted before detection, with remap tables for the image size
+    const bool fisheye = isFisheyeDistortionModel(msg->distortion_model);
+    if (fisheye && (msg->width == 0 || msg->height == 0))
+    {
+      RCLCPP_ERROR(LOGGER_CALIBRATION_TARGET, "Camera info with '%s' distortion model needs the image size.",
+                   msg->distortion_model.c_str());
+      return false;
+    }
+
+    // Fill new matrices, detection may still be using the ones of the current snapshot
+    CameraIntrinsics intrinsics;
+    intrinsics.image_size = cv::Size(msg->width, msg->height);
+    intrinsics.fisheye = fisheye;
 
     // Store camera matrix info
+    intrinsics.camera_matrix = cv::Mat::eye(3, 3, CV_64F);
     for (size_t i = 0; i < CAMERA_MATRIX_WIDTH; i++)
     {
       for (size_t j = 0; j < CAMERA_MATRIX_HEIGHT; j++)
       {
-        camera_matrix_.at<double>(i, j) = msg->k[i * CAMERA_MATRIX_WIDTH + j];
+        intrinsics.camera_matrix.at<double>(i, j) = msg->k[i * CAMERA_MATRIX_WIDTH + j];
       }
     }
 
     // Store camera distortion info
-    distortion_coeffs_ = cv::Mat::zeros(camera_distortion_vector_dimension, 1, CV_64F);
+    intrinsics.distortion_coeffs = cv::Mat::zeros(camera_distortion_vector_dimension, 1, CV_64F);
     for (size_t i = 0; i < camera_distortion_vector_dimension; i++)
     {
-      distortion_coeffs_.at<double>(i, 0) = msg->d[i];
+      intrinsics.distortion_coeffs.at<double>(i, 0) = msg->d[i];
     }
 
+    std::lock_guard<std::mutex> base_lock(base_mutex_);
+    publishCameraIntrinsics(std::move(intrinsics));
+
     RCLCPP_DEBUG_STREAM(LOGGER_CALIBRATION_TARGET, "Set camera intrinsic parameter to: " << msg);
     return true;
   }
@@ -286,7 +431,38 @@ public:
    */
   virtual bool areIntrinsicsReasonable()
   {
-    return cv::norm(camera_matrix_) != 0. && cv::norm(camera_matrix_, cv::Mat::eye(3, 3, CV_64F)) != 0.;
+    const cv::Mat& camera_matrix = getCameraIntrinsics()->camera_matrix;
+    return cv::norm(camera_matrix) != 0. && cv::norm(camera_matrix, cv::Mat::eye(3, 3, CV_64F)) != 0.;
+  }
+
+  /**
+   * @brief Current camera intrinsics. The snapshot stays valid while held, even if new intrinsics are set.
+   */
+  CameraIntrinsicsConstPtr getCameraIntrinsics() const
+  {
+    return std::atomic_load(&camera_intrinsics_);
+  }
+
+  /**
+   * @brief Detect the target in an undistorted copy of the image instead of the raw image, which helps with strongly
+   * distorted wide-angle lenses. The remap tables are computed once from the camera info, when it or this setting
+   * changes, so the camera info must have the image size. Detection output images are undistorted too. Images of
+   * fisheye cameras are always undistorted.
+   * @param undistort_image True to undistort the images before detection, false to detect in the raw images.
+   */
+  void setUndistortImage(bool undistort_image)
+  {
+    std::lock_guard<std::mutex> base_lock(base_mutex_);
+    undistort_image_ = undistort_image;
+    publishCameraIntrinsics(*camera_intrinsics_);
+  }
+
+  /**
+   * @brief Whether the images are undistorted before detection.
+   */
+  bool getUndistortImage() const
+  {
+    return undistort_image_;
   }
 
   /**
@@ -298,21 +474,51 @@ public:
     return parameters_;
   }
 
+  /**
+   * @brief Resolve a target parameter by name, for repeated access through the returned handle.
+   * @return The parameter handle, which is invalid if there is no parameter of this name and value type.
+   */
+  template <typename T>
+  ParameterHandle<T> getParameterHandle(const std::string& name) const
+  {
+    ParameterHandle<T> handle;
+    const std::size_t index = findParameter(name);
+    if (index < parameters_.size() && hasValueType<T>(parameters_[index]))
+      handle.index_ = index;
+    return handle;
+  }
+
+  /**
+   * @brief Get target parameter value through a handle
+   * @return True if the handle is valid
+   */
+  template <typename T>
+  bool getParameter(const ParameterHandle<T>& handle, T& value) const
+  {
+    if (handle.index_ >= parameters_.size())
+      return false;
+    readValue(parameters_[handle.index_], value);
+    return true;
+  }
+
+  /**
+   * @brief Set target parameter value through a handle. Registered parameter callbacks are called if the value
+   * changes.
+   * @return True if the handle is valid and the value is within the range of the parameter
+   */
+  template <typename T>
+  bool setParameter(const ParameterHandle<T>& handle, const typename std::common_type<T>::type& value)
+  {
+    return handle.index_ < parameters_.size() && assignValue(parameters_[handle.index_], value);
+  }
+
   /**
    * @brief Set target parameter to integer value
    * @return True if successful setting parameter
    */
   virtual bool setParameter(std::string name, int value)
   {
-    for (auto& param : parameters_)
-    {
-      if (param.name_ == name && param.parameter_type_ == Parameter::Int)
-      {
-        param.value_.i = value;
-        return true;
-      }
-    }
-    return false;
+    return setParameter(getParameterHandle<int>(name), value);
   }
 
   /**
@@ -321,15 +527,7 @@ public:
    */
   virtual bool setParameter(std::string name, float value)
   {
-    for (auto& param : parameters_)
-    {
-      if (param.name_ == name && param.parameter_type_ == Parameter::Float)
-      {
-        param.value_.f = value;
-        return true;
-      }
-    }
-    return false;
+    return setParameter(getParameterHandle<double>(name), value);
   }
 
   /**
@@ -338,15 +536,7 @@ public:
    */
   virtual bool setParameter(std::string name, double value)
   {
-    for (auto& param : parameters_)
-    {
-      if (param.name_ == name && param.parameter_type_ == Parameter::Float)
-      {
-        param.value_.f = value;
-        return true;
-      }
-    }
-    return false;
+    return setParameter(getParameterHandle<double>(name), value);
   }
 
   /**
@@ -355,19 +545,7 @@ public:
    */
   virtual bool setParameter(std::string name, std::string value)
   {
-    for (auto& param : parameters_)
-    {
-      if (param.name_ == name && param.parameter_type_ == Parameter::Enum)
-      {
-        auto it = std::find(param.enum_values_.begin(), param.enum_values_.end(), value);
-        if (it != param.enum_values_.end())
-        {
-          param.value_.e = std::distance(param.enum_values_.begin(), it);
-          return true;
-        }
-      }
-    }
-    return false;
+    return setParameter(getParameterHandle<std::string>(name), value);
   }
 
   /**
@@ -376,15 +554,7 @@ public:
    */
   virtual bool getParameter(std::string name, int& value) const
   {
-    for (auto& param : parameters_)
-    {
-      if (param.name_ == name && param.parameter_type_ == Parameter::Int)
-      {
-        value = param.value_.i;
-        return true;
-      }
-    }
-    return false;
+    return getParameter(getParameterHandle<int>(name), value);
   }
 
   /**
@@ -393,15 +563,11 @@ public:
    */
   virtual bool getParameter(std::string name, float& value) const
   {
-    for (auto& param : parameters_)
-    {
-      if (param.name_ == name && param.parameter_type_ == Parameter::Float)
-      {
-        value = param.value_.f;
-        return true;
-      }
-    }
-    return false;
+    double double_value;
+    if (!getParameter(getParameterHandle<double>(name), double_value))
+      return false;
+    value = double_value;
+    return true;
   }
 
   /**
@@ -410,15 +576,7 @@ public:
    */
   virtual bool getParameter(std::string name, double& value) const
   {
-    for (auto& param : parameters_)
-    {
-      if (param.name_ == name && param.parameter_type_ == Parameter::Float)
-      {
-        value = param.value_.f;
-        return true;
-      }
-    }
-    return false;
+    return getParameter(getParameterHandle<double>(name), value);
   }
 
   /**
@@ -427,27 +585,138 @@ public:
    */
   virtual bool getParameter(std::string name, std::string& value) const
   {
-    for (auto& param : parameters_)
+    return getParameter(getParameterHandle<std::string>(name), value);
+  }
+
+  /**
+   * @brief Register a callback that is called whenever setParameter changes a parameter value, e.g. to initialize
+   * the target again only when needed.
+   * @return Id for removeParameterCallback.
+   */
+  std::size_t addParameterCallback(ParameterCallback callback)
+  {
+    parameter_callbacks_.emplace_back(next_parameter_callback_id_, std::move(callback));
+    return next_parameter_callback_id_++;
+  }
+
+  void removeParameterCallback(std::size_t id)
+  {
+    parameter_callbacks_.erase(std::remove_if(parameter_callbacks_.begin(), parameter_callbacks_.end(),
+                                              [id](const auto& callback) { return callback.first == id; }),
+                               parameter_callbacks_.end());
+  }
+
+protected:
+  /**
+   * @brief Add a parameter of this target, typically in the constructor of the target.
+   * @return Handle of the parameter, which is invalid if T does not match the parameter type or the name is taken.
+   */
+  template <typename T>
+  ParameterHandle<T> addParameter(const Parameter& param)
+  {
+    ParameterHandle<T> handle;
+    if (!hasValueType<T>(param) || findParameter(param.name_) < parameters_.size())
     {
-      if (param.name_ == name && param.parameter_type_ == Parameter::Enum)
-      {
-        value = param.enum_values_[param.value_.e];
+      RCLCPP_ERROR(LOGGER_CALIBRATION_TARGET, "Cannot add parameter %s", param.name_.c_str());
+      return handle;
+    }
+    handle.index_ = parameters_.size();
+    parameter_indices_[param.name_] = parameters_.size();
+    parameters_.push_back(param);
+    return handle;
+  }
+
+  /**
+   * @brief Undistort the image to detect in with the cached remap tables, if there are tables for its size.
+   * @param intrinsics Camera intrinsics snapshot of this detection.
+   * @param image Input image, replaced by the undistorted image.
+   * @param camera_matrix Set to the camera matrix of the image to detect in.
+   * @param distortion_coeffs Set to the distortion coefficients of the image to detect in, empty if undistorted.
+   * @return False if the target cannot be detected in the image, which is the case for fisheye intrinsics without remap
+   * tables for the image size.
+   */
+  bool undistortImage(const CameraIntrinsics& intrinsics, cv::Mat& image, cv::Mat& camera_matrix,
+                      cv::Mat& distortion_coeffs)
+  {
+    camera_matrix = intrinsics.camera_matrix;
+    distortion_coeffs = intrinsics.distortion_coeffs;
+    if (intrinsics.undistort_map1.empty() || image.size() != intrinsics.image_size)
+    {
+      if (!intrinsics.fisheye)
         return true;
-      }
+      RCLCPP_ERROR_STREAM_THROTTLE(LOGGER_CALIBRATION_TARGET, clock, LOG_THROTTLE_PERIOD,
+                                   "Image size " << image.size() << " does not match fisheye camera info size "
+                                                 << intrinsics.image_size);
+      return false;
     }
-    return false;
+
+    cv::Mat undistorted_image;
+    cv::remap(image, undistorted_image, intrinsics.undistort_map1, intrinsics.undistort_map2, cv::INTER_LINEAR);
+    image = undistorted_image;
+    distortion_coeffs = cv::Mat();
+    return true;
   }
 
-protected:
-  // 3x3 floating-point camera matrix
-  //     [fx  0 cx]
-  // K = [ 0 fy cy]
-  //     [ 0  0  1]
-  cv::Mat camera_matrix_;
+  /**
+   * @brief RMS distance, in pixels, of detected image points from their target points projected with the detected
+   * target pose.
+   */
+  double getReprojectionRms(const cv::Mat& camera_matrix, const cv::Mat& distortion_coeffs,
+                            const std::vector<cv::Point3f>& object_points,
+                            const std::vector<cv::Point2f>& image_points) const
+  {
+    if (object_points.empty() || object_points.size() != image_points.size())
+      return 0.;
+    std::vector<cv::Point2f> projected_points;
+    cv::projectPoints(object_points, rotation_vect_, translation_vect_, camera_matrix, distortion_coeffs,
+                      projected_points);
+    double sum = 0.;
+    for (std::size_t i = 0; i < image_points.size(); ++i)
+    {
+      const cv::Point2f error = image_points[i] - projected_points[i];
+      sum += error.dot(error);
+    }
+    return std::sqrt(sum / image_points.size());
+  }
+
+  /**
+   * @brief Map from the board frame to the pixels of an image drawn by the OpenCV board drawing functions. They fit the
+   * board extent into the image without the margins, keeping the aspect ratio and centering the board, and flip the
+   * y-axis, which points up in the board frame.
+   */
+  static cv::Matx23d getBoardDrawingTransform(const cv::Size& image_size, int margin, const cv::Point2d& board_min,
+                                              const cv::Point2d& board_max)
+  {
+    const double size_x = board_max.x - board_min.x;
+    const double size_y = board_max.y - board_min.y;
+    double cols = image_size.width - 2 * margin;
+    double rows = image_size.height - 2 * margin;
+    cv::Point2d offset(margin, margin);
+    if (size_x / cols > size_y / rows)
+    {
+      const int board_rows = int(size_y / (size_x / cols));
+      const int row_margin = (int(rows) - board_rows) / 2;
+      offset.y += row_margin;
+      rows -= 2 * row_margin;
+    }
+    else
+    {
+      const int board_cols = int(size_x / (size_y / rows));
+      const int col_margin = (int(cols) - board_cols) / 2;
+      offset.x += col_margin;
+      cols -= 2 * col_margin;
+    }
+    const double scale_x = cols / size_x;
+    const double scale_y = rows / size_y;
+    return cv::Matx23d(scale_x, 0., offset.x - scale_x * board_min.x,  //
+                       0., -scale_y, offset.y + scale_y * board_max.y);
+  }
 
-  // Vector of distortion coefficients (k1, k2, t1, t2, k3)
-  // Assume `plumb_bob` model
-  cv::Mat distortion_coeffs_;
+  // Camera intrinsics, replaced as a whole by setCameraIntrinsicParams. Read it with getCameraIntrinsics.
+  std::shared_ptr<const CameraIntrinsics> camera_intrinsics_;
+
+  // Whether camera_intrinsics_ has remap tables to undistort the images before detection
+  std::atomic<bool> undistort_image_;
 
   // flag to indicate if target parameter values are correctly defined
   bool target_params_ready_;
@@ -459,6 +728,132 @@ protected:
   cv::Vec3d translation_vect_;
   cv::Vec3d rotation_vect_;
 
+  // Marker count and pose fit of the last successful detection
+  DetectionInfo detection_info_;
+
+  // Serializes camera intrinsics updates, detection reads camera_intrinsics_ instead
   std::mutex base_mutex_;
+
+private:
+  /**
+   * @brief Build the remap tables of intrinsics if undistortion is enabled and publish it. Call with base_mutex_ held.
+   */
+  void publishCameraIntrinsics(CameraIntrinsics intrinsics)
+  {
+    intrinsics.undistort_map1.release();
+    intrinsics.undistort_map2.release();
+    if (intrinsics.fisheye && intrinsics.image_size.area() > 0)
+    {
+      cv::fisheye::initUndistortRectifyMap(intrinsics.camera_matrix, intrinsics.distortion_coeffs, cv::Mat(),
+                                           intrinsics.camera_matrix, intrinsics.image_size, CV_16SC2,
+                                           intrinsics.undistort_map1, intrinsics.undistort_map2);
+    }
+    else if (undistort_image_ && intrinsics.image_size.area() > 0 && !intrinsics.distortion_coeffs.empty() &&
+             cv::countNonZero(intrinsics.distortion_coeffs) > 0)
+    {
+      cv::initUndistortRectifyMap(intrinsics.camera_matrix, intrinsics.distortion_coeffs, cv::Mat(),
+                                  intrinsics.camera_matrix, intrinsics.image_size, CV_16SC2, intrinsics.undistort_map1,
+                                  intrinsics.undistort_map2);
+    }
+    std::atomic_store(&camera_intrinsics_, std::make_shared<const CameraIntrinsics>(std::move(intrinsics)));
+  }
+
+  // Index of a parameter in parameters_, or parameters_.size() if there is none of this name
+  std::size_t findParameter(const std::string& name) const
+  {
+    const auto it = parameter_indices_.find(name);
+    if (it != parameter_indices_.end() && it->second < parameters_.size() && parameters_[it->second].name_ == name)
+      return it->second;
+    // Parameters pushed into parameters_ directly are not indexed
+    for (std::size_t i = 0; i < parameters_.size(); ++i)
+    {
+      if (parameters_[i].name_ == name)
+        return i;
+    }
+    return parameters_.size();
+  }
+
+  template <typename T>
+  static bool hasValueType(const Parameter& param)
+  {
+    return (std::is_same<T, int>::value && param.parameter_type_ == Parameter::Int) ||
+           (std::is_same<T, double>::value && param.parameter_type_ == Parameter::Float) ||
+           (std::is_same<T, std::string>::value && param.parameter_type_ == Parameter::Enum);
+  }
+
+  static void readValue(const Parameter& param, int& value)
+  {
+    value = param.value_.i;
+  }
+
+  static void readValue(const Parameter& param, double& value)
+  {
+    value = param.value_.f;
+  }
+
+  static void readValue(const Parameter& param, std::string& value)
+  {
+    value = param.enum_values_[param.value_.e];
+  }
+
+  bool assignValue(Parameter& param, int value)
+  {
+    if (!param.isInRange(value))
+    {
+      RCLCPP_ERROR_THROTTLE(LOGGER_CALIBRATION_TARGET, clock, LOG_THROTTLE_PERIOD,
+                            "Value %d of parameter %s is outside of [%g, %g]", value, param.name_.c_str(),
+                            param.min_value_, param.max_value_);
+      return false;
+    }
+    if (param.value_.i != value)
+    {
+      param.value_.i = value;
+      notifyParameterChanged(param);
+    }
+    return true;
+  }
+
+  bool assignValue(Parameter& param, double value)
+  {
+    if (!param.isInRange(value))
+    {
+      RCLCPP_ERROR_THROTTLE(LOGGER_CALIBRATION_TARGET, clock, LOG_THROTTLE_PERIOD,
+                            "Value %g of parameter %s is outside of [%g, %g]", value, param.name_.c_str(),
+                            param.min_value_, param.max_value_);
+      return false;
+    }
+    if (param.value_.f != static_cast<float>(value))
+    {
+      param.value_.f = value;
+      notifyParameterChanged(param);
+    }
+    return true;
+  }
+
+  bool assignValue(Parameter& param, const std::string& value)
+  {
+    const auto it = std::find(param.enum_values_.begin(), param.enum_values_.end(), value);
+    if (it == param.enum_values_.end())
+      return false;
+    const std::size_t option = std::distance(param.enum_values_.begin(), it);
+    if (param.value_.e != option)
+    {
+      param.value_.e = option;
+      notifyParameterChanged(param);
+    }
+    return true;
+  }
+
+  void notifyParameterChanged(const Parameter& param) const
+  {
+    for (const auto& callback : parameter_callbacks_)
+      callback.second(param);
+  }
+
+  // Index of the parameters added by addParameter, by name
+  std::unordered_map<std::string, std::size_t> parameter_indices_;
+
+  std::vector<std::pair<std::size_t, ParameterCallback>> parameter_callbacks_;
+  std::size_t next_parameter_callback_id_ = 0;
 };
 }  // namespace moveit_handeye_calibration
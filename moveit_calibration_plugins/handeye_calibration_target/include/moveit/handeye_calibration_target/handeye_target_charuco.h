@@ -36,6 +36,7 @@
 
 #pragma once
 
+#include <memory>
 #include <vector>
 #include <moveit/handeye_calibration_target/handeye_target_base.h>
 
@@ -54,6 +55,8 @@ public:
 
   virtual bool createTargetImage(cv::Mat& image) const override;
 
+  virtual bool getTargetImageTransform(cv::Matx23d& target_to_image) const override;
+
   virtual bool detectTargetPose(cv::Mat& image) override;
 
 protected:
@@ -72,19 +75,59 @@ private:
     { "DICT_ARUCO_ORIGINAL", cv::aruco::DICT_ARUCO_ORIGINAL }
   };
 
-  // Target intrinsic params
-  int squares_x_;                                        // Number of squares along X axis
-  int squares_y_;                                        // Number of squares along Y axis
-  int marker_size_pixels_;                               // Marker size in pixels
-  int square_size_pixels_;                               // Checkerboard square size in pixels
-  int border_size_bits_;                                 // Marker border width, in bits
-  int margin_size_pixels_;                               // Margin of white pixels around entire board
-  cv::aruco::PREDEFINED_DICTIONARY_NAME dictionary_id_;  // Marker dictionary id
+  /**
+   * @brief Immutable snapshot of the target configuration. The setters publish a new snapshot, and detection works
+   * on the snapshot it loaded, so configuration changes and detection never wait for each other.
+   */
+  struct BoardConfig
+  {
+    // Target intrinsic params
+    int squares_x = 0;                                      // Number of squares along X axis
+    int squares_y = 0;                                      // Number of squares along Y axis
+    int marker_size_pixels = 0;                             // Marker size in pixels
+    int square_size_pixels = 0;                             // Checkerboard square size in pixels
+    int border_size_bits = 0;                               // Marker border width, in bits
+    int margin_size_pixels = 0;                             // Margin of white pixels around entire board
+    cv::aruco::PREDEFINED_DICTIONARY_NAME dictionary_id{};  // Marker dictionary id
+
+    // Target real dimensions in meters
+    double board_size_meters = 0.;   // Printed board size, longest dimension
+    double marker_size_meters = 0.;  // Printed marker size
+
+    // Detection objects, built from the params above once they are all set
+    cv::Ptr<cv::aruco::Dictionary> dictionary;
+    cv::Ptr<cv::aruco::CharucoBoard> board;
+    cv::Ptr<cv::aruco::DetectorParameters> detector_params;
+  };
+
+  std::shared_ptr<const BoardConfig> getBoardConfig() const
+  {
+    return std::atomic_load(&board_config_);
+  }
+
+  // Validate params and set them in a board config, without publishing it
+  bool fillTargetIntrinsicParams(BoardConfig& board_config, int squares_x, int squares_y, int marker_size_pixels,
+                                 int square_size_pixels, int border_size_bits, int margin_size_pixels,
+                                 const std::string& dictionary_id);
+  bool fillTargetDimension(BoardConfig& board_config, double board_size_meters, double marker_size_meters);
+
+  // Build the detection objects of a board config and publish it, call with charuco_mutex_ held
+  void publishBoardConfig(BoardConfig board_config);
+
+  std::shared_ptr<const BoardConfig> board_config_;
 
-  // Target real dimensions in meters
-  double board_size_meters_;   // Printed board size, longest dimension
-  double marker_size_meters_;  // Printed marker size
+  // Handles of the target parameters
+  ParameterHandle<int> squares_x_param_;
+  ParameterHandle<int> squares_y_param_;
+  ParameterHandle<int> marker_size_pixels_param_;
+  ParameterHandle<int> square_size_pixels_param_;
+  ParameterHandle<int> border_size_bits_param_;
+  ParameterHandle<int> margin_size_pixels_param_;
+  ParameterHandle<std::string> dictionary_param_;
+  ParameterHandle<double> board_size_meters_param_;
+  ParameterHandle<double> marker_size_meters_param_;
 
+  // Serializes board config updates, detection does not take it
   std::mutex charuco_mutex_;
 };
 
@@ -0,0 +1,104 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt Calibration contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#pragma once
+
+#include <moveit/handeye_calibration_target/handeye_target_base.h>
+
+namespace moveit_handeye_calibration
+{
+/**
+ * @brief Image effects of a rendered camera view.
+ */
+struct RenderOptions
+{
+  double blur_sigma = 0.;          // Standard deviation of the Gaussian blur, in pixels, 0 for no blur
+  double noise_stddev = 0.;        // Standard deviation of the Gaussian pixel noise, in gray levels
+  double gain = 1.;                // Brightness gain
+  double offset = 0.;              // Brightness offset, in gray levels
+  double gradient = 0.;            // Brightness change across the image, in gray levels, for uneven lighting
+  double gradient_direction = 0.;  // Direction of the brightness gradient in the image, in rad
+  int background = 128;            // Gray level around the target
+  unsigned int seed = 0;           // Seed of the pixel noise
+};
+
+/**
+ * @class HandEyeTargetRenderer
+ * @brief Renders a target into virtual camera views, by warping the image of createTargetImage.
+ * Every pixel of the view is traced to the target plane through the plumb_bob or fisheye camera model, so the views
+ * include the lens distortion of the camera.
+ */
+class HandEyeTargetRenderer
+{
+public:
+  /**
+   * @brief Prepare rendering a target, whose parameters must be initialized.
+   */
+  explicit HandEyeTargetRenderer(const HandEyeTargetBase& target);
+
+  /**
+   * @return True if the target provided its image and the map from the target frame to the image.
+   */
+  bool isValid() const;
+
+  /**
+   * @brief Get the target corners in the target frame, in meters, in the order of the image corners, starting at the
+   * top-left.
+   */
+  std::vector<cv::Point3d> getTargetCorners() const;
+
+  /**
+   * @brief Check that the target is in front of the camera and its corners are inside the image.
+   * @param border Smallest distance of the corners from the image border, in pixels.
+   */
+  bool isVisible(const sensor_msgs::msg::CameraInfo& camera_info, const Eigen::Isometry3d& object_wrt_sensor,
+                 double border = 0.) const;
+
+  /**
+   * @brief Render the target as seen by a camera.
+   * @param camera_info Camera size, intrinsics and plumb_bob or fisheye distortion.
+   * @param object_wrt_sensor Target pose with respect to the camera optical frame.
+   * @param options Image effects.
+   * @param image Rendered 8-bit grayscale image.
+   * @return False if the renderer is not valid or the camera info is incomplete.
+   */
+  bool render(const sensor_msgs::msg::CameraInfo& camera_info, const Eigen::Isometry3d& object_wrt_sensor,
+              const RenderOptions& options, cv::Mat& image) const;
+
+private:
+  cv::Mat target_image_;
+  cv::Matx33d target_to_image_;
+};
+
+}  // namespace moveit_handeye_calibration
@@ -0,0 +1,214 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt Calibration contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace moveit_handeye_calibration
+{
+/**
+ * @brief Latency of a traced stage over the buffered trace events, in seconds.
+ */
+struct TraceStatistics
+{
+  std::size_t count = 0;
+  double last = 0.;
+  double mean = 0.;
+  double p95 = 0.;
+  double max = 0.;
+};
+
+/**
+ * @class TraceBuffer
+ * @brief Ring buffer of the latest trace events, shared by the whole process.
+ * Recording takes a few atomic stores and never blocks, so trace points can stay in the image and solver callbacks.
+ * Every slot is guarded by a sequence number, so readers skip the slots being overwritten instead of locking them.
+ */
+class TraceBuffer
+{
+public:
+  static constexpr std::size_t CAPACITY = 4096;  // Number of buffered events, a power of two
+
+  static TraceBuffer& instance()
+  {
+    static TraceBuffer buffer;
+    return buffer;
+  }
+
+  void setEnabled(bool enabled)
+  {
+    enabled_.store(enabled, std::memory_order_relaxed);
+  }
+
+  bool isEnabled() const
+  {
+    return enabled_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Record a trace event.
+   * @param stage Name of the traced stage, which must outlive the buffer, e.g. a string literal.
+   * @param start_ns Start time of the stage on the steady clock, in nanoseconds.
+   * @param duration_ns Duration of the stage, in nanoseconds.
+   */
+  void record(const char* stage, std::int64_t start_ns, std::int64_t duration_ns)
+  {
+    const std::uint64_t index = head_.fetch_add(1, std::memory_order_relaxed);
+    Slot& slot = slots_[index & (CAPACITY - 1)];
+    slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.stage.store(stage, std::memory_order_relaxed);
+    slot.start_ns.store(start_ns, std::memory_order_relaxed);
+    slot.duration_ns.store(duration_ns, std::memory_order_relaxed);
+    slot.sequence.store(2 * index + 2, std::memory_order_release);
+  }
+
+  /**
+   * @brief Drop the buffered events from the statistics.
+   */
+  void clear()
+  {
+    first_index_.store(head_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Aggregate the latencies of the buffered events by stage.
+   */
+  std::map<std::string, TraceStatistics> getStatistics() const
+  {
+    struct Event
+    {
+      std::int64_t start_ns;
+      std::int64_t duration_ns;
+    };
+    std::map<std::string, std::vector<Event>> stage_events;
+    const std::uint64_t first_index = first_index_.load(std::memory_order_relaxed);
+    for (const Slot& slot : slots_)
+    {
+      const std::uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+      const char* stage = slot.stage.load(std::memory_order_relaxed);
+      const Event event{ slot.start_ns.load(std::memory_order_relaxed),
+                         slot.duration_ns.load(std::memory_order_relaxed) };
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (sequence == 0 || sequence % 2 || sequence / 2 - 1 < first_index || !stage ||
+          slot.sequence.load(std::memory_order_relaxed) != sequence)
+        continue;
+      stage_events[stage].push_back(event);
+    }
+
+    std::map<std::string, TraceStatistics> statistics;
+    for (auto& stage : stage_events)
+    {
+      std::vector<Event>& events = stage.second;
+      std::sort(events.begin(), events.end(),
+                [](const Event& a, const Event& b) { return a.duration_ns < b.duration_ns; });
+      TraceStatistics& stats = statistics[stage.first];
+      stats.count = events.size();
+      std::int64_t last_start_ns = events.front().start_ns;
+      for (const Event& event : events)
+      {
+        stats.mean += event.duration_ns * 1e-9 / events.size();
+        if (event.start_ns >= last_start_ns)
+        {
+          last_start_ns = event.start_ns;
+          stats.last = event.duration_ns * 1e-9;
+        }
+      }
+      stats.p95 = events[(events.size() - 1) * 95 / 100].duration_ns * 1e-9;
+      stats.max = events.back().duration_ns * 1e-9;
+    }
+    return statistics;
+  }
+
+private:
+  struct Slot
+  {
+    std::atomic<std::uint64_t> sequence{ 0 };  // Odd while written, 2 * (index + 1) once the event is complete
+    std::atomic<const char*> stage{ nullptr };
+    std::atomic<std::int64_t> start_ns{ 0 };
+    std::atomic<std::int64_t> duration_ns{ 0 };
+  };
+
+  TraceBuffer() = default;
+
+  std::atomic<bool> enabled_{ true };
+  std::atomic<std::uint64_t> head_{ 0 };
+  std::atomic<std::uint64_t> first_index_{ 0 };
+  std::array<Slot, CAPACITY> slots_;
+};
+
+/**
+ * @class ScopedTrace
+ * @brief Trace point recording the time from its construction to the end of its scope into the TraceBuffer.
+ */
+class ScopedTrace
+{
+public:
+  /**
+   * @param stage Name of the traced stage, which must outlive the buffer, e.g. a string literal.
+   */
+  explicit ScopedTrace(const char* stage) : stage_(stage), enabled_(TraceBuffer::instance().isEnabled())
+  {
+    if (enabled_)
+      start_ = std::chrono::steady_clock::now();
+  }
+
+  ~ScopedTrace()
+  {
+    if (!enabled_)
+      return;
+    const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    TraceBuffer::instance().record(
+        stage_, std::chrono::duration_cast<std::chrono::nanoseconds>(start_.time_since_epoch()).count(),
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - start_).count());
+  }
+
+  ScopedTrace(const ScopedTrace&) = delete;
+  ScopedTrace& operator=(const ScopedTrace&) = delete;
+
+private:
+  const char* stage_;
+  bool enabled_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+}  // namespace moveit_handeye_calibration
@@ -35,24 +35,30 @@
 /* Author: Yu Yan */
 
 #include <moveit/handeye_calibration_target/handeye_target_aruco.h>
+#include <moveit/handeye_calibration_target/handeye_trace.h>
 
 namespace moveit_handeye_calibration
 {
-HandEyeArucoTarget::HandEyeArucoTarget()
+HandEyeArucoTarget::HandEyeArucoTarget() : board_config_(std::make_shared<const BoardConfig>())
 {
-  parameters_.push_back(Parameter("markers, X", Parameter::ParameterType::Int, 3));
-  parameters_.push_back(Parameter("markers, Y", Parameter::ParameterType::Int, 4));
-  parameters_.push_back(Parameter("marker size (px)", Parameter::ParameterType::Int, 200));
-  parameters_.push_back(Parameter("marker separation (px)", Parameter::ParameterType::Int, 20));
-  parameters_.push_back(Parameter("marker border (bits)", Parameter::ParameterType::Int, 1));
+  markers_x_param_ = addParameter<int>(Parameter("markers, X", Parameter::ParameterType::Int, 3).setRange(1));
+  markers_y_param_ = addParameter<int>(Parameter("markers, Y", Parameter::ParameterType::Int, 4).setRange(1));
+  marker_size_param_ = addParameter<int>(Parameter("marker size (px)", Parameter::ParameterType::Int, 200).setRange(1));
+  separation_param_ =
+      addParameter<int>(Parameter("marker separation (px)", Parameter::ParameterType::Int, 20).setRange(1));
+  border_bits_param_ =
+      addParameter<int>(Parameter("marker border (bits)", Parameter::ParameterType::Int, 1).setRange(1));
   std::vector<std::string> dictionaries;
   for (const auto& kv : ARUCO_DICTIONARY)
   {
     dictionaries.push_back(kv.first);
   }
-  parameters_.push_back(Parameter("ArUco dictionary", Parameter::ParameterType::Enum, dictionaries, 1));
-  parameters_.push_back(Parameter("measured marker size (m)", Parameter::ParameterType::Float, 0.2));
-  parameters_.push_back(Parameter("measured separation (m)", Parameter::ParameterType::Float, 0.02));
+  dictionary_param_ =
+      addParameter<std::string>(Parameter("ArUco dictionary", Parameter::ParameterType::Enum, dictionaries, 1));
+  marker_measured_size_param_ =
+      addParameter<double>(Parameter("measured marker size (m)", Parameter::ParameterType::Float, 0.2).setRange(0.));
+  marker_measured_separation_param_ =
+      addParameter<double>(Parameter("measured separation (m)", Parameter::ParameterType::Float, 0.02).setRange(0.));
 }
 
 bool HandEyeArucoTarget::initialize()
@@ -63,26 +69,59 @@ bool HandEyeArucoTarget::initialize()
   int separation;
   int border_bits;
   std::string dictionary_id;
-  float marker_measured_size;
-  float marker_measured_separation;
-
-  target_params_ready_ =
-      getParameter("markers, X", markers_x) && getParameter("markers, Y", markers_y) &&
-      getParameter("marker size (px)", marker_size) && getParameter("marker separation (px)", separation) &&
-      getParameter("marker border (bits)", border_bits) && getParameter("ArUco dictionary", dictionary_id) &&
-      getParameter("measured marker size (m)", marker_measured_size) &&
-      getParameter("measured separation (m)", marker_measured_separation) &&
-      setTargetIntrinsicParams(markers_x, markers_y, marker_size, separation, border_bits, dictionary_id) &&
-      setTargetDimension(marker_measured_size, marker_measured_separation);
-
-  return target_params_ready_;
+  double marker_measured_size;
+  double marker_measured_separation;
+
+  target_params_ready_ = false;
+  if (!getParameter(markers_x_param_, markers_x) || !getParameter(markers_y_param_, markers_y) ||
+      !getParameter(marker_size_param_, marker_size) || !getParameter(separation_param_, separation) ||
+      !getParameter(border_bits_param_, border_bits) || !getParameter(dictionary_param_, dictionary_id) ||
+      !getParameter(marker_measured_size_param_, marker_measured_size) ||
+      !getParameter(marker_measured_separation_param_, marker_measured_separation))
+    return false;
+
+  // All params go into one snapshot, so detection never sees the new board layout with the old dimensions
+  std::lock_guard<std::mutex> aruco_lock(aruco_mutex_);
+  BoardConfig board_config = *board_config_;
+  if (!fillTargetIntrinsicParams(board_config, markers_x, markers_y, marker_size, separation, border_bits,
+                                 dictionary_id) ||
+      !fillTargetDimension(board_config, marker_measured_size, marker_measured_separation))
+    return false;
+  publishBoardConfig(std::move(board_config));
+
+  target_params_ready_ = true;
+  return true;
 }
 
 bool HandEyeArucoTarget::setTargetIntrinsicParams(int markers_x, int markers_y, int marker_size, int separation,
                                                   int border_bits, const std::string& dictionary_id)
 {
+  std::lock_guard<std::mutex> aruco_lock(aruco_mutex_);
+  BoardConfig board_config = *board_config_;
+  if (!fillTargetIntrinsicParams(board_config, markers_x, markers_y, marker_size, separation, border_bits,
+                                 dictionary_id))
+    return false;
+  publishBoardConfig(std::move(board_config));
+  return true;
+}
+
+bool HandEyeArucoTarget::setTargetDimension(double marker_measured_size, double marker_measured_separation)
+{
+  std::lock_guard<std::mutex> aruco_lock(aruco_mutex_);
+  BoardConfig board_config = *board_config_;
+  if (!fillTargetDimension(board_config, marker_measured_size, marker_measured_separation))
+    return false;
+  publishBoardConfig(std::move(board_config));
+  return true;
+}
+
+bool HandEyeArucoTarget::fillTargetIntrinsicParams(BoardConfig& board_config, int markers_x, int markers_y,
+                                                   int marker_size, int separation, int border_bits,
+                                                   const std::string& dictionary_id)
+{
+  const auto& it = ARUCO_DICTIONARY.find(dictionary_id);
   if (markers_x <= 0 || markers_y <= 0 || marker_size <= 0 || separation <= 0 || border_bits <= 0 ||
-      ARUCO_DICTIONARY.find(dictionary_id) == ARUCO_DICTIONARY.end())
+      it == ARUCO_DICTIONARY.end())
   {
     RCLCPP_ERROR_STREAM_THROTTLE(LOGGER_CALIBRATION_TARGET, clock, LOG_THROTTLE_PERIOD,
                                  "Invalid target intrinsic params.\n"
@@ -95,20 +134,17 @@ bool HandEyeArucoTarget::setTargetIntrinsicParams(int markers_x, int markers_y,
     return false;
   }
 
-  std::lock_guard<std::mutex> aruco_lock(aruco_mutex_);
-  markers_x_ = markers_x;
-  markers_y_ = markers_y;
-  marker_size_ = marker_size;
-  separation_ = separation;
-  border_bits_ = border_bits;
-
-  const auto& it = ARUCO_DICTIONARY.find(dictionary_id);
-  dictionary_id_ = it->second;
-
+  board_config.markers_x = markers_x;
+  board_config.markers_y = markers_y;
+  board_config.marker_size = marker_size;
+  board_config.separation = separation;
+  board_config.border_bits = border_bits;
+  board_config.dictionary_id = it->second;
   return true;
 }
 
-bool HandEyeArucoTarget::setTargetDimension(double marker_measured_size, double marker_measured_separation)
+bool HandEyeArucoTarget::fillTargetDimension(BoardConfig& board_config, double marker_measured_size,
+                                             double marker_measured_separation)
 {
   if (marker_measured_size <= 0 || marker_measured_separation <= 0)
   {
@@ -118,9 +154,8 @@ bool HandEyeArucoTarget::setTargetDimension(double marker_measured_size, double
     return false;
   }
 
-  std::lock_guard<std::mutex> aruco_lock(aruco_mutex_);
-  marker_size_real_ = marker_measured_size;
-  marker_separation_real_ = marker_measured_separation;
+  board_config.marker_size_real = marker_measured_size;
+  board_config.marker_separation_real = marker_measured_separation;
   RCLCPP_INFO_STREAM_THROTTLE(LOGGER_CALIBRATION_TARGET, clock, LOG_THROTTLE_PERIOD,
                               "Set target real dimensions: \n"
                                   << "marker_measured_size " << std::to_string(marker_measured_size) << "\n"
@@ -129,21 +164,44 @@ bool HandEyeArucoTarget::setTargetDimension(double marker_measured_size, double
   return true;
 }
 
+void HandEyeArucoTarget::publishBoardConfig(BoardConfig board_config)
+{
+  if (board_config.markers_x > 0 && board_config.marker_size_real > 0.)
+  {
+    board_config.dictionary = cv::aruco::getPredefinedDictionary(board_config.dictionary_id);
+    board_config.board =
+        cv::aruco::GridBoard::create(board_config.markers_x, board_config.markers_y, board_config.marker_size_real,
+                                     board_config.marker_separation_real, board_config.dictionary);
+    board_config.detector_params = cv::makePtr<cv::aruco::DetectorParameters>();
+#if CV_MAJOR_VERSION == 3 && CV_MINOR_VERSION == 2
+    board_config.detector_params->doCornerRefinement = true;
+#else
+    board_config.detector_params->cornerRefinementMethod = cv::aruco::CORNER_REFINE_NONE;
+#endif
+  }
+  std::atomic_store(&board_config_, std::make_shared<const BoardConfig>(std::move(board_config)));
+}
+
 bool HandEyeArucoTarget::createTargetImage(cv::Mat& image) const
 {
+  const std::shared_ptr<const BoardConfig> board_config = getBoardConfig();
+  const int markers_x = board_config->markers_x;
+  const int markers_y = board_config->markers_y;
+  const int marker_size = board_config->marker_size;
+  const int separation = board_config->separation;
   cv::Size image_size;
-  image_size.width = markers_x_ * (marker_size_ + separation_) - separation_ + 2 * separation_;
-  image_size.height = markers_y_ * (marker_size_ + separation_) - separation_ + 2 * separation_;
+  image_size.width = markers_x * (marker_size + separation) - separation + 2 * separation;
+  image_size.height = markers_y * (marker_size + separation) - separation + 2 * separation;
 
   try
   {
     // Create target
-    cv::Ptr<cv::aruco::Dictionary> dictionary = cv::aruco::getPredefinedDictionary(dictionary_id_);
+    cv::Ptr<cv::aruco::Dictionary> dictionary = cv::aruco::getPredefinedDictionary(board_config->dictionary_id);
     cv::Ptr<cv::aruco::GridBoard> board =
-        cv::aruco::GridBoard::create(markers_x_, markers_y_, float(marker_size_), float(separation_), dictionary);
+        cv::aruco::GridBoard::create(markers_x, markers_y, float(marker_size), float(separation), dictionary);
 
     // Create target image
-    board->draw(image_size, image, separation_, border_bits_);
+    board->draw(image_size, image, separation, board_config->border_bits);
   }
   catch (const cv::Exception& e)
   {
@@ -154,27 +212,50 @@ bool HandEyeArucoTarget::createTargetImage(cv::Mat& image) const
   return true;
 }
 
+bool HandEyeArucoTarget::getTargetImageTransform(cv::Matx23d& target_to_image) const
+{
+  if (!target_params_ready_)
+    return false;
+
+  // Same image size and margin as createTargetImage, with the marker corners of the board in meters
+  const std::shared_ptr<const BoardConfig> board_config = getBoardConfig();
+  const int markers_x = board_config->markers_x;
+  const int markers_y = board_config->markers_y;
+  const int marker_size = board_config->marker_size;
+  const int separation = board_config->separation;
+  const double marker_size_real = board_config->marker_size_real;
+  const double marker_separation_real = board_config->marker_separation_real;
+  cv::Size image_size;
+  image_size.width = markers_x * (marker_size + separation) - separation + 2 * separation;
+  image_size.height = markers_y * (marker_size + separation) - separation + 2 * separation;
+  const cv::Point2d board_max(markers_x * (marker_size_real + marker_separation_real) - marker_separation_real,
+                              markers_y * (marker_size_real + marker_separation_real) - marker_separation_real);
+  target_to_image = getBoardDrawingTransform(image_size, separation, cv::Point2d(0., 0.), board_max);
+  return true;
+}
+
 bool HandEyeArucoTarget::detectTargetPose(cv::Mat& image)
 {
-  std::lock_guard<std::mutex> base_lock(base_mutex_);
+  ScopedTrace trace("detectTargetPose");
+  // Snapshots of the board and the camera, which setters replace instead of modifying them
+  const std::shared_ptr<const BoardConfig> board_config = getBoardConfig();
+  const CameraIntrinsicsConstPtr intrinsics = getCameraIntrinsics();
+  if (!board_config->board)
+    return false;
+  const cv::Ptr<cv::aruco::GridBoard>& board = board_config->board;
   try
   {
-    // Detect aruco board
-    aruco_mutex_.lock();
-    cv::Ptr<cv::aruco::Dictionary> dictionary = cv::aruco::getPredefinedDictionary(dictionary_id_);
-    cv::Ptr<cv::aruco::GridBoard> board =
-        cv::aruco::GridBoard::create(markers_x_, markers_y_, marker_size_real_, marker_separation_real_, dictionary);
-    aruco_mutex_.unlock();
-    cv::Ptr<cv::aruco::DetectorParameters> params_ptr(new cv::aruco::DetectorParameters());
-#if CV_MAJOR_VERSION == 3 && CV_MINOR_VERSION == 2
-    params_ptr->doCornerRefinement = true;
-#else
-    params_ptr->cornerRefinementMethod = cv::aruco::CORNER_REFINE_NONE;
-#endif
+    // Undistort with the cached remap tables if enabled, the pose is estimated with the intrinsics of that image
+    cv::Mat camera_matrix;
+    cv::Mat distortion_coeffs;
+    if (!undistortImage(*intrinsics, image, camera_matrix, distortion_coeffs))
+      return false;
 
+    // Detect aruco board
     std::vector<int> marker_ids;
     std::vector<std::vector<cv::Point2f>> marker_corners;
-    cv::aruco::detectMarkers(image, dictionary, marker_corners, marker_ids, params_ptr);
+    cv::aruco::detectMarkers(image, board_config->dictionary, marker_corners, marker_ids,
+                             board_config->detector_params);
     if (marker_ids.empty())
     {
       RCLCPP_DEBUG_STREAM_THROTTLE(LOGGER_CALIBRATION_TARGET, clock, LOG_THROTTLE_PERIOD, "No aruco marker detected.");
@@ -183,11 +264,11 @@ bool HandEyeArucoTarget::detectTargetPose(cv::Mat& image)
 
     // Refine markers borders
     std::vector<std::vector<cv::Point2f>> rejected_corners;
-    cv::aruco::refineDetectedMarkers(image, board, marker_corners, marker_ids, rejected_corners, camera_matrix_,
-                                     distortion_coeffs_);
+    cv::aruco::refineDetectedMarkers(image, board, marker_corners, marker_ids, rejected_corners, camera_matrix,
+                                     distortion_coeffs);
 
     // Estimate aruco board pose
-    int valid = cv::aruco::estimatePoseBoard(marker_corners, marker_ids, board, camera_matrix_, distortion_coeffs_,
+    int valid = cv::aruco::estimatePoseBoard(marker_corners, marker_ids, board, camera_matrix, distortion_coeffs,
                                              rotation_vect_, translation_vect_);
 
     // Draw the markers and frame axis if at least one marker is detected
@@ -207,10 +288,18 @@ bool HandEyeArucoTarget::detectTargetPose(cv::Mat& image)
       return false;
     }
 
+    // Fit of the pose to the corners of the markers on the board
+    std::vector<cv::Point3f> object_points;
+    std::vector<cv::Point2f> image_points;
+    cv::aruco::getBoardObjectAndImagePoints(board, marker_corners, marker_ids, object_points, image_points);
+    detection_info_.num_markers = object_points.size() / 4;
+    detection_info_.reprojection_rms =
+        getReprojectionRms(camera_matrix, distortion_coeffs, object_points, image_points);
+
     cv::Mat image_rgb;
     cv::cvtColor(image, image_rgb, cv::COLOR_GRAY2RGB);
     cv::aruco::drawDetectedMarkers(image_rgb, marker_corners);
-    drawAxis(image_rgb, camera_matrix_, distortion_coeffs_, rotation_vect_, translation_vect_, 0.1);
+    drawAxis(image_rgb, camera_matrix, distortion_coeffs, rotation_vect_, translation_vect_, 0.1);
     image = image_rgb;
   }
   catch (const cv::Exception& e)
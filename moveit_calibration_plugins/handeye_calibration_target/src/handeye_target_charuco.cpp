@@ -35,25 +35,33 @@
 /* Author: Yu Yan, John Stechschulte */
 
 #include <moveit/handeye_calibration_target/handeye_target_charuco.h>
+#include <moveit/handeye_calibration_target/handeye_trace.h>
 
 namespace moveit_handeye_calibration
 {
-HandEyeCharucoTarget::HandEyeCharucoTarget()
+HandEyeCharucoTarget::HandEyeCharucoTarget() : board_config_(std::make_shared<const BoardConfig>())
 {
-  parameters_.push_back(Parameter("squares, X", Parameter::ParameterType::Int, 5));
-  parameters_.push_back(Parameter("squares, Y", Parameter::ParameterType::Int, 7));
-  parameters_.push_back(Parameter("marker size (px)", Parameter::ParameterType::Int, 50));
-  parameters_.push_back(Parameter("square size (px)", Parameter::ParameterType::Int, 80));
-  parameters_.push_back(Parameter("margin size (px)", Parameter::ParameterType::Int, 2));
-  parameters_.push_back(Parameter("marker border (bits)", Parameter::ParameterType::Int, 1));
+  squares_x_param_ = addParameter<int>(Parameter("squares, X", Parameter::ParameterType::Int, 5).setRange(1));
+  squares_y_param_ = addParameter<int>(Parameter("squares, Y", Parameter::ParameterType::Int, 7).setRange(1));
+  marker_size_pixels_param_ =
+      addParameter<int>(Parameter("marker size (px)", Parameter::ParameterType::Int, 50).setRange(1));
+  square_size_pixels_param_ =
+      addParameter<int>(Parameter("square size (px)", Parameter::ParameterType::Int, 80).setRange(1));
+  margin_size_pixels_param_ =
+      addParameter<int>(Parameter("margin size (px)", Parameter::ParameterType::Int, 2).setRange(0));
+  border_size_bits_param_ =
+      addParameter<int>(Parameter("marker border (bits)", Parameter::ParameterType::Int, 1).setRange(1));
   std::vector<std::string> dictionaries;
   for (const auto& kv : ARUCO_DICTIONARY)
   {
     dictionaries.push_back(kv.first);
   }
-  parameters_.push_back(Parameter("ArUco dictionary", Parameter::ParameterType::Enum, dictionaries, 1));
-  parameters_.push_back(Parameter("longest board side (m)", Parameter::ParameterType::Float, 0.56));
-  parameters_.push_back(Parameter("measured marker size (m)", Parameter::ParameterType::Float, 0.06));
+  dictionary_param_ =
+      addParameter<std::string>(Parameter("ArUco dictionary", Parameter::ParameterType::Enum, dictionaries, 1));
+  board_size_meters_param_ =
+      addParameter<double>(Parameter("longest board side (m)", Parameter::ParameterType::Float, 0.56).setRange(0.));
+  marker_size_meters_param_ =
+      addParameter<double>(Parameter("measured marker size (m)", Parameter::ParameterType::Float, 0.06).setRange(0.));
 }
 
 bool HandEyeCharucoTarget::initialize()
@@ -68,26 +76,61 @@ bool HandEyeCharucoTarget::initialize()
   double board_size_meters;
   double marker_size_meters;
 
-  target_params_ready_ =
-      getParameter("squares, X", squares_x) && getParameter("squares, Y", squares_y) &&
-      getParameter("marker size (px)", marker_size_pixels) && getParameter("square size (px)", square_size_pixels) &&
-      getParameter("marker border (bits)", border_size_bits) && getParameter("margin size (px)", margin_size_pixels) &&
-      getParameter("ArUco dictionary", dictionary_id) && getParameter("longest board side (m)", board_size_meters) &&
-      getParameter("measured marker size (m)", marker_size_meters) &&
-      setTargetIntrinsicParams(squares_x, squares_y, marker_size_pixels, square_size_pixels, border_size_bits,
-                               margin_size_pixels, dictionary_id) &&
-      setTargetDimension(board_size_meters, marker_size_meters);
-
-  return target_params_ready_;
+  target_params_ready_ = false;
+  if (!getParameter(squares_x_param_, squares_x) || !getParameter(squares_y_param_, squares_y) ||
+      !getParameter(marker_size_pixels_param_, marker_size_pixels) ||
+      !getParameter(square_size_pixels_param_, square_size_pixels) ||
+      !getParameter(border_size_bits_param_, border_size_bits) ||
+      !getParameter(margin_size_pixels_param_, margin_size_pixels) || !getParameter(dictionary_param_, dictionary_id) ||
+      !getParameter(board_size_meters_param_, board_size_meters) ||
+      !getParameter(marker_size_meters_param_, marker_size_meters))
+    return false;
+
+  // All params go into one snapshot, so detection never sees the new board layout with the old dimensions
+  std::lock_guard<std::mutex> charuco_lock(charuco_mutex_);
+  BoardConfig board_config = *board_config_;
+  if (!fillTargetIntrinsicParams(board_config, squares_x, squares_y, marker_size_pixels, square_size_pixels,
+                                 border_size_bits, margin_size_pixels, dictionary_id) ||
+      !fillTargetDimension(board_config, board_size_meters, marker_size_meters))
+    return false;
+  publishBoardConfig(std::move(board_config));
+
+  target_params_ready_ = true;
+  return true;
 }
 
 bool HandEyeCharucoTarget::setTargetIntrinsicParams(int squares_x, int squares_y, int marker_size_pixels,
                                                     int square_size_pixels, int border_size_bits,
                                                     int margin_size_pixels, const std::string& dictionary_id)
 {
+  std::lock_guard<std::mutex> charuco_lock(charuco_mutex_);
+  BoardConfig board_config = *board_config_;
+  if (!fillTargetIntrinsicParams(board_config, squares_x, squares_y, marker_size_pixels, square_size_pixels,
+                                 border_size_bits, margin_size_pixels, dictionary_id))
+    return false;
+  publishBoardConfig(std::move(board_config));
+  return true;
+}
+
+bool HandEyeCharucoTarget::setTargetDimension(double board_size_meters, double marker_size_meters)
+{
+  std::lock_guard<std::mutex> charuco_lock(charuco_mutex_);
+  BoardConfig board_config = *board_config_;
+  if (!fillTargetDimension(board_config, board_size_meters, marker_size_meters))
+    return false;
+  publishBoardConfig(std::move(board_config));
+  return true;
+}
+
+bool HandEyeCharucoTarget::fillTargetIntrinsicParams(BoardConfig& board_config, int squares_x, int squares_y,
+                                                     int marker_size_pixels, int square_size_pixels,
+                                                     int border_size_bits, int margin_size_pixels,
+                                                     const std::string& dictionary_id)
+{
+  const auto& it = ARUCO_DICTIONARY.find(dictionary_id);
   if (squares_x <= 0 || squares_y <= 0 || marker_size_pixels <= 0 || square_size_pixels <= 0 ||
       margin_size_pixels < 0 || border_size_bits <= 0 || square_size_pixels <= marker_size_pixels ||
-      0 == ARUCO_DICTIONARY.count(dictionary_id))
+      it == ARUCO_DICTIONARY.end())
   {
     RCLCPP_ERROR_STREAM_THROTTLE(LOGGER_CALIBRATION_TARGET, clock, LOG_THROTTLE_PERIOD,
                                  "Invalid target intrinsic params.\n"
@@ -101,25 +144,22 @@ bool HandEyeCharucoTarget::setTargetIntrinsicParams(int squares_x, int squares_y
     return false;
   }
 
-  std::lock_guard<std::mutex> charuco_lock(charuco_mutex_);
-  squares_x_ = squares_x;
-  squares_y_ = squares_y;
-  marker_size_pixels_ = marker_size_pixels;
-  square_size_pixels_ = square_size_pixels;
-  border_size_bits_ = border_size_bits;
-  margin_size_pixels_ = margin_size_pixels;
-
-  const auto& it = ARUCO_DICTIONARY.find(dictionary_id);
-  dictionary_id_ = it->second;
-
+  board_config.squares_x = squares_x;
+  board_config.squares_y = squares_y;
+  board_config.marker_size_pixels = marker_size_pixels;
+  board_config.square_size_pixels = square_size_pixels;
+  board_config.border_size_bits = border_size_bits;
+  board_config.margin_size_pixels = margin_size_pixels;
+  board_config.dictionary_id = it->second;
   return true;
 }
 
-bool HandEyeCharucoTarget::setTargetDimension(double board_size_meters, double marker_size_meters)
+bool HandEyeCharucoTarget::fillTargetDimension(BoardConfig& board_config, double board_size_meters,
+                                               double marker_size_meters)
 {
-  // Check for positive sizes and valid aspect ratio
+  // Check for positive sizes and valid aspect ratio, with the square counts of the given board config
   if (board_size_meters <= 0 || marker_size_meters <= 0 ||
-      board_size_meters < marker_size_meters * std::max(squares_x_, squares_y_))
+      board_size_meters < marker_size_meters * std::max(board_config.squares_x, board_config.squares_y))
   {
     RCLCPP_ERROR_THROTTLE(LOGGER_CALIBRATION_TARGET, clock, LOG_THROTTLE_PERIOD,
                           "Invalid target measured dimensions. Longest board dimension: %f. Marker size: %f",
@@ -127,34 +167,58 @@ bool HandEyeCharucoTarget::setTargetDimension(double board_size_meters, double m
     return false;
   }
 
-  std::lock_guard<std::mutex> charuco_lock(charuco_mutex_);
   RCLCPP_INFO_STREAM_THROTTLE(LOGGER_CALIBRATION_TARGET, clock, LOG_THROTTLE_PERIOD,
                               "Set target real dimensions: \n"
                                   << "board_size_meters " << std::to_string(board_size_meters) << "\n"
                                   << "marker_size_meters " << std::to_string(marker_size_meters) << "\n"
                                   << "\n");
-  board_size_meters_ = board_size_meters;
-  marker_size_meters_ = marker_size_meters;
+  board_config.board_size_meters = board_size_meters;
+  board_config.marker_size_meters = marker_size_meters;
   return true;
 }
 
+void HandEyeCharucoTarget::publishBoardConfig(BoardConfig board_config)
+{
+  if (board_config.squares_x > 0 && board_config.board_size_meters > 0.)
+  {
+    board_config.dictionary = cv::aruco::getPredefinedDictionary(board_config.dictionary_id);
+    const float square_size_meters =
+        board_config.board_size_meters / std::max(board_config.squares_x, board_config.squares_y);
+    board_config.board = cv::aruco::CharucoBoard::create(board_config.squares_x, board_config.squares_y,
+                                                         square_size_meters, board_config.marker_size_meters,
+                                                         board_config.dictionary);
+    board_config.detector_params = cv::makePtr<cv::aruco::DetectorParameters>();
+#if CV_MAJOR_VERSION == 3 && CV_MINOR_VERSION == 2
+    board_config.detector_params->doCornerRefinement = true;
+#else
+    board_config.detector_params->cornerRefinementMethod = cv::aruco::CORNER_REFINE_NONE;
+#endif
+  }
+  std::atomic_store(&board_config_, std::make_shared<const BoardConfig>(std::move(board_config)));
+}
+
 bool HandEyeCharucoTarget::createTargetImage(cv::Mat& image) const
 {
   if (!target_params_ready_)
     return false;
+  const std::shared_ptr<const BoardConfig> board_config = getBoardConfig();
+  const int squares_x = board_config->squares_x;
+  const int squares_y = board_config->squares_y;
+  const int square_size_pixels = board_config->square_size_pixels;
+  const int margin_size_pixels = board_config->margin_size_pixels;
   cv::Size image_size;
-  image_size.width = squares_x_ * square_size_pixels_ + 2 * margin_size_pixels_;
-  image_size.height = squares_y_ * square_size_pixels_ + 2 * margin_size_pixels_;
+  image_size.width = squares_x * square_size_pixels + 2 * margin_size_pixels;
+  image_size.height = squares_y * square_size_pixels + 2 * margin_size_pixels;
 
   try
   {
     // Create target
-    cv::Ptr<cv::aruco::Dictionary> dictionary = cv::aruco::getPredefinedDictionary(dictionary_id_);
+    cv::Ptr<cv::aruco::Dictionary> dictionary = cv::aruco::getPredefinedDictionary(board_config->dictionary_id);
     cv::Ptr<cv::aruco::CharucoBoard> board = cv::aruco::CharucoBoard::create(
-        squares_x_, squares_y_, float(square_size_pixels_), float(marker_size_pixels_), dictionary);
+        squares_x, squares_y, float(square_size_pixels), float(board_config->marker_size_pixels), dictionary);
 
     // Create target image
-    board->draw(image_size, image, margin_size_pixels_, border_size_bits_);
+    board->draw(image_size, image, margin_size_pixels, board_config->border_size_bits);
   }
   catch (const cv::Exception& e)
   {
@@ -165,34 +229,54 @@ bool HandEyeCharucoTarget::createTargetImage(cv::Mat& image) const
   return true;
 }
 
+bool HandEyeCharucoTarget::getTargetImageTransform(cv::Matx23d& target_to_image) const
+{
+  if (!target_params_ready_)
+    return false;
+
+  // Same image size and margin as createTargetImage, with the chessboard in meters
+  const std::shared_ptr<const BoardConfig> board_config = getBoardConfig();
+  const int squares_x = board_config->squares_x;
+  const int squares_y = board_config->squares_y;
+  const int square_size_pixels = board_config->square_size_pixels;
+  const int margin_size_pixels = board_config->margin_size_pixels;
+  cv::Size image_size;
+  image_size.width = squares_x * square_size_pixels + 2 * margin_size_pixels;
+  image_size.height = squares_y * square_size_pixels + 2 * margin_size_pixels;
+  const double square_size_meters = board_config->board_size_meters / std::max(squares_x, squares_y);
+  const cv::Point2d board_max(squares_x * square_size_meters, squares_y * square_size_meters);
+  target_to_image = getBoardDrawingTransform(image_size, margin_size_pixels, cv::Point2d(0., 0.), board_max);
+  return true;
+}
+
 bool HandEyeCharucoTarget::detectTargetPose(cv::Mat& image)
 {
+  ScopedTrace trace("detectTargetPose");
   if (!target_params_ready_)
     return false;
-  std::lock_guard<std::mutex> base_lock(base_mutex_);
+  // Snapshots of the board and the camera, which setters replace instead of modifying them
+  const std::shared_ptr<const BoardConfig> board_config = getBoardConfig();
+  const CameraIntrinsicsConstPtr intrinsics = getCameraIntrinsics();
+  if (!board_config->board)
+    return false;
+  const cv::Ptr<cv::aruco::CharucoBoard>& board = board_config->board;
   try
   {
-    // Detect aruco board
-    charuco_mutex_.lock();
-    cv::Ptr<cv::aruco::Dictionary> dictionary = cv::aruco::getPredefinedDictionary(dictionary_id_);
-    float square_size_meters = board_size_meters_ / std::max(squares_x_, squares_y_);
-    cv::Ptr<cv::aruco::CharucoBoard> board =
-        cv::aruco::CharucoBoard::create(squares_x_, squares_y_, square_size_meters, marker_size_meters_, dictionary);
-    charuco_mutex_.unlock();
-    cv::Ptr<cv::aruco::DetectorParameters> params_ptr(new cv::aruco::DetectorParameters());
-#if CV_MAJOR_VERSION == 3 && CV_MINOR_VERSION == 2
-    params_ptr->doCornerRefinement = true;
-#else
-    params_ptr->cornerRefinementMethod = cv::aruco::CORNER_REFINE_NONE;
-#endif
+    // Undistort with the cached remap tables if enabled, the pose is estimated with the intrinsics of that image
+    cv::Mat camera_matrix;
+    cv::Mat distortion_coeffs;
+    if (!undistortImage(*intrinsics, image, camera_matrix, distortion_coeffs))
+      return false;
 
+    // Detect aruco board
     std::vector<int> marker_ids;
     std::vector<std::vector<cv::Point2f>> marker_corners;
-    cv::aruco::detectMarkers(image, dictionary, marker_corners, marker_ids, params_ptr);
+    cv::aruco::detectMarkers(image, board_config->dictionary, marker_corners, marker_ids,
+                             board_config->detector_params);
     if (marker_ids.empty())
     {
       RCLCPP_DEBUG_STREAM_THROTTLE(LOGGER_CALIBRATION_TARGET, clock, 1,
-                                   "No aruco marker detected. Dictionary ID: " << dictionary_id_);
+                                   "No aruco marker detected. Dictionary ID: " << board_config->dictionary_id);
       return false;
     }
 
@@ -200,11 +284,11 @@ bool HandEyeCharucoTarget::detectTargetPose(cv::Mat& image)
     std::vector<cv::Point2f> charuco_corners;
     std::vector<int> charuco_ids;
     cv::aruco::interpolateCornersCharuco(marker_corners, marker_ids, image, board, charuco_corners, charuco_ids,
-                                         camera_matrix_, distortion_coeffs_);
+                                         camera_matrix, distortion_coeffs);
 
     // Estimate aruco board pose
-    bool valid = cv::aruco::estimatePoseCharucoBoard(charuco_corners, charuco_ids, board, camera_matrix_,
-                                                     distortion_coeffs_, rotation_vect_, translation_vect_);
+    bool valid = cv::aruco::estimatePoseCharucoBoard(charuco_corners, charuco_ids, board, camera_matrix,
+                                                     distortion_coeffs, rotation_vect_, translation_vect_);
 
     // Draw the markers and frame axis if at least one marker is detected
     if (!valid)
@@ -221,10 +305,20 @@ bool HandEyeCharucoTarget::detectTargetPose(cv::Mat& image)
       return false;
     }
 
+    // Fit of the pose to the interpolated chessboard corners
+    std::vector<cv::Point3f> object_points;
+    for (int id : charuco_ids)
+      object_points.push_back(board->chessboardCorners[id]);
+    detection_info_.num_markers = std::count_if(marker_ids.begin(), marker_ids.end(), [&board](int id) {
+      return id < static_cast<int>(board->ids.size());
+    });
+    detection_info_.reprojection_rms =
+        getReprojectionRms(camera_matrix, distortion_coeffs, object_points, charuco_corners);
+
     cv::Mat image_rgb;
     cv::cvtColor(image, image_rgb, cv::COLOR_GRAY2RGB);
     cv::aruco::drawDetectedMarkers(image_rgb, marker_corners);
-    drawAxis(image_rgb, camera_matrix_, distortion_coeffs_, rotation_vect_, translation_vect_, 0.1);
+    drawAxis(image_rgb, camera_matrix, distortion_coeffs, rotation_vect_, translation_vect_, 0.1);
     image = image_rgb;
   }
   catch (const cv::Exception& e)
@@ -0,0 +1,225 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt Calibration contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <moveit/handeye_calibration_target/handeye_target_renderer.h>
+
+namespace moveit_handeye_calibration
+{
+namespace
+{
+bool getCameraModel(const sensor_msgs::msg::CameraInfo& camera_info, cv::Mat& camera_matrix, cv::Mat& distortion,
+                    bool& fisheye)
+{
+  if (camera_info.width == 0 || camera_info.height == 0 || camera_info.k[0] <= 0 || camera_info.k[4] <= 0)
+    return false;
+  camera_matrix = cv::Mat(3, 3, CV_64F);
+  for (size_t i = 0; i < 9; ++i)
+    camera_matrix.at<double>(i / 3, i % 3) = camera_info.k[i];
+  fisheye = HandEyeTargetBase::isFisheyeDistortionModel(camera_info.distortion_model);
+  distortion = cv::Mat::zeros(1, fisheye ? 4 : 5, CV_64F);
+  for (size_t i = 0; i < std::min<size_t>(distortion.cols, camera_info.d.size()); ++i)
+    distortion.at<double>(0, i) = camera_info.d[i];
+  return true;
+}
+
+void getPose(const Eigen::Isometry3d& pose, cv::Matx33d& rotation, cv::Vec3d& translation)
+{
+  cv::eigen2cv(Eigen::Matrix3d(pose.rotation()), rotation);
+  cv::eigen2cv(Eigen::Vector3d(pose.translation()), translation);
+}
+}  // namespace
+
+HandEyeTargetRenderer::HandEyeTargetRenderer(const HandEyeTargetBase& target)
+{
+  cv::Matx23d target_to_image;
+  if (target.createTargetImage(target_image_) && target.getTargetImageTransform(target_to_image))
+  {
+    if (target_image_.channels() > 1)
+      cv::cvtColor(target_image_, target_image_, cv::COLOR_BGR2GRAY);
+    target_to_image_ = cv::Matx33d(target_to_image(0, 0), target_to_image(0, 1), target_to_image(0, 2),
+                                   target_to_image(1, 0), target_to_image(1, 1), target_to_image(1, 2),  //
+                                   0., 0., 1.);
+  }
+  else
+  {
+    target_image_.release();
+  }
+}
+
+bool HandEyeTargetRenderer::isValid() const
+{
+  return !target_image_.empty();
+}
+
+std::vector<cv::Point3d> HandEyeTargetRenderer::getTargetCorners() const
+{
+  std::vector<cv::Point3d> corners;
+  if (!isValid())
+    return corners;
+
+  const cv::Matx33d image_to_target = target_to_image_.inv();
+  const double cols = target_image_.cols;
+  const double rows = target_image_.rows;
+  for (const cv::Vec3d& pixel : { cv::Vec3d(0., 0., 1.), cv::Vec3d(cols, 0., 1.), cv::Vec3d(cols, rows, 1.),
+                                  cv::Vec3d(0., rows, 1.) })
+  {
+    const cv::Vec3d point = image_to_target * pixel;
+    corners.emplace_back(point[0], point[1], 0.);
+  }
+  return corners;
+}
+
+bool HandEyeTargetRenderer::isVisible(const sensor_msgs::msg::CameraInfo& camera_info,
+                                      const Eigen::Isometry3d& object_wrt_sensor, double border) const
+{
+  cv::Mat camera_matrix;
+  cv::Mat distortion;
+  bool fisheye;
+  if (!isValid() || !getCameraModel(camera_info, camera_matrix, distortion, fisheye))
+    return false;
+
+  const std::vector<cv::Point3d> corners = getTargetCorners();
+  for (const cv::Point3d& corner : corners)
+    if ((object_wrt_sensor * Eigen::Vector3d(corner.x, corner.y, corner.z)).z() <= 0.)
+      return false;
+
+  cv::Matx33d rotation;
+  cv::Vec3d translation;
+  getPose(object_wrt_sensor, rotation, translation);
+  cv::Vec3d rvec;
+  cv::Rodrigues(rotation, rvec);
+  std::vector<cv::Point2d> pixels;
+  if (fisheye)
+    cv::fisheye::projectPoints(corners, pixels, rvec, translation, camera_matrix, distortion);
+  else
+    cv::projectPoints(corners, rvec, translation, camera_matrix, distortion, pixels);
+  for (const cv::Point2d& pixel : pixels)
+    if (pixel.x < border || pixel.y < border || pixel.x > camera_info.width - border ||
+        pixel.y > camera_info.height - border)
+      return false;
+  return true;
+}
+
+bool HandEyeTargetRenderer::render(const sensor_msgs::msg::CameraInfo& camera_info,
+                                   const Eigen::Isometry3d& object_wrt_sensor, const RenderOptions& options,
+                                   cv::Mat& image) const
+{
+  cv::Mat camera_matrix;
+  cv::Mat distortion;
+  bool fisheye;
+  if (!isValid() || !getCameraModel(camera_info, camera_matrix, distortion, fisheye))
+    return false;
+
+  const int cols = camera_info.width;
+  const int rows = camera_info.height;
+
+  // Trace every pixel back to its ray in normalized camera coordinates, removing the lens distortion
+  cv::Mat pixels(rows * cols, 1, CV_32FC2);
+  for (int y = 0; y < rows; ++y)
+    for (int x = 0; x < cols; ++x)
+      pixels.at<cv::Vec2f>(y * cols + x) = cv::Vec2f(x, y);
+  cv::Mat rays;
+  if (fisheye)
+    cv::fisheye::undistortPoints(pixels, rays, camera_matrix, distortion);
+  else
+    cv::undistortPoints(pixels, rays, camera_matrix, distortion);
+
+  // The target plane z = 0 is seen through the homography [r1 r2 t], so a ray (x, y, 1) hits the target point
+  // (X, Y, 1) ~ [r1 r2 t]^-1 (x, y, 1), in front of the camera if the scale is positive
+  cv::Matx33d rotation;
+  cv::Vec3d translation;
+  getPose(object_wrt_sensor, rotation, translation);
+  const cv::Matx33d plane_to_camera(rotation(0, 0), rotation(0, 1), translation[0],  //
+                                    rotation(1, 0), rotation(1, 1), translation[1],  //
+                                    rotation(2, 0), rotation(2, 1), translation[2]);
+  if (std::abs(cv::determinant(plane_to_camera)) < std::numeric_limits<double>::epsilon())
+  {
+    // Target plane seen edge-on
+    image = cv::Mat(rows, cols, CV_8UC1, cv::Scalar(options.background));
+    return true;
+  }
+  const cv::Matx33d camera_to_image = target_to_image_ * plane_to_camera.inv();
+
+  cv::Mat map_x(rows, cols, CV_32FC1);
+  cv::Mat map_y(rows, cols, CV_32FC1);
+  for (int y = 0; y < rows; ++y)
+  {
+    float* map_x_row = map_x.ptr<float>(y);
+    float* map_y_row = map_y.ptr<float>(y);
+    for (int x = 0; x < cols; ++x)
+    {
+      const cv::Vec2f& ray = rays.at<cv::Vec2f>(y * cols + x);
+      const cv::Vec3d pixel = camera_to_image * cv::Vec3d(ray[0], ray[1], 1.);
+      if (pixel[2] > 0.)
+      {
+        map_x_row[x] = pixel[0] / pixel[2];
+        map_y_row[x] = pixel[1] / pixel[2];
+      }
+      else
+      {
+        map_x_row[x] = -1.f;
+        map_y_row[x] = -1.f;
+      }
+    }
+  }
+  cv::remap(target_image_, image, map_x, map_y, cv::INTER_LINEAR, cv::BORDER_CONSTANT, cv::Scalar(options.background));
+
+  // Optics first, then lighting, then sensor noise
+  cv::Mat image_float;
+  image.convertTo(image_float, CV_32FC1, options.gain, options.offset);
+  if (options.blur_sigma > 0.)
+    cv::GaussianBlur(image_float, image_float, cv::Size(), options.blur_sigma);
+  if (options.gradient != 0.)
+  {
+    const double dx = std::cos(options.gradient_direction) / std::max(cols, rows);
+    const double dy = std::sin(options.gradient_direction) / std::max(cols, rows);
+    for (int y = 0; y < rows; ++y)
+    {
+      float* row = image_float.ptr<float>(y);
+      for (int x = 0; x < cols; ++x)
+        row[x] += options.gradient * ((x - 0.5 * cols) * dx + (y - 0.5 * rows) * dy);
+    }
+  }
+  if (options.noise_stddev > 0.)
+  {
+    cv::Mat noise(rows, cols, CV_32FC1);
+    cv::RNG rng(options.seed);
+    rng.fill(noise, cv::RNG::NORMAL, 0., options.noise_stddev);
+    image_float += noise;
+  }
+  image_float.convertTo(image, CV_8UC1);
+  return true;
+}
+
+}  // namespace moveit_handeye_calibration
@@ -153,6 +153,47 @@ TEST_F(MoveItHandEyeTargetTester, DetectArucoMarkerPose)
   ASSERT_TRUE(ret.rotation().eulerAngles(0, 1, 2).isApprox(r, 0.01));
 }
 
+TEST_F(MoveItHandEyeTargetTester, ParameterHandles)
+{
+  using moveit_handeye_calibration::HandEyeTargetBase;
+  ASSERT_TRUE(target_);
+
+  const auto markers_x = target_->getParameterHandle<int>("markers, X");
+  const auto marker_size = target_->getParameterHandle<double>("measured marker size (m)");
+  const auto dictionary = target_->getParameterHandle<std::string>("ArUco dictionary");
+  ASSERT_TRUE(markers_x.isValid() && marker_size.isValid() && dictionary.isValid());
+  EXPECT_FALSE(target_->getParameterHandle<double>("markers, X").isValid());
+  EXPECT_FALSE(target_->getParameterHandle<int>("no such parameter").isValid());
+
+  std::vector<std::string> changed;
+  const std::size_t callback_id = target_->addParameterCallback(
+      [&changed](const HandEyeTargetBase::Parameter& param) { changed.push_back(param.name_); });
+
+  int int_value;
+  ASSERT_TRUE(target_->getParameter(markers_x, int_value));
+  EXPECT_EQ(int_value, 4);
+  EXPECT_TRUE(target_->setParameter(markers_x, 4));
+  EXPECT_TRUE(changed.empty());
+  EXPECT_TRUE(target_->setParameter(markers_x, 5));
+  ASSERT_TRUE(target_->getParameter("markers, X", int_value));
+  EXPECT_EQ(int_value, 5);
+
+  // Values outside of the parameter range are rejected
+  EXPECT_FALSE(target_->setParameter(markers_x, 0));
+  EXPECT_FALSE(target_->setParameter("measured marker size (m)", -0.1));
+  EXPECT_FALSE(target_->setParameter(dictionary, "DICT_3X3_0"));
+
+  double double_value;
+  EXPECT_TRUE(target_->setParameter(marker_size, 0.05));
+  ASSERT_TRUE(target_->getParameter(marker_size, double_value));
+  EXPECT_FLOAT_EQ(double_value, 0.05);
+
+  target_->removeParameterCallback(callback_id);
+  EXPECT_TRUE(target_->setParameter(markers_x, 4));
+  EXPECT_EQ(changed, (std::vector<std::string>{ "markers, X", "measured marker size (m)" }));
+  EXPECT_TRUE(target_->initialize());
+}
+
 int main(int argc, char** argv)
 {
   testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,321 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt Calibration contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <benchmark/benchmark.h>
+#include <moveit/handeye_calibration_target/handeye_target_aruco.h>
+#include <moveit/handeye_calibration_target/handeye_target_charuco.h>
+#include <moveit/handeye_calibration_target/handeye_target_renderer.h>
+
+#include "handeye_test_camera_info.h"
+
+namespace mhc = moveit_handeye_calibration;
+
+// Latency of the target detection on rendered images, over image resolution, ArUco dictionary and board
+// size. Run with --benchmark_out=<file> --benchmark_out_format=json to track the results.
+namespace
+{
+enum TargetType
+{
+  ARUCO = 0,
+  CHARUCO = 1,
+};
+
+// Stages of detectTargetPose. detectMarkers thresholds the image, finds the marker contours and decodes the marker
+// bits in one call, so the decoding time is that of STAGE_DETECT_MARKERS minus STAGE_THRESHOLD and STAGE_CONTOURS.
+enum Stage
+{
+  STAGE_THRESHOLD = 0,
+  STAGE_CONTOURS = 1,
+  STAGE_DETECT_MARKERS = 2,
+  STAGE_REFINE = 3,
+  STAGE_POSE = 4,
+  STAGE_DRAW = 5,
+};
+
+const std::vector<std::string> DICTIONARIES = { "DICT_4X4_250", "DICT_5X5_250", "DICT_6X6_250", "DICT_7X7_250" };
+const std::vector<cv::aruco::PREDEFINED_DICTIONARY_NAME> DICTIONARY_IDS = {
+  cv::aruco::DICT_4X4_250, cv::aruco::DICT_5X5_250, cv::aruco::DICT_6X6_250, cv::aruco::DICT_7X7_250
+};
+const std::vector<int64_t> IMAGE_WIDTHS = { 640, 1280, 1920, 3840 };
+const std::vector<int64_t> BOARD_SIZES = { 3, 5, 8 };
+
+const double MARKER_SIZE = 0.04;   // Measured marker size, in m
+const double SQUARE_SIZE = 0.06;   // Measured ChArUco square size, in m
+const double SEPARATION = 0.01;    // Measured ArUco marker separation, in m
+const double TARGET_FILL = 0.8;    // Fraction of the image height covered by the target
+const double TARGET_TILT = 0.3;    // Target rotation away from facing the camera, in rad
+
+/**
+ * @brief Target with board_size x (board_size + 1) markers or squares.
+ */
+std::unique_ptr<mhc::HandEyeTargetBase> createTarget(TargetType type, std::size_t dictionary, int board_size)
+{
+  std::unique_ptr<mhc::HandEyeTargetBase> target;
+  if (type == ARUCO)
+  {
+    target = std::make_unique<mhc::HandEyeArucoTarget>();
+    target->setParameter("markers, X", board_size);
+    target->setParameter("markers, Y", board_size + 1);
+    target->setParameter("marker size (px)", 200);
+    target->setParameter("marker separation (px)", 50);
+    target->setParameter("measured marker size (m)", MARKER_SIZE);
+    target->setParameter("measured separation (m)", SEPARATION);
+  }
+  else
+  {
+    target = std::make_unique<mhc::HandEyeCharucoTarget>();
+    target->setParameter("squares, X", board_size);
+    target->setParameter("squares, Y", board_size + 1);
+    target->setParameter("marker size (px)", 100);
+    target->setParameter("square size (px)", 150);
+    target->setParameter("margin size (px)", 50);
+    target->setParameter("longest board side (m)", SQUARE_SIZE * (board_size + 1));
+    target->setParameter("measured marker size (m)", MARKER_SIZE);
+  }
+  target->setParameter("marker border (bits)", 1);
+  target->setParameter("ArUco dictionary", DICTIONARIES[dictionary]);
+  if (!target->initialize())
+    return nullptr;
+  return target;
+}
+
+/**
+ * @brief Render the target slightly tilted into the center of a white camera image.
+ */
+cv::Mat renderImage(const mhc::HandEyeTargetBase& target, const sensor_msgs::msg::CameraInfo& camera_info)
+{
+  const mhc::HandEyeTargetRenderer renderer(target);
+  const std::vector<cv::Point3d> corners = renderer.getTargetCorners();
+  if (corners.empty())
+    return cv::Mat();
+
+  // Corners start at the top-left, so the bottom-right corner is opposite
+  const Eigen::Vector3d center(0.5 * (corners[0].x + corners[2].x), 0.5 * (corners[0].y + corners[2].y), 0.);
+  const double target_size = std::max(corners[2].x - corners[0].x, corners[0].y - corners[2].y);
+  const double distance = camera_info.k[4] * target_size / (TARGET_FILL * camera_info.height);
+  Eigen::Isometry3d object_wrt_sensor = Eigen::Isometry3d::Identity();
+  object_wrt_sensor.linear() = (Eigen::AngleAxisd(M_PI, Eigen::Vector3d::UnitX()) *
+                                Eigen::AngleAxisd(TARGET_TILT, Eigen::Vector3d::UnitY()))
+                                   .toRotationMatrix();
+  object_wrt_sensor.translation() = Eigen::Vector3d(0., 0., distance) - object_wrt_sensor.linear() * center;
+
+  mhc::RenderOptions options;
+  options.background = 255;
+  cv::Mat image;
+  renderer.render(camera_info, object_wrt_sensor, options, image);
+  return image;
+}
+
+std::string getLabel(TargetType type, std::size_t dictionary, int board_size)
+{
+  return std::string(type == ARUCO ? "Aruco " : "Charuco ") + DICTIONARIES[dictionary] + " " +
+         std::to_string(board_size) + "x" + std::to_string(board_size + 1);
+}
+
+/**
+ * @brief Whole detectTargetPose, with the image resolution, dictionary and board size as arguments.
+ */
+void BM_DetectTargetPose(benchmark::State& state, TargetType type)
+{
+  const int width = state.range(0);
+  const std::size_t dictionary = state.range(1);
+  const int board_size = state.range(2);
+  std::unique_ptr<mhc::HandEyeTargetBase> target = createTarget(type, dictionary, board_size);
+  auto camera_info = std::make_shared<sensor_msgs::msg::CameraInfo>(mhc::createPinholeCameraInfo(width, width * 3 / 4));
+  if (!target || !target->setCameraIntrinsicParams(camera_info))
+  {
+    state.SkipWithError("Failed to initialize the target");
+    return;
+  }
+  const cv::Mat image = renderImage(*target, *camera_info);
+
+  std::size_t detected = 0;
+  for (auto _ : state)
+  {
+    // The detection draws into the image
+    state.PauseTiming();
+    cv::Mat input = image.clone();
+    state.ResumeTiming();
+    detected += target->detectTargetPose(input);
+  }
+  state.counters["detection_rate"] = benchmark::Counter(detected, benchmark::Counter::kAvgIterations);
+  state.counters["megapixels"] = width * (width * 3 / 4) * 1e-6;
+  state.SetLabel(getLabel(type, dictionary, board_size));
+}
+
+/**
+ * @brief Single stage of detectTargetPose, with the same OpenCV calls and parameters as the targets use.
+ * The stage and the image resolution are arguments, the board has the default dictionary and 5x6 markers or squares.
+ */
+void BM_DetectionStage(benchmark::State& state, TargetType type)
+{
+  const Stage stage = static_cast<Stage>(state.range(0));
+  const int width = state.range(1);
+  const std::size_t dictionary = 0;
+  const int board_size = 5;
+  std::unique_ptr<mhc::HandEyeTargetBase> target = createTarget(type, dictionary, board_size);
+  auto camera_info = std::make_shared<sensor_msgs::msg::CameraInfo>(mhc::createPinholeCameraInfo(width, width * 3 / 4));
+  if (!target || !target->setCameraIntrinsicParams(camera_info))
+  {
+    state.SkipWithError("Failed to initialize the target");
+    return;
+  }
+  const cv::Mat image = renderImage(*target, *camera_info);
+  const cv::Mat camera_matrix = cv::Mat(3, 3, CV_64F, camera_info->k.data()).clone();
+  const cv::Mat distortion_coeffs = cv::Mat(camera_info->d).clone();
+
+  cv::Ptr<cv::aruco::Dictionary> aruco_dictionary = cv::aruco::getPredefinedDictionary(DICTIONARY_IDS[dictionary]);
+  cv::Ptr<cv::aruco::Board> board;
+  cv::Ptr<cv::aruco::CharucoBoard> charuco_board;
+  if (type == ARUCO)
+    board = cv::aruco::GridBoard::create(board_size, board_size + 1, MARKER_SIZE, SEPARATION, aruco_dictionary);
+  else
+    board = charuco_board =
+        cv::aruco::CharucoBoard::create(board_size, board_size + 1, SQUARE_SIZE, MARKER_SIZE, aruco_dictionary);
+  cv::Ptr<cv::aruco::DetectorParameters> params(new cv::aruco::DetectorParameters());
+#if CV_MAJOR_VERSION == 3 && CV_MINOR_VERSION == 2
+  params->doCornerRefinement = true;
+#else
+  params->cornerRefinementMethod = cv::aruco::CORNER_REFINE_NONE;
+#endif
+
+  // Inputs of the later stages
+  std::vector<int> marker_ids;
+  std::vector<std::vector<cv::Point2f>> marker_corners, rejected_corners;
+  cv::aruco::detectMarkers(image, aruco_dictionary, marker_corners, marker_ids, params);
+  if (marker_ids.empty())
+  {
+    state.SkipWithError("The target is not detected in the rendered image");
+    return;
+  }
+  std::vector<cv::Point2f> charuco_corners;
+  std::vector<int> charuco_ids;
+  if (type == CHARUCO)
+    cv::aruco::interpolateCornersCharuco(marker_corners, marker_ids, image, charuco_board, charuco_corners,
+                                         charuco_ids, camera_matrix, distortion_coeffs);
+  cv::Vec3d rotation_vect, translation_vect;
+  if (type == ARUCO)
+    cv::aruco::estimatePoseBoard(marker_corners, marker_ids, board, camera_matrix, distortion_coeffs, rotation_vect,
+                                 translation_vect);
+  else
+    cv::aruco::estimatePoseCharucoBoard(charuco_corners, charuco_ids, charuco_board, camera_matrix, distortion_coeffs,
+                                        rotation_vect, translation_vect);
+
+  // detectMarkers thresholds at every window size, rounded up to odd sizes
+  std::vector<int> windows;
+  for (int window = params->adaptiveThreshWinSizeMin; window <= params->adaptiveThreshWinSizeMax;
+       window += params->adaptiveThreshWinSizeStep)
+    windows.push_back(window | 1);
+  std::vector<cv::Mat> thresholded(windows.size());
+  for (std::size_t i = 0; i < windows.size(); ++i)
+    cv::adaptiveThreshold(image, thresholded[i], 255, cv::ADAPTIVE_THRESH_MEAN_C, cv::THRESH_BINARY_INV, windows[i],
+                          params->adaptiveThreshConstant);
+
+  for (auto _ : state)
+  {
+    switch (stage)
+    {
+      case STAGE_THRESHOLD:
+        for (std::size_t i = 0; i < windows.size(); ++i)
+          cv::adaptiveThreshold(image, thresholded[i], 255, cv::ADAPTIVE_THRESH_MEAN_C, cv::THRESH_BINARY_INV,
+                                windows[i], params->adaptiveThreshConstant);
+        break;
+      case STAGE_CONTOURS:
+        for (const cv::Mat& binary : thresholded)
+        {
+          std::vector<std::vector<cv::Point>> contours;
+          cv::findContours(binary.clone(), contours, cv::RETR_LIST, cv::CHAIN_APPROX_NONE);
+          benchmark::DoNotOptimize(contours.data());
+        }
+        break;
+      case STAGE_DETECT_MARKERS:
+      {
+        std::vector<int> ids;
+        std::vector<std::vector<cv::Point2f>> corners;
+        cv::aruco::detectMarkers(image, aruco_dictionary, corners, ids, params);
+        benchmark::DoNotOptimize(ids.data());
+        break;
+      }
+      case STAGE_REFINE:
+        if (type == ARUCO)
+        {
+          std::vector<int> ids = marker_ids;
+          std::vector<std::vector<cv::Point2f>> corners = marker_corners, rejected = rejected_corners;
+          cv::aruco::refineDetectedMarkers(image, board, corners, ids, rejected, camera_matrix, distortion_coeffs);
+        }
+        else
+        {
+          cv::aruco::interpolateCornersCharuco(marker_corners, marker_ids, image, charuco_board, charuco_corners,
+                                               charuco_ids, camera_matrix, distortion_coeffs);
+        }
+        break;
+      case STAGE_POSE:
+        if (type == ARUCO)
+          cv::aruco::estimatePoseBoard(marker_corners, marker_ids, board, camera_matrix, distortion_coeffs,
+                                       rotation_vect, translation_vect);
+        else
+          cv::aruco::estimatePoseCharucoBoard(charuco_corners, charuco_ids, charuco_board, camera_matrix,
+                                              distortion_coeffs, rotation_vect, translation_vect);
+        benchmark::DoNotOptimize(translation_vect);
+        break;
+      case STAGE_DRAW:
+      {
+        cv::Mat image_rgb;
+        cv::cvtColor(image, image_rgb, cv::COLOR_GRAY2RGB);
+        cv::aruco::drawDetectedMarkers(image_rgb, marker_corners);
+        target->drawAxis(image_rgb, camera_matrix, distortion_coeffs, rotation_vect, translation_vect, 0.1);
+        break;
+      }
+    }
+  }
+  static const std::vector<std::string> STAGE_NAMES = { "threshold", "contours", "detect markers",
+                                                        "refine",    "pose",     "draw" };
+  state.SetLabel(getLabel(type, dictionary, board_size) + " " + STAGE_NAMES[stage]);
+}
+}  // namespace
+
+BENCHMARK_CAPTURE(BM_DetectTargetPose, Aruco, ARUCO)
+    ->ArgsProduct({ IMAGE_WIDTHS, { 0, 1, 2, 3 }, BOARD_SIZES })
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_DetectTargetPose, Charuco, CHARUCO)
+    ->ArgsProduct({ IMAGE_WIDTHS, { 0, 1, 2, 3 }, BOARD_SIZES })
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_DetectionStage, Aruco, ARUCO)
+    ->ArgsProduct({ benchmark::CreateDenseRange(STAGE_THRESHOLD, STAGE_DRAW, 1), IMAGE_WIDTHS })
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DetectionStage, Charuco, CHARUCO)
+    ->ArgsProduct({ benchmark::CreateDenseRange(STAGE_THRESHOLD, STAGE_DRAW, 1), IMAGE_WIDTHS })
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,172 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt Calibration contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <gtest/gtest.h>
+#include <moveit/handeye_calibration_target/handeye_target_aruco.h>
+#include <moveit/handeye_calibration_target/handeye_target_charuco.h>
+#include <moveit/handeye_calibration_target/handeye_target_renderer.h>
+
+#include "handeye_test_camera_info.h"
+
+using namespace moveit_handeye_calibration;
+
+namespace
+{
+// Wide-angle camera with equidistant fisheye distortion
+sensor_msgs::msg::CameraInfo::SharedPtr createFisheyeCameraInfo()
+{
+  auto camera_info = std::make_shared<sensor_msgs::msg::CameraInfo>(createCameraInfo());
+  camera_info->distortion_model = "equidistant";
+  camera_info->d = std::vector<double>{ -0.0078, 0.0432, -0.0406, 0.0077 };
+  camera_info->k = std::array<double, 9>{ 285.7, 0.0, 320.5, 0.0, 285.8, 239.4, 0.0, 0.0, 1.0 };
+  camera_info->p = std::array<double, 12>{ 285.7, 0.0, 320.5, 0.0, 0.0, 285.8, 239.4, 0.0, 0.0, 0.0, 1.0, 0.0 };
+  return camera_info;
+}
+
+// Tilted target pose, with the target center on the optical axis at the given distance
+Eigen::Isometry3d getTargetPose(const HandEyeTargetRenderer& renderer, double distance)
+{
+  const std::vector<cv::Point3d> corners = renderer.getTargetCorners();
+  const Eigen::Vector3d center(0.5 * (corners[0].x + corners[2].x), 0.5 * (corners[0].y + corners[2].y), 0.);
+  Eigen::Isometry3d pose = Eigen::Isometry3d::Identity();
+  pose.linear() = (Eigen::AngleAxisd(M_PI, Eigen::Vector3d::UnitX()) *
+                   Eigen::AngleAxisd(0.3, Eigen::Vector3d::UnitY()) * Eigen::AngleAxisd(0.2, Eigen::Vector3d::UnitZ()))
+                      .toRotationMatrix();
+  pose.translation() = Eigen::Vector3d(0., 0., distance) - pose.linear() * center;
+  return pose;
+}
+
+void checkDetection(HandEyeTargetBase& target, double distance,
+                    const sensor_msgs::msg::CameraInfo::SharedPtr& camera_info =
+                        std::make_shared<sensor_msgs::msg::CameraInfo>(createCameraInfo()))
+{
+  ASSERT_TRUE(target.setCameraIntrinsicParams(camera_info));
+
+  HandEyeTargetRenderer renderer(target);
+  ASSERT_TRUE(renderer.isValid());
+  const Eigen::Isometry3d truth = getTargetPose(renderer, distance);
+  ASSERT_TRUE(renderer.isVisible(*camera_info, truth, 10.));
+
+  RenderOptions options;
+  options.blur_sigma = 0.7;
+  options.noise_stddev = 2.;
+  options.gradient = 40.;
+  cv::Mat image;
+  ASSERT_TRUE(renderer.render(*camera_info, truth, options, image));
+  ASSERT_EQ(image.cols, 640);
+  ASSERT_EQ(image.rows, 480);
+  ASSERT_TRUE(target.detectTargetPose(image));
+
+  const Eigen::Isometry3d detected = tf2::transformToEigen(target.getTransformStamped(camera_info->header.frame_id));
+  EXPECT_LT((detected.translation() - truth.translation()).norm(), 0.01 * distance);
+  EXPECT_LT(Eigen::AngleAxisd(detected.linear().transpose() * truth.linear()).angle(), 0.02);
+}
+}  // namespace
+
+TEST(HandEyeTargetRenderer, RenderArucoTarget)
+{
+  HandEyeArucoTarget target;
+  ASSERT_TRUE(target.setParameter("markers, X", 4));
+  ASSERT_TRUE(target.setParameter("markers, Y", 3));
+  ASSERT_TRUE(target.setParameter("marker size (px)", 200));
+  ASSERT_TRUE(target.setParameter("marker separation (px)", 20));
+  ASSERT_TRUE(target.setParameter("marker border (bits)", 1));
+  ASSERT_TRUE(target.setParameter("ArUco dictionary", "DICT_4X4_250"));
+  ASSERT_TRUE(target.setParameter("measured marker size (m)", 0.0256));
+  ASSERT_TRUE(target.setParameter("measured separation (m)", 0.0066));
+  ASSERT_TRUE(target.initialize());
+  checkDetection(target, 0.25);
+}
+
+TEST(HandEyeTargetRenderer, RenderCharucoTarget)
+{
+  HandEyeCharucoTarget target;
+  ASSERT_TRUE(target.initialize());
+  checkDetection(target, 1.);
+}
+
+TEST(HandEyeTargetRenderer, UndistortImage)
+{
+  HandEyeCharucoTarget target;
+  ASSERT_TRUE(target.initialize());
+  target.setUndistortImage(true);
+  EXPECT_TRUE(target.getUndistortImage());
+  checkDetection(target, 1.);
+  ASSERT_FALSE(target.getCameraIntrinsics()->undistort_map1.empty());
+
+  // Disabling drops the remap tables
+  target.setUndistortImage(false);
+  EXPECT_TRUE(target.getCameraIntrinsics()->undistort_map1.empty());
+}
+
+TEST(HandEyeTargetRenderer, FisheyeCamera)
+{
+  HandEyeCharucoTarget target;
+  ASSERT_TRUE(target.initialize());
+
+  // The remap tables need the image size
+  sensor_msgs::msg::CameraInfo::SharedPtr camera_info = createFisheyeCameraInfo();
+  camera_info->width = 0;
+  EXPECT_FALSE(target.setCameraIntrinsicParams(camera_info));
+
+  // Fisheye images are undistorted even if image undistortion is not enabled
+  checkDetection(target, 0.5, createFisheyeCameraInfo());
+  EXPECT_FALSE(target.getUndistortImage());
+  EXPECT_FALSE(target.getCameraIntrinsics()->undistort_map1.empty());
+}
+
+TEST(HandEyeTargetRenderer, TargetOutOfView)
+{
+  HandEyeCharucoTarget target;
+  ASSERT_TRUE(target.initialize());
+  const sensor_msgs::msg::CameraInfo camera_info = createCameraInfo();
+  HandEyeTargetRenderer renderer(target);
+  ASSERT_TRUE(renderer.isValid());
+
+  // Behind the camera
+  Eigen::Isometry3d pose = getTargetPose(renderer, -1.);
+  EXPECT_FALSE(renderer.isVisible(camera_info, pose));
+  cv::Mat image;
+  ASSERT_TRUE(renderer.render(camera_info, pose, RenderOptions(), image));
+  EXPECT_EQ(cv::countNonZero(image != 128), 0);
+
+  // Too close to fit into the image
+  EXPECT_FALSE(renderer.isVisible(camera_info, getTargetPose(renderer, 0.2)));
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
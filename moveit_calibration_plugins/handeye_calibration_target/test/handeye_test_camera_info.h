@@ -0,0 +1,77 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt Calibration contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#pragma once
+
+#include <sensor_msgs/msg/camera_info.hpp>
+
+// Camera models shared by the target and tools tests
+namespace moveit_handeye_calibration
+{
+/**
+ * @brief Calibrated 640x480 camera with plumb_bob distortion, in the "camera_color_optical_frame" frame.
+ */
+inline sensor_msgs::msg::CameraInfo createCameraInfo()
+{
+  sensor_msgs::msg::CameraInfo camera_info;
+  camera_info.height = 480;
+  camera_info.width = 640;
+  camera_info.header.frame_id = "camera_color_optical_frame";
+  camera_info.distortion_model = "plumb_bob";
+  camera_info.d = std::vector<double>{ 0.15405498, -0.24916842, 0.00350791, -0.00110041, 0.0 };
+  camera_info.k =
+      std::array<double, 9>{ 590.6972346, 0.0, 322.33104773, 0.0, 592.84676713, 247.40030325, 0.0, 0.0, 1.0 };
+  camera_info.r = std::array<double, 9>{ 1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0 };
+  camera_info.p = std::array<double, 12>{ 590.6972346,  0.0, 322.33104773, 0.0, 0.0, 592.84676713,
+                                          247.40030325, 0.0, 0.0,          0.0, 1.0, 0.0 };
+  return camera_info;
+}
+
+/**
+ * @brief Pinhole camera without distortion and with a horizontal field of view of about 53 degrees.
+ */
+inline sensor_msgs::msg::CameraInfo createPinholeCameraInfo(int width, int height)
+{
+  sensor_msgs::msg::CameraInfo camera_info;
+  camera_info.width = width;
+  camera_info.height = height;
+  camera_info.distortion_model = "plumb_bob";
+  camera_info.d = std::vector<double>(5, 0.);
+  camera_info.k = { double(width), 0., width / 2., 0., double(width), height / 2., 0., 0., 1. };
+  camera_info.r = { 1., 0., 0., 0., 1., 0., 0., 0., 1. };
+  camera_info.p = { double(width), 0., width / 2., 0., 0., double(width), height / 2., 0., 0., 0., 1., 0. };
+  return camera_info;
+}
+
+}  // namespace moveit_handeye_calibration
@@ -0,0 +1,115 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt Calibration contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <gtest/gtest.h>
+#include <moveit/handeye_calibration_target/handeye_trace.h>
+
+#include <thread>
+
+using namespace moveit_handeye_calibration;
+
+TEST(HandEyeTrace, Statistics)
+{
+  TraceBuffer& buffer = TraceBuffer::instance();
+  buffer.clear();
+  EXPECT_TRUE(buffer.getStatistics().empty());
+
+  for (int i = 1; i <= 100; ++i)
+    buffer.record("stage", i, i * 1000000);
+  buffer.record("other", 0, 5000000);
+
+  const std::map<std::string, TraceStatistics> statistics = buffer.getStatistics();
+  ASSERT_EQ(statistics.size(), 2u);
+  const TraceStatistics& stage = statistics.at("stage");
+  EXPECT_EQ(stage.count, 100u);
+  EXPECT_NEAR(stage.last, 0.1, 1e-12);
+  EXPECT_NEAR(stage.mean, 0.0505, 1e-12);
+  EXPECT_NEAR(stage.p95, 0.095, 1e-12);
+  EXPECT_NEAR(stage.max, 0.1, 1e-12);
+  EXPECT_EQ(statistics.at("other").count, 1u);
+
+  buffer.clear();
+  EXPECT_TRUE(buffer.getStatistics().empty());
+}
+
+TEST(HandEyeTrace, KeepsLatestEvents)
+{
+  TraceBuffer& buffer = TraceBuffer::instance();
+  buffer.clear();
+  for (std::size_t i = 0; i < 3 * TraceBuffer::CAPACITY; ++i)
+    buffer.record("stage", i, i < 2 * TraceBuffer::CAPACITY ? 1 : 2);
+
+  const TraceStatistics& stage = buffer.getStatistics().at("stage");
+  EXPECT_EQ(stage.count, TraceBuffer::CAPACITY);
+  EXPECT_NEAR(stage.mean, 2e-9, 1e-18);
+}
+
+TEST(HandEyeTrace, ScopedTrace)
+{
+  TraceBuffer& buffer = TraceBuffer::instance();
+  buffer.clear();
+  {
+    ScopedTrace trace("scope");
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  EXPECT_GE(buffer.getStatistics().at("scope").last, 0.01);
+
+  buffer.setEnabled(false);
+  {
+    ScopedTrace trace("disabled");
+  }
+  buffer.setEnabled(true);
+  EXPECT_EQ(buffer.getStatistics().count("disabled"), 0u);
+}
+
+TEST(HandEyeTrace, ConcurrentRecording)
+{
+  TraceBuffer& buffer = TraceBuffer::instance();
+  buffer.clear();
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t)
+    threads.emplace_back([]() {
+      for (int i = 0; i < 500; ++i)
+        ScopedTrace trace("thread");
+    });
+  for (std::thread& thread : threads)
+    thread.join();
+  EXPECT_EQ(buffer.getStatistics().at("thread").count, 2000u);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
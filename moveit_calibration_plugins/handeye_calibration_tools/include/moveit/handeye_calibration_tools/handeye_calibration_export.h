@@ -0,0 +1,95 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt Calibration contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#pragma once
+
+#include <sstream>
+#include <string>
+#include <moveit/handeye_calibration_solver/handeye_solver_uncertainty.h>
+
+namespace moveit_handeye_calibration
+{
+enum LaunchFormat
+{
+  LAUNCH_PYTHON = 0,
+  LAUNCH_XML = 1,
+  LAUNCH_YAML = 2,
+};
+
+/**
+ * @brief Check whether a string, e.g. a file name, ends with the given suffix.
+ */
+bool endsWith(const std::string& str, const std::string& suffix);
+
+/**
+ * @brief Get the launch script format from the file name extension, i.e. .py, .xml, or .yaml/.yml.
+ * @return False for an unknown extension.
+ */
+bool getLaunchFormat(const std::string& file_name, LaunchFormat& format);
+
+/**
+ * @brief Get the name of a camera mount type written to launch scripts, e.g. "EYE-TO-HAND".
+ */
+std::string getMountTypeName(SensorMountType setup);
+
+/**
+ * @brief Describe the standard deviations of a calibration, one line per quantity.
+ */
+std::string getUncertaintyText(const CalibrationUncertainty& uncertainty, const std::string& line_prefix);
+
+/**
+ * @brief Generate a ROS 2 launch script that publishes the calibration as static transform.
+ * @param from_frame Parent frame, i.e. the robot base (eye-to-hand) or end-effector (eye-in-hand).
+ * @param to_frame Child frame, i.e. the camera frame.
+ * @param pose Camera pose with respect to the parent frame.
+ * @param uncertainty If not null, the uncertainty is added as a comment.
+ */
+std::stringstream generateCalibrationLaunch(LaunchFormat format, const std::string& from_frame,
+                                            const std::string& to_frame, const Eigen::Isometry3d& pose,
+                                            SensorMountType setup,
+                                            const CalibrationUncertainty* uncertainty = nullptr);
+
+std::stringstream generateCalibrationPython(const std::string& from_frame, const std::string& to_frame,
+                                            const Eigen::Isometry3d& pose, SensorMountType setup,
+                                            const CalibrationUncertainty* uncertainty = nullptr);
+
+std::stringstream generateCalibrationXml(const std::string& from_frame, const std::string& to_frame,
+                                         const Eigen::Isometry3d& pose, SensorMountType setup,
+                                         const CalibrationUncertainty* uncertainty = nullptr);
+
+std::stringstream generateCalibrationYaml(const std::string& from_frame, const std::string& to_frame,
+                                          const Eigen::Isometry3d& pose, SensorMountType setup,
+                                          const CalibrationUncertainty* uncertainty = nullptr);
+
+}  // namespace moveit_handeye_calibration
@@ -0,0 +1,125 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt Calibration contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <string>
+
+#include <diagnostic_msgs/msg/diagnostic_status.hpp>
+
+namespace moveit_handeye_calibration
+{
+/**
+ * @brief Detection statistics of a camera. Frame counts are totals, the other values are over the latest processed
+ * frames.
+ */
+struct DetectionSummary
+{
+  std::size_t frames_received = 0;
+  std::size_t frames_processed = 0;  // Frames the detection ran on
+  std::size_t frames_skipped = 0;    // Received frames rejected before the detection, e.g. for a wrong encoding
+  std::size_t frames_dropped = 0;    // Frames missing between received frames, estimated from gaps in the stamps
+  std::size_t detections = 0;        // Processed frames with a detected target
+  double success_rate = 0.;          // Fraction of the latest processed frames with a detected target
+  double mean_markers = 0.;          // Mean marker count of the latest detections
+  double latency_p50 = 0.;           // Median detection latency, in s
+  double latency_p95 = 0.;           // 95th percentile of the detection latency, in s
+  double latency_max = 0.;           // Largest detection latency, in s
+  double residual_rms = 0.;          // RMS reprojection error of the latest detections, in pixels
+};
+
+/**
+ * @class HandEyeDetectionStatistics
+ * @brief Collects the target detection outcome of every camera frame, for monitoring cameras over time.
+ */
+class HandEyeDetectionStatistics
+{
+public:
+  // Default number of latest processed frames the rates, latencies and residuals are computed over
+  static constexpr std::size_t DEFAULT_WINDOW = 100;
+
+  explicit HandEyeDetectionStatistics(std::size_t window = DEFAULT_WINDOW);
+
+  /**
+   * @brief Count a received frame.
+   * @param stamp Capture time of the frame, in seconds, used to estimate the dropped frames.
+   */
+  void addReceivedFrame(double stamp);
+
+  /**
+   * @brief Count a received frame that is not processed.
+   */
+  void addSkippedFrame();
+
+  /**
+   * @brief Add the outcome of the detection on a received frame.
+   * @param detected True if the target was detected.
+   * @param latency Time taken by the detection, in s.
+   * @param num_markers Detected markers, only used if detected.
+   * @param reprojection_rms RMS reprojection error of the detected target, in pixels, only used if detected.
+   */
+  void addProcessedFrame(bool detected, double latency, std::size_t num_markers = 0, double reprojection_rms = 0.);
+
+  DetectionSummary getSummary() const;
+
+  void reset();
+
+private:
+  struct Frame
+  {
+    bool detected;
+    double latency;
+    std::size_t num_markers;
+    double reprojection_rms;
+  };
+
+  std::size_t window_;
+  std::deque<Frame> frames_;
+  DetectionSummary totals_;
+  double last_stamp_;
+  double frame_period_;  // Moving average of the regular frame intervals, 0 until known
+};
+
+/**
+ * @brief Get the detection statistics of a camera as diagnostic status, with a warning if the latest frames have no
+ * detection.
+ * @param name Name of the status.
+ * @param hardware_id Camera identifier, e.g. its optical frame.
+ */
+diagnostic_msgs::msg::DiagnosticStatus getDetectionDiagnostics(const DetectionSummary& summary, const std::string& name,
+                                                               const std::string& hardware_id);
+
+}  // namespace moveit_handeye_calibration
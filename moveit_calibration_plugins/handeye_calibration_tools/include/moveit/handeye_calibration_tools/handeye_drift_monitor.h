@@ -0,0 +1,142 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt Calibration contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#pragma once
+
+#include <moveit/handeye_calibration_solver/handeye_solver_base.h>
+
+namespace moveit_handeye_calibration
+{
+enum DriftLevel
+{
+  DRIFT_OK = 0,
+  DRIFT_WARN = 1,
+  DRIFT_ERROR = 2,
+};
+
+/**
+ * @brief Thresholds on the smoothed residuals, in meters and radians.
+ */
+struct DriftThresholds
+{
+  double translation_warn = 0.005;
+  double translation_error = 0.02;
+  double rotation_warn = 0.01;
+  double rotation_error = 0.035;
+};
+
+/**
+ * @brief Rolling statistics of a residual, as exponentially weighted moving mean and variance.
+ */
+struct DriftStatistics
+{
+  double last = 0.;
+  double mean = 0.;
+  double variance = 0.;
+  double max = 0.;
+};
+
+/**
+ * @class HandEyeDriftMonitor
+ * @brief Checks new calibration object observations against a stored calibration.
+ * The first observation is kept as reference, and every following observation is evaluated with the AX = XB
+ * reprojection error of the motion from the reference, so each update takes constant time and memory.
+ */
+class HandEyeDriftMonitor
+{
+public:
+  // Default weight of a new observation in the moving statistics
+  static constexpr double DEFAULT_SMOOTHING = 0.05;
+
+  /**
+   * @param camera_robot_pose The stored calibration, as returned by HandEyeSolverBase::getCameraRobotPose().
+   * @param setup Camera mount type, {EYE_TO_HAND, EYE_IN_HAND}.
+   * @param smoothing Weight of a new observation in the moving statistics, in (0, 1].
+   */
+  HandEyeDriftMonitor(const Eigen::Isometry3d& camera_robot_pose, SensorMountType setup,
+                      double smoothing = DEFAULT_SMOOTHING);
+
+  void setThresholds(const DriftThresholds& thresholds);
+
+  const DriftThresholds& getThresholds() const;
+
+  /**
+   * @brief Replace the stored calibration, which also resets the statistics.
+   */
+  void setCameraRobotPose(const Eigen::Isometry3d& camera_robot_pose);
+
+  /**
+   * @brief Forget the reference observation and the statistics.
+   */
+  void reset();
+
+  /**
+   * @brief Evaluate a new observation against the stored calibration and update the statistics.
+   * @param effector_wrt_world End-effector pose (4X4 transform) with respect to the world (or robot base).
+   * @param object_wrt_sensor Object (calibration board) pose (4X4 transform) with respect to the camera.
+   * @return The drift level after the update.
+   */
+  DriftLevel addObservation(const Eigen::Isometry3d& effector_wrt_world, const Eigen::Isometry3d& object_wrt_sensor);
+
+  DriftLevel getLevel() const;
+
+  /**
+   * @brief Number of observations evaluated against the reference, not counting the reference itself.
+   */
+  std::size_t getNumObservations() const;
+
+  const DriftStatistics& getTranslationStatistics() const;
+
+  const DriftStatistics& getRotationStatistics() const;
+
+private:
+  void updateStatistics(DriftStatistics& statistics, double value);
+
+  Eigen::Isometry3d camera_robot_pose_;
+  SensorMountType setup_;
+  double smoothing_;
+  DriftThresholds thresholds_;
+
+  // Reference observation in the first element, latest observation in the second
+  std::vector<Eigen::Isometry3d> effector_wrt_world_;
+  std::vector<Eigen::Isometry3d> object_wrt_sensor_;
+  bool has_reference_ = false;
+
+  std::size_t num_observations_ = 0;
+  DriftStatistics translation_;
+  DriftStatistics rotation_;
+  DriftLevel level_ = DRIFT_OK;
+};
+
+}  // namespace moveit_handeye_calibration
@@ -0,0 +1,124 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt Calibration contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#pragma once
+
+#include <vector>
+#include <Eigen/Geometry>
+#include <moveit/handeye_calibration_solver/handeye_solver_base.h>
+
+namespace moveit_handeye_calibration
+{
+/**
+ * @class NextPoseSelector
+ * @brief Scores candidate robot poses by how much they would reduce the uncertainty of an AX=XB calibration.
+ * The score is the D-optimal information gain, i.e. the increase of the log determinant of the information matrix
+ * of X when the motion pairs between the candidate and the current samples are added. Rotation and translation are
+ * treated as decoupled 3X3 blocks. Only robot poses are needed, since the camera motion B has the same rotation angle
+ * as the robot motion A.
+ */
+class NextPoseSelector
+{
+public:
+  /** @brief Weight of the prior information, which keeps the log determinant finite with few samples. */
+  static constexpr double PRIOR_INFORMATION = 1e-6;
+
+  /**
+   * @param setup Camera mount type, {EYE_TO_HAND, EYE_IN_HAND}.
+   * @param mode Motion pair mode of the solver that the samples will be used with.
+   */
+  NextPoseSelector(SensorMountType setup, MotionPairMode mode);
+
+  /**
+   * @brief Set the end-effector poses (with respect to the robot base) of the samples taken so far.
+   */
+  void setSamples(const std::vector<Eigen::Isometry3d>& effector_wrt_world);
+
+  /**
+   * @brief Get the information gain of taking the next sample at the candidate end-effector pose.
+   */
+  double getInformationGain(const Eigen::Isometry3d& candidate) const;
+
+  /**
+   * @brief Get the information gain of every candidate, evaluated on parallel threads.
+   * @param num_threads Number of threads, 0 for the hardware concurrency.
+   */
+  std::vector<double> getInformationGains(const std::vector<Eigen::Isometry3d>& candidates,
+                                          std::size_t num_threads = 0) const;
+
+  /**
+   * @brief Select the candidate with the largest information gain.
+   * @param gain If not null, set to the information gain of the selected candidate.
+   * @return Index of the selected candidate, or the number of candidates if there are none.
+   */
+  std::size_t selectNextPose(const std::vector<Eigen::Isometry3d>& candidates, double* gain = nullptr,
+                             std::size_t num_threads = 0) const;
+
+  /**
+   * @brief Get the log determinant of the information matrix of the current samples.
+   */
+  double getLogDeterminant() const;
+
+private:
+  void addMotion(const Eigen::Isometry3d& motion, Eigen::Matrix3d& rotation_information,
+                 Eigen::Matrix3d& translation_information) const;
+
+  double getLogDeterminant(const Eigen::Matrix3d& rotation_information,
+                           const Eigen::Matrix3d& translation_information) const;
+
+  SensorMountType setup_;
+  MotionPairMode mode_;
+  std::vector<Eigen::Isometry3d> effector_wrt_world_;
+  Eigen::Matrix3d rotation_information_;
+  Eigen::Matrix3d translation_information_;
+  double log_determinant_;
+};
+
+/**
+ * @brief Select which of the remaining recorded poses to visit after the ones that are already planned.
+ * The planned poses are counted as samples, since they are visited before the selected one.
+ * @param setup Camera mount type, {EYE_TO_HAND, EYE_IN_HAND}.
+ * @param mode Motion pair mode of the solver that the samples will be used with.
+ * @param samples End-effector poses of the samples taken so far.
+ * @param remaining End-effector poses of the recorded joint states that were not visited yet, in visiting order.
+ * @param first Number of remaining poses that are already planned.
+ * @param gain If not null, set to the information gain of the selected pose.
+ * @return Index in remaining of the pose to visit next, or first if there is no choice or no prior sample.
+ */
+std::size_t selectNextRecordedPose(SensorMountType setup, MotionPairMode mode,
+                                   const std::vector<Eigen::Isometry3d>& samples,
+                                   const std::vector<Eigen::Isometry3d>& remaining, std::size_t first,
+                                   double* gain = nullptr);
+
+}  // namespace moveit_handeye_calibration
@@ -0,0 +1,91 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt Calibration contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#pragma once
+
+#include <array>
+#include <unordered_map>
+#include <vector>
+#include <Eigen/Geometry>
+
+namespace moveit_handeye_calibration
+{
+/**
+ * @class RotationIndex
+ * @brief Finds whether a rotation is closer than a minimum angle to any stored rotation, in constant expected time.
+ * Rotations are stored as unit quaternions, bucketed in a 4D grid whose cell size is the largest quaternion distance
+ * within the minimum angle. A query only visits the 3^4 cells around the quaternion and around its negation.
+ */
+class RotationIndex
+{
+public:
+  /**
+   * @param min_angle Smallest allowed angle between two rotations, in radians.
+   */
+  explicit RotationIndex(double min_angle);
+
+  void insert(const Eigen::Matrix3d& rotation);
+
+  /**
+   * @brief Check whether a stored rotation is closer than the minimum angle to the given rotation.
+   */
+  bool hasNeighbor(const Eigen::Matrix3d& rotation) const;
+
+  /**
+   * @brief Remove the most recently inserted rotation.
+   */
+  void removeLast();
+
+  void clear();
+
+  std::size_t size() const;
+
+private:
+  typedef std::array<int, 4> CellKey;
+
+  struct CellKeyHash
+  {
+    std::size_t operator()(const CellKey& key) const;
+  };
+
+  CellKey getCellKey(const Eigen::Vector4d& quaternion) const;
+
+  double cell_size_;
+  double min_dot_;                           // Absolute quaternion dot product of two rotations at the minimum angle
+  std::vector<Eigen::Vector4d> quaternions_;  // Stored rotations, in insertion order
+  std::vector<CellKey> keys_;                 // Grid cell of each stored rotation
+  std::unordered_map<CellKey, std::vector<std::size_t>, CellKeyHash> cells_;
+};
+
+}  // namespace moveit_handeye_calibration
@@ -0,0 +1,149 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt Calibration contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <Eigen/Geometry>
+
+namespace moveit_handeye_calibration
+{
+/**
+ * @brief Calibration samples with their optional robot joint states and detection stamps.
+ * joint_states and stamps are either empty or hold one entry per sample.
+ */
+struct SampleSet
+{
+  std::vector<Eigen::Isometry3d> effector_wrt_world;
+  std::vector<Eigen::Isometry3d> object_wrt_sensor;
+  std::vector<std::string> joint_names;
+  std::vector<std::vector<double>> joint_states;
+  std::vector<double> stamps;  // Capture time of the object detection, in seconds
+};
+
+/**
+ * @brief Header of a binary sample file.
+ * The header is followed by the '\0' separated joint names padded to 8 bytes, the end-effector poses and the object
+ * poses as 4X4 row-major matrices, then the joint states and the stamps if their flags are set. All values are doubles
+ * in the byte order of the writing machine, aligned to 8 bytes, so the file can be used in place once it is mapped
+ * into memory. The byte order is recorded in the header, and files of the other byte order are rejected.
+ */
+struct SampleFileHeader
+{
+  static constexpr char MAGIC[8] = { 'M', 'H', 'C', 'S', 'A', 'M', 'P', '\0' };
+  static constexpr std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+  static constexpr std::uint32_t VERSION = 2;
+  static constexpr std::uint32_t HAS_JOINT_STATES = 1;
+  static constexpr std::uint32_t HAS_STAMPS = 2;
+
+  char magic[8];
+  std::uint32_t byte_order;  // BYTE_ORDER_MARK as written by the writing machine
+  std::uint32_t version;
+  std::uint32_t flags;
+  std::uint32_t num_joints;
+  std::uint64_t num_samples;
+  std::uint32_t joint_names_size;  // Size of the joint names, including padding, in bytes
+  std::uint32_t reserved;
+};
+
+/**
+ * @brief Write samples to a binary sample file.
+ * @return True on success, otherwise error_message is set.
+ */
+bool writeSampleFile(const std::string& file_name, const SampleSet& samples, std::string* error_message = nullptr);
+
+/**
+ * @brief Read samples from a binary sample file.
+ * @return True on success, otherwise error_message is set.
+ */
+bool readSampleFile(const std::string& file_name, SampleSet& samples, std::string* error_message = nullptr);
+
+/**
+ * @class MappedSampleFile
+ * @brief Read-only view of a binary sample file mapped into memory, without parsing or copying the samples.
+ */
+class MappedSampleFile
+{
+public:
+  typedef Eigen::Map<const Eigen::Matrix<double, 4, 4, Eigen::RowMajor>> MatrixMap;
+
+  MappedSampleFile() = default;
+  ~MappedSampleFile();
+  MappedSampleFile(const MappedSampleFile&) = delete;
+  MappedSampleFile& operator=(const MappedSampleFile&) = delete;
+
+  /**
+   * @brief Map a binary sample file and check its header and size.
+   * @return True on success, otherwise error_message is set.
+   */
+  bool open(const std::string& file_name, std::string* error_message = nullptr);
+
+  void close();
+
+  std::size_t size() const;
+
+  const std::vector<std::string>& getJointNames() const;
+
+  bool hasJointStates() const;
+
+  bool hasStamps() const;
+
+  MatrixMap getEffectorWrtWorld(std::size_t i) const;
+
+  MatrixMap getObjectWrtSensor(std::size_t i) const;
+
+  /**
+   * @return Pointer to the getJointNames().size() joint values of sample i, or null without joint states.
+   */
+  const double* getJointState(std::size_t i) const;
+
+  /**
+   * @return Stamp of sample i in seconds, or 0 without stamps.
+   */
+  double getStamp(std::size_t i) const;
+
+private:
+  void* data_ = nullptr;
+  std::size_t data_size_ = 0;
+  SampleFileHeader header_;
+  std::vector<std::string> joint_names_;
+  const double* effector_wrt_world_ = nullptr;
+  const double* object_wrt_sensor_ = nullptr;
+  const double* joint_states_ = nullptr;
+  const double* stamps_ = nullptr;
+};
+
+}  // namespace moveit_handeye_calibration
@@ -0,0 +1,104 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt Calibration contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#pragma once
+
+#include <string>
+#include <geometry_msgs/msg/transform_stamped.hpp>
+#include <tf2/buffer_core.h>
+
+namespace moveit_handeye_calibration
+{
+enum StreamStatus
+{
+  STREAM_NO_DETECTION = 0,   // No detection newer than the last processed one
+  STREAM_WAITING = 1,        // The robot state at the capture time of the detection was not received yet
+  STREAM_LOOKUP_FAILED = 2,  // A transform lookup failed, the detection is retried at the next poll
+  STREAM_FAST_MOTION = 3,    // The detection was captured during fast end-effector motion and is skipped
+  STREAM_NEW_SAMPLE = 4,     // The detection and the robot pose at its capture time form a new sample
+};
+
+struct SampleStreamFrames
+{
+  std::string sensor;
+  std::string object;
+  std::string base;
+  std::string effector;
+};
+
+struct SampleStreamLimits
+{
+  double velocity_window = 0.05;      // Time window for estimating the end-effector velocity, in s
+  double max_angular_velocity = 0.5;  // Fastest end-effector rotation of a streamed sample, in rad/s
+  double max_linear_velocity = 0.1;   // Fastest end-effector translation of a streamed sample, in m/s
+};
+
+/**
+ * @class SampleStreamFilter
+ * @brief Takes samples from the detections published to TF while the robot moves. A detection is only sampled if the
+ * robot pose at its capture time is known and the end-effector moved slowly enough for a sharp image and a small
+ * timing error.
+ */
+class SampleStreamFilter
+{
+public:
+  /**
+   * @brief Start streaming, with only the detections captured after the given time.
+   */
+  void start(const SampleStreamFrames& frames, const tf2::TimePoint& start_time,
+             const SampleStreamLimits& limits = SampleStreamLimits());
+
+  /**
+   * @brief Look up the latest detection and the end-effector pose at its capture time.
+   * A new sample is reported until it is marked as processed, a detection during fast motion is skipped at once.
+   * @param buffer TF buffer with the detections and the robot state.
+   * @param[out] camera_to_object Detected object pose with respect to the sensor.
+   * @param[out] base_to_eef End-effector pose with respect to the robot base at the capture time.
+   * @param[out] error_message Description of the error, if a lookup failed.
+   */
+  StreamStatus poll(const tf2::BufferCore& buffer, geometry_msgs::msg::TransformStamped& camera_to_object,
+                    geometry_msgs::msg::TransformStamped& base_to_eef, std::string* error_message = nullptr);
+
+  /**
+   * @brief Skip the detection of a sample returned by poll, once the sample was stored or rejected.
+   */
+  void markProcessed(const geometry_msgs::msg::TransformStamped& camera_to_object);
+
+private:
+  SampleStreamFrames frames_;
+  SampleStreamLimits limits_;
+  tf2::TimePoint last_stamp_;  // Capture time of the last processed detection
+};
+
+}  // namespace moveit_handeye_calibration
@@ -0,0 +1,127 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt Calibration contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#pragma once
+
+#include <moveit/handeye_calibration_tools/handeye_sample_file.h>
+
+#include <rclcpp/rclcpp.hpp>
+#include <sensor_msgs/msg/camera_info.hpp>
+#include <tf2/buffer_core.h>
+
+namespace rosbag2_cpp
+{
+class Writer;
+}
+
+namespace moveit_handeye_calibration
+{
+/**
+ * @class HandEyeSessionRecorder
+ * @brief Records the raw data of a calibration session, i.e. the camera images and info, the robot TF and the joint
+ * states, to a rosbag2 file, so that the session can be replayed offline with other target or solver settings.
+ * The output file and the topics are read from ROS parameters of the node. The file is closed on destruction.
+ */
+class HandEyeSessionRecorder : public rclcpp::Node
+{
+public:
+  explicit HandEyeSessionRecorder(const rclcpp::NodeOptions& options = rclcpp::NodeOptions());
+  ~HandEyeSessionRecorder() override;
+
+private:
+  void record(const std::string& topic, const std::string& type, const rclcpp::QoS& qos);
+
+  std::unique_ptr<rosbag2_cpp::Writer> writer_;
+  std::vector<rclcpp::GenericSubscription::SharedPtr> subscriptions_;
+};
+
+/**
+ * @class HandEyeSessionLoader
+ * @brief Extracts calibration samples from a session recorded by handeye_session_recorder.
+ * Images taken while the robot stood still at a new orientation become samples, with the robot pose from the recorded
+ * TF at the image time. The target is detected in the sample images on all cores, as fast as the data can be read.
+ * The loader settings and the target parameters are read from ROS parameters of the given node.
+ */
+class HandEyeSessionLoader
+{
+public:
+  explicit HandEyeSessionLoader(const rclcpp::Node::SharedPtr& node);
+
+  /**
+   * @brief Load the samples from a session.
+   * @param uri Path of the rosbag2 session.
+   * @return True if the target was detected in at least one sample image.
+   */
+  bool load(const std::string& uri);
+
+  /**
+   * @brief Get the samples of the last loaded session, with their detection stamps.
+   */
+  const SampleSet& getSamples() const;
+
+  const std::string& getSensorFrame() const;
+
+  const std::string& getRobotBaseFrame() const;
+
+  const std::string& getEndEffectorFrame() const;
+
+private:
+  bool readSession(const std::string& uri);
+
+  bool selectSamples();
+
+  bool detectTargets(const std::string& uri);
+
+  rclcpp::Node::SharedPtr node_;
+  std::string storage_id_;
+  std::string image_topic_;
+  std::string camera_info_topic_;
+  std::string target_type_;
+  std::string base_frame_;
+  std::string eef_frame_;
+  std::string sensor_frame_;
+  double min_rotation_;
+  double max_angular_velocity_;
+  double max_linear_velocity_;
+  int num_threads_;
+  bool undistort_image_;
+
+  std::unique_ptr<tf2::BufferCore> tf_buffer_;
+  sensor_msgs::msg::CameraInfo::ConstSharedPtr camera_info_;
+  std::vector<int64_t> image_stamps_;
+  std::vector<int64_t> sample_stamps_;
+  SampleSet samples_;
+};
+
+}  // namespace moveit_handeye_calibration
@@ -0,0 +1,103 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt Calibration contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#pragma once
+
+#include <moveit/handeye_calibration_solver/handeye_solver_base.h>
+#include <moveit/handeye_calibration_target/handeye_target_renderer.h>
+#include <moveit/handeye_calibration_tools/handeye_sample_file.h>
+
+namespace moveit_handeye_calibration
+{
+/**
+ * @brief Options of the synthetic calibration data.
+ */
+struct SyntheticDataOptions
+{
+  SensorMountType setup = EYE_TO_HAND;
+  std::size_t num_samples = 20;
+  double min_distance = 0.5;      // Closest distance of the target center from the camera, in m
+  double max_distance = 1.;       // Farthest distance of the target center from the camera, in m
+  double max_tilt = 0.5;          // Largest rotation of the target away from facing the camera, in rad
+  double image_border = 10.;      // Smallest distance of the target corners from the image border, in pixels
+  double rotation_noise = 0.;     // Standard deviation of the measured object pose rotation, in rad
+  double translation_noise = 0.;  // Standard deviation of the measured object pose translation, in m
+  bool render_images = true;      // Render the camera images, otherwise only generate the poses
+  RenderOptions render_options;   // Image effects, the noise seed changes with every image
+  double max_blur_sigma = 0.;     // Largest random blur added to render_options.blur_sigma, in pixels
+  double max_gradient = 0.;       // Largest random lighting gradient added to render_options.gradient, in gray levels
+  unsigned int seed = 0;
+};
+
+/**
+ * @brief Calibration sample with its ground truth.
+ */
+struct SyntheticSample
+{
+  cv::Mat image;                                 // Rendered camera image, empty if the images are not rendered
+  Eigen::Isometry3d object_wrt_sensor;           // True target pose with respect to the camera optical frame
+  Eigen::Isometry3d measured_object_wrt_sensor;  // object_wrt_sensor with the measurement noise
+  Eigen::Isometry3d effector_wrt_world;
+};
+
+/**
+ * @brief Synthetic calibration data with a known calibration.
+ * For eye-to-hand, the camera is fixed in the robot base frame and the target is fixed to the end-effector. For
+ * eye-in-hand, the camera is fixed to the end-effector and the target is fixed in the robot base frame.
+ */
+struct SyntheticDataset
+{
+  SensorMountType setup;
+  Eigen::Isometry3d camera_robot_pose;  // True calibration, camera pose in the robot base or end-effector frame
+  Eigen::Isometry3d target_robot_pose;  // Target pose in the end-effector or robot base frame
+  std::vector<SyntheticSample> samples;
+};
+
+/**
+ * @brief Generate random target views and the robot poses that produce them, and render the camera images.
+ * The target is centered at a random point of the image, at a random distance and tilt, and fully in view.
+ * @param target Initialized target to render, or null to generate poses only, for a target of negligible size.
+ * @param camera_info Camera size, intrinsics and plumb_bob or fisheye distortion.
+ * @return True on success, otherwise error_message is set.
+ */
+bool generateSyntheticData(const HandEyeTargetBase* target, const sensor_msgs::msg::CameraInfo& camera_info,
+                           const SyntheticDataOptions& options, SyntheticDataset& dataset,
+                           std::string* error_message = nullptr);
+
+/**
+ * @brief Get the robot poses and the measured object poses of the dataset, as input to the solvers.
+ */
+SampleSet getSampleSet(const SyntheticDataset& dataset);
+
+}  // namespace moveit_handeye_calibration
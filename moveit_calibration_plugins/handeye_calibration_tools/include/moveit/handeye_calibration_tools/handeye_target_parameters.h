@@ -0,0 +1,253 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt Calibration contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <moveit/handeye_calibration_target/handeye_target_base.h>
+#include <rclcpp/rclcpp.hpp>
+
+namespace moveit_handeye_calibration
+{
+/**
+ * @brief ROS parameter name of a target parameter, e.g. "marker size (px)" -> "target.marker_size_px".
+ */
+inline std::string getTargetParameterName(const std::string& name)
+{
+  std::string key;
+  for (char c : name)
+  {
+    if (std::isalnum(static_cast<unsigned char>(c)))
+      key += std::tolower(static_cast<unsigned char>(c));
+    else if (!key.empty() && key.back() != '_')
+      key += '_';
+  }
+  while (!key.empty() && key.back() == '_')
+    key.pop_back();
+  return "target." + key;
+}
+
+/**
+ * @brief Descriptor of the ROS parameter of a target parameter, with the range or the options of the parameter.
+ */
+inline rcl_interfaces::msg::ParameterDescriptor getTargetParameterDescriptor(const HandEyeTargetBase::Parameter& param)
+{
+  rcl_interfaces::msg::ParameterDescriptor descriptor;
+  descriptor.name = getTargetParameterName(param.name_);
+  descriptor.description = param.name_;
+  const bool has_range = std::isfinite(param.min_value_) || std::isfinite(param.max_value_);
+  switch (param.parameter_type_)
+  {
+    case HandEyeTargetBase::Parameter::ParameterType::Int:
+      if (has_range)
+      {
+        rcl_interfaces::msg::IntegerRange range;
+        range.from_value = std::max(param.min_value_, double(std::numeric_limits<int>::min()));
+        range.to_value = std::min(param.max_value_, double(std::numeric_limits<int>::max()));
+        descriptor.integer_range.push_back(range);
+      }
+      break;
+    case HandEyeTargetBase::Parameter::ParameterType::Float:
+      if (has_range)
+      {
+        rcl_interfaces::msg::FloatingPointRange range;
+        range.from_value = std::max(param.min_value_, -std::numeric_limits<double>::max());
+        range.to_value = std::min(param.max_value_, std::numeric_limits<double>::max());
+        descriptor.floating_point_range.push_back(range);
+      }
+      break;
+    case HandEyeTargetBase::Parameter::ParameterType::Enum:
+      descriptor.additional_constraints = "One of:";
+      for (const std::string& option : param.enum_values_)
+        descriptor.additional_constraints += " " + option;
+      break;
+  }
+  return descriptor;
+}
+
+/**
+ * @brief Check that a ROS parameter value has the type and is within the range or the options of a target parameter.
+ */
+inline bool isValidTargetParameterValue(const HandEyeTargetBase::Parameter& param, const rclcpp::ParameterValue& value)
+{
+  switch (param.parameter_type_)
+  {
+    case HandEyeTargetBase::Parameter::ParameterType::Int:
+      return value.get_type() == rclcpp::ParameterType::PARAMETER_INTEGER && param.isInRange(value.get<int64_t>());
+    case HandEyeTargetBase::Parameter::ParameterType::Float:
+      return value.get_type() == rclcpp::ParameterType::PARAMETER_DOUBLE && param.isInRange(value.get<double>());
+    case HandEyeTargetBase::Parameter::ParameterType::Enum:
+      return value.get_type() == rclcpp::ParameterType::PARAMETER_STRING &&
+             std::find(param.enum_values_.begin(), param.enum_values_.end(), value.get<std::string>()) !=
+                 param.enum_values_.end();
+  }
+  return false;
+}
+
+/**
+ * @brief Set a target parameter from the value of its ROS parameter.
+ * @return True if the value is valid for the target parameter.
+ */
+inline bool setTargetParameter(HandEyeTargetBase& target, const HandEyeTargetBase::Parameter& param,
+                               const rclcpp::ParameterValue& value)
+{
+  if (!isValidTargetParameterValue(param, value))
+    return false;
+  switch (param.parameter_type_)
+  {
+    case HandEyeTargetBase::Parameter::ParameterType::Int:
+      return target.setParameter(param.name_, static_cast<int>(value.get<int64_t>()));
+    case HandEyeTargetBase::Parameter::ParameterType::Float:
+      return target.setParameter(param.name_, value.get<double>());
+    case HandEyeTargetBase::Parameter::ParameterType::Enum:
+      return target.setParameter(param.name_, value.get<std::string>());
+  }
+  return false;
+}
+
+/**
+ * @brief Declare a ROS parameter for every target parameter, with the target's default and range, and set the target
+ * parameters from them. The parameters are only declared by the first call on a node.
+ */
+inline void declareTargetParameters(rclcpp::Node& node, HandEyeTargetBase& target)
+{
+  for (const auto& param : target.getParameters())
+  {
+    const std::string name = getTargetParameterName(param.name_);
+    rclcpp::ParameterValue default_value;
+    switch (param.parameter_type_)
+    {
+      case HandEyeTargetBase::Parameter::ParameterType::Int:
+        default_value = rclcpp::ParameterValue(param.value_.i);
+        break;
+      case HandEyeTargetBase::Parameter::ParameterType::Float:
+        default_value = rclcpp::ParameterValue(static_cast<double>(param.value_.f));
+        break;
+      case HandEyeTargetBase::Parameter::ParameterType::Enum:
+        default_value = rclcpp::ParameterValue(param.enum_values_[param.value_.e]);
+        break;
+    }
+    const rclcpp::ParameterValue value =
+        node.has_parameter(name) ? node.get_parameter(name).get_parameter_value() :
+                                   node.declare_parameter(name, default_value, getTargetParameterDescriptor(param));
+    if (!setTargetParameter(target, param, value))
+      RCLCPP_ERROR(node.get_logger(), "Invalid value of parameter %s", name.c_str());
+  }
+}
+
+/**
+ * @brief Set the target parameters to the values of a list of target parameters, e.g. from
+ * HandEyeTargetBase::getParameters.
+ */
+inline void setTargetParameters(HandEyeTargetBase& target, const std::vector<HandEyeTargetBase::Parameter>& params)
+{
+  for (const auto& param : params)
+  {
+    switch (param.parameter_type_)
+    {
+      case HandEyeTargetBase::Parameter::ParameterType::Int:
+        target.setParameter(param.name_, param.value_.i);
+        break;
+      case HandEyeTargetBase::Parameter::ParameterType::Float:
+        target.setParameter(param.name_, param.value_.f);
+        break;
+      case HandEyeTargetBase::Parameter::ParameterType::Enum:
+        target.setParameter(param.name_, param.enum_values_[param.value_.e]);
+        break;
+    }
+  }
+}
+
+/**
+ * @brief Declare the ROS parameters of a target, see declareTargetParameters, and keep the target parameters in sync
+ * with them. A change of the ROS parameters is applied as a whole, and the target is initialized again if it changed
+ * the target parameters. If a value is invalid or the target fails to initialize with the new values, the change is
+ * rejected and the target keeps its previous parameters. Use HandEyeTargetBase::addParameterCallback to observe the
+ * accepted changes.
+ * @return Handle of the ROS parameter callback; the target parameters stay in sync while it is held, and the target
+ * must outlive it.
+ */
+inline rclcpp::node_interfaces::OnSetParametersCallbackHandle::SharedPtr
+bindTargetParameters(rclcpp::Node& node, HandEyeTargetBase& target)
+{
+  declareTargetParameters(node, target);
+
+  std::map<std::string, HandEyeTargetBase::Parameter> target_params;
+  for (const auto& param : target.getParameters())
+    target_params.emplace(getTargetParameterName(param.name_), param);
+
+  return node.add_on_set_parameters_callback(
+      [&target, target_params](const std::vector<rclcpp::Parameter>& parameters) {
+        rcl_interfaces::msg::SetParametersResult result;
+        result.successful = true;
+        // Check all values first, so that a rejected change leaves the target unchanged
+        for (const rclcpp::Parameter& parameter : parameters)
+        {
+          const auto it = target_params.find(parameter.get_name());
+          if (it != target_params.end() && !isValidTargetParameterValue(it->second, parameter.get_parameter_value()))
+          {
+            result.successful = false;
+            result.reason = "Invalid value of parameter " + parameter.get_name();
+            return result;
+          }
+        }
+
+        const std::vector<HandEyeTargetBase::Parameter> previous_params = target.getParameters();
+        bool changed = false;
+        const std::size_t callback_id =
+            target.addParameterCallback([&changed](const HandEyeTargetBase::Parameter&) { changed = true; });
+        for (const rclcpp::Parameter& parameter : parameters)
+        {
+          const auto it = target_params.find(parameter.get_name());
+          if (it != target_params.end())
+            setTargetParameter(target, it->second, parameter.get_parameter_value());
+        }
+        target.removeParameterCallback(callback_id);
+
+        if (changed && !target.initialize())
+        {
+          setTargetParameters(target, previous_params);
+          target.initialize();
+          result.successful = false;
+          result.reason = "Cannot initialize the target with the new parameters";
+        }
+        return result;
+      });
+}
+
+}  // namespace moveit_handeye_calibration
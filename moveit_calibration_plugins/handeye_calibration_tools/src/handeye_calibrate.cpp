@@ -0,0 +1,302 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt Calibration contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <moveit/handeye_calibration_solver/handeye_solver_base.h>
+#include <moveit/handeye_calibration_solver/handeye_solver_uncertainty.h>
+#include <moveit/handeye_calibration_tools/handeye_calibration_export.h>
+#include <moveit/handeye_calibration_tools/handeye_sample_file.h>
+#include <moveit/handeye_calibration_tools/handeye_session.h>
+
+#include <atomic>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <thread>
+#include <pluginlib/class_loader.hpp>
+#include <rclcpp/rclcpp.hpp>
+
+namespace moveit_handeye_calibration
+{
+namespace
+{
+const char* USAGE = "Usage: handeye_calibrate <session directory | samples file> <output file>... [--ros-args ...]\n"
+                    "The output format follows the extension: .py, .xml or .yaml/.yml, for a launch file in that "
+                    "format.";
+}  // namespace
+
+/**
+ * @brief Calibrates without the GUI, from a recorded session or a binary sample file.
+ * Every solver of every solver plugin is run on the samples in parallel. The result with the lowest translation
+ * reprojection error, or the one selected by the "solver" parameter ("<plugin>/<solver name>"), is written to the
+ * output files.
+ */
+class HandEyeCalibrateNode : public rclcpp::Node
+{
+public:
+  HandEyeCalibrateNode(const rclcpp::NodeOptions& options = rclcpp::NodeOptions())
+    : Node("handeye_calibrate", options)
+  {
+    solver_ = declare_parameter<std::string>("solver", "");
+    motion_pairs_ = declare_parameter<int>("motion_pairs", CONSECUTIVE_PAIRS);
+    mount_type_ = declare_parameter<std::string>("sensor_mount_type", "eye_to_hand");
+    sensor_frame_ = declare_parameter<std::string>("sensor_frame", "camera_color_optical_frame");
+    uncertainty_resamples_ = declare_parameter<int>("uncertainty_resamples", 0);
+  }
+
+  bool run(const std::string& input, const std::vector<std::string>& outputs)
+  {
+    if (mount_type_ == "eye_to_hand")
+      setup_ = EYE_TO_HAND;
+    else if (mount_type_ == "eye_in_hand")
+      setup_ = EYE_IN_HAND;
+    else
+    {
+      RCLCPP_ERROR(get_logger(), "Unknown sensor_mount_type '%s', expected 'eye_to_hand' or 'eye_in_hand'",
+                   mount_type_.c_str());
+      return false;
+    }
+
+    std::vector<LaunchFormat> formats(outputs.size());
+    for (std::size_t i = 0; i < outputs.size(); ++i)
+    {
+      if (!getLaunchFormat(outputs[i], formats[i]))
+      {
+        RCLCPP_ERROR(get_logger(), "Unknown output format of '%s'", outputs[i].c_str());
+        return false;
+      }
+    }
+
+    // The session loader declares the frame and detection parameters, so it is needed for sample files as well
+    HandEyeSessionLoader loader(shared_from_this());
+    if (endsWith(input, ".samples"))
+    {
+      std::string error_message;
+      if (!readSampleFile(input, samples_, &error_message))
+      {
+        RCLCPP_ERROR(get_logger(), "%s", error_message.c_str());
+        return false;
+      }
+    }
+    else
+    {
+      if (!loader.load(input))
+        return false;
+      samples_ = loader.getSamples();
+      sensor_frame_ = loader.getSensorFrame();
+    }
+    const std::string& from_frame = setup_ == EYE_IN_HAND ? loader.getEndEffectorFrame() : loader.getRobotBaseFrame();
+
+    const Result* result = solve();
+    if (!result)
+      return false;
+
+    CalibrationUncertainty uncertainty;
+    const bool uncertainty_valid = uncertainty_resamples_ > 0 && estimateUncertainty(*result, uncertainty);
+    if (uncertainty_valid)
+      RCLCPP_INFO(get_logger(), "Calibration uncertainty:\n%s", getUncertaintyText(uncertainty, "").c_str());
+
+    for (std::size_t i = 0; i < outputs.size(); ++i)
+    {
+      std::ofstream file(outputs[i]);
+      if (!file.is_open())
+      {
+        RCLCPP_ERROR(get_logger(), "Failed to open '%s' for writing", outputs[i].c_str());
+        return false;
+      }
+      file << generateCalibrationLaunch(formats[i], from_frame, sensor_frame_, result->pose, setup_,
+                                        uncertainty_valid ? &uncertainty : nullptr)
+                  .rdbuf();
+      RCLCPP_INFO(get_logger(), "Wrote the calibration to '%s'", outputs[i].c_str());
+    }
+    return true;
+  }
+
+private:
+  struct Result
+  {
+    std::string plugin;
+    std::string solver_name;
+    pluginlib::UniquePtr<HandEyeSolverBase> solver;
+    bool success = false;
+    std::string error_message;
+    Eigen::Isometry3d pose = Eigen::Isometry3d::Identity();
+    CalibrationError reprojection_error;
+  };
+
+  /**
+   * @brief Run all solvers in parallel, with one solver instance per solver name.
+   * @return The selected result, or nullptr if it failed.
+   */
+  const Result* solve()
+  {
+    // Plugin loading is not thread safe, so the solvers are created up front
+    for (const std::string& plugin : solver_loader_.getDeclaredClasses())
+    {
+      try
+      {
+        pluginlib::UniquePtr<HandEyeSolverBase> solver = solver_loader_.createUniqueInstance(plugin);
+        solver->initialize();
+        for (const std::string& solver_name : solver->getSolverNames())
+        {
+          if (!solver_.empty() && solver_ != plugin + "/" + solver_name)
+            continue;
+          Result result;
+          result.plugin = plugin;
+          result.solver_name = solver_name;
+          result.solver = solver_loader_.createUniqueInstance(plugin);
+          result.solver->initialize();
+          result.solver->setMotionPairMode(static_cast<MotionPairMode>(motion_pairs_));
+          results_.push_back(std::move(result));
+        }
+      }
+      catch (const pluginlib::PluginlibException& ex)
+      {
+        RCLCPP_ERROR(get_logger(), "Failed to load solver plugin %s: %s", plugin.c_str(), ex.what());
+      }
+    }
+    if (results_.empty())
+    {
+      RCLCPP_ERROR(get_logger(), "Unknown solver '%s'", solver_.c_str());
+      return nullptr;
+    }
+
+    std::atomic<std::size_t> next_result(0);
+    auto worker = [&]() {
+      for (std::size_t i = next_result++; i < results_.size(); i = next_result++)
+      {
+        Result& result = results_[i];
+        result.success = result.solver->solve(samples_.effector_wrt_world, samples_.object_wrt_sensor, setup_,
+                                              result.solver_name, &result.error_message);
+        if (!result.success)
+          continue;
+        result.pose = result.solver->getCameraRobotPose();
+        result.reprojection_error = result.solver->getCalibrationError(
+            samples_.effector_wrt_world, samples_.object_wrt_sensor, result.pose, setup_);
+      }
+    };
+    const std::size_t num_threads = std::min<std::size_t>(results_.size(), std::thread::hardware_concurrency());
+    std::vector<std::thread> threads;
+    for (std::size_t t = 1; t < num_threads; ++t)
+      threads.emplace_back(worker);
+    worker();
+    for (std::thread& thread : threads)
+      thread.join();
+
+    const Result* best = nullptr;
+    for (const Result& result : results_)
+    {
+      if (!result.success)
+      {
+        RCLCPP_WARN(get_logger(), "%s/%s failed: %s", result.plugin.c_str(), result.solver_name.c_str(),
+                    result.error_message.c_str());
+        continue;
+      }
+      RCLCPP_INFO(get_logger(), "%s/%s reprojection error: %f m, %f rad", result.plugin.c_str(),
+                  result.solver_name.c_str(), result.reprojection_error.translation,
+                  result.reprojection_error.rotation);
+      if (!best || result.reprojection_error.translation < best->reprojection_error.translation)
+        best = &result;
+    }
+    if (!best)
+    {
+      RCLCPP_ERROR(get_logger(), "Calibration failed with all solvers over %zu samples",
+                   samples_.effector_wrt_world.size());
+      return nullptr;
+    }
+
+    const Eigen::Quaterniond q(best->pose.rotation());
+    RCLCPP_INFO(get_logger(),
+                "Calibration by %s/%s over %zu samples:\n"
+                "translation (x, y, z): %f, %f, %f\n"
+                "rotation (x, y, z, w): %f, %f, %f, %f",
+                best->plugin.c_str(), best->solver_name.c_str(), samples_.effector_wrt_world.size(),
+                best->pose.translation().x(), best->pose.translation().y(), best->pose.translation().z(), q.x(), q.y(),
+                q.z(), q.w());
+    return best;
+  }
+
+  bool estimateUncertainty(const Result& result, CalibrationUncertainty& uncertainty)
+  {
+    std::vector<pluginlib::UniquePtr<HandEyeSolverBase>> solver_instances;
+    std::vector<HandEyeSolverBase*> solvers;
+    try
+    {
+      for (unsigned int t = 0; t < std::max(1u, std::thread::hardware_concurrency()); ++t)
+      {
+        solver_instances.push_back(solver_loader_.createUniqueInstance(result.plugin));
+        solver_instances.back()->initialize();
+        solver_instances.back()->setMotionPairMode(static_cast<MotionPairMode>(motion_pairs_));
+        solvers.push_back(solver_instances.back().get());
+      }
+    }
+    catch (const pluginlib::PluginlibException& ex)
+    {
+      RCLCPP_ERROR(get_logger(), "Failed to load solver plugin %s: %s", result.plugin.c_str(), ex.what());
+      return false;
+    }
+    return estimateCalibrationUncertainty(solvers, samples_.effector_wrt_world, samples_.object_wrt_sensor,
+                                          result.pose, setup_, result.solver_name, BOOTSTRAP,
+                                          uncertainty_resamples_, uncertainty);
+  }
+
+  std::string solver_;
+  int motion_pairs_;
+  std::string mount_type_;
+  SensorMountType setup_;
+  std::string sensor_frame_;
+  int uncertainty_resamples_;
+
+  pluginlib::ClassLoader<HandEyeSolverBase> solver_loader_{ "moveit_calibration_plugins",
+                                                            "moveit_handeye_calibration::HandEyeSolverBase" };
+  SampleSet samples_;
+  std::vector<Result> results_;
+};
+
+}  // namespace moveit_handeye_calibration
+
+int main(int argc, char** argv)
+{
+  const std::vector<std::string> args = rclcpp::init_and_remove_ros_arguments(argc, argv);
+  if (args.size() < 3)
+  {
+    std::cerr << moveit_handeye_calibration::USAGE << std::endl;
+    rclcpp::shutdown();
+    return 2;
+  }
+
+  auto node = std::make_shared<moveit_handeye_calibration::HandEyeCalibrateNode>();
+  const bool success = node->run(args[1], std::vector<std::string>(args.begin() + 2, args.end()));
+  rclcpp::shutdown();
+  return success ? 0 : 1;
+}
@@ -0,0 +1,228 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt Calibration contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <moveit/handeye_calibration_tools/handeye_calibration_export.h>
+
+namespace moveit_handeye_calibration
+{
+bool endsWith(const std::string& str, const std::string& suffix)
+{
+  return str.size() >= suffix.size() && str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+bool getLaunchFormat(const std::string& file_name, LaunchFormat& format)
+{
+  if (endsWith(file_name, ".py"))
+    format = LAUNCH_PYTHON;
+  else if (endsWith(file_name, ".xml"))
+    format = LAUNCH_XML;
+  else if (endsWith(file_name, ".yaml") || endsWith(file_name, ".yml"))
+    format = LAUNCH_YAML;
+  else
+    return false;
+  return true;
+}
+
+std::string getMountTypeName(SensorMountType setup)
+{
+  switch (setup)
+  {
+    case EYE_TO_HAND:
+      return "EYE-TO-HAND";
+    case EYE_IN_HAND:
+      return "EYE-IN-HAND";
+  }
+  return "";
+}
+
+std::string getUncertaintyText(const CalibrationUncertainty& uncertainty, const std::string& line_prefix)
+{
+  const Eigen::Vector3d& t = uncertainty.translation_stddev;
+  const Eigen::Vector3d& r = uncertainty.rotation_stddev;
+  std::ostringstream ss;
+  ss << line_prefix << "Std. dev. over " << uncertainty.num_resamples << " resamples:" << std::endl
+     << line_prefix << "translation (x, y, z): " << t[0] << ", " << t[1] << ", " << t[2] << " m" << std::endl
+     << line_prefix << "rotation (x, y, z): " << r[0] << ", " << r[1] << ", " << r[2] << " rad";
+  return ss.str();
+}
+
+std::stringstream generateCalibrationLaunch(LaunchFormat format, const std::string& from_frame,
+                                            const std::string& to_frame, const Eigen::Isometry3d& pose,
+                                            SensorMountType setup, const CalibrationUncertainty* uncertainty)
+{
+  switch (format)
+  {
+    case LAUNCH_XML:
+      return generateCalibrationXml(from_frame, to_frame, pose, setup, uncertainty);
+    case LAUNCH_YAML:
+      return generateCalibrationYaml(from_frame, to_frame, pose, setup, uncertainty);
+    case LAUNCH_PYTHON:
+    default:
+      return generateCalibrationPython(from_frame, to_frame, pose, setup, uncertainty);
+  }
+}
+
+std::stringstream generateCalibrationPython(const std::string& from_frame, const std::string& to_frame,
+                                            const Eigen::Isometry3d& pose, SensorMountType setup,
+                                            const CalibrationUncertainty* uncertainty)
+{
+  const Eigen::Vector3d t = pose.translation();
+  const Eigen::Quaterniond r_quat(pose.rotation());
+  const Eigen::Vector3d r_euler = pose.rotation().eulerAngles(0, 1, 2);
+
+  std::stringstream ss;
+  ss << "\"\"\" Static transform publisher acquired via MoveIt 2 hand-eye calibration \"\"\"" << std::endl;
+  ss << "\"\"\" " << getMountTypeName(setup) << ": " << from_frame << " -> " << to_frame << " \"\"\"" << std::endl;
+  if (uncertainty)
+    ss << getUncertaintyText(*uncertainty, "# ") << std::endl;
+  ss << "from launch import LaunchDescription" << std::endl;
+  ss << "from launch_ros.actions import Node" << std::endl;
+  ss << std::endl;
+  ss << std::endl;
+  ss << "def generate_launch_description() -> LaunchDescription:" << std::endl;
+  ss << "    nodes = [" << std::endl;
+  ss << "        Node(" << std::endl;
+  ss << "            package=\"tf2_ros\"," << std::endl;
+  ss << "            executable=\"static_transform_publisher\"," << std::endl;
+  ss << "            output=\"log\"," << std::endl;
+  ss << "            arguments=[" << std::endl;
+  ss << "                \"--frame-id\"," << std::endl;
+  ss << "                \"" << from_frame << "\"," << std::endl;
+  ss << "                \"--child-frame-id\"," << std::endl;
+  ss << "                \"" << to_frame << "\"," << std::endl;
+  ss << "                \"--x\"," << std::endl;
+  ss << "                \"" << t[0] << "\"," << std::endl;
+  ss << "                \"--y\"," << std::endl;
+  ss << "                \"" << t[1] << "\"," << std::endl;
+  ss << "                \"--z\"," << std::endl;
+  ss << "                \"" << t[2] << "\"," << std::endl;
+  ss << "                \"--qx\"," << std::endl;
+  ss << "                \"" << r_quat.x() << "\"," << std::endl;
+  ss << "                \"--qy\"," << std::endl;
+  ss << "                \"" << r_quat.y() << "\"," << std::endl;
+  ss << "                \"--qz\"," << std::endl;
+  ss << "                \"" << r_quat.z() << "\"," << std::endl;
+  ss << "                \"--qw\"," << std::endl;
+  ss << "                \"" << r_quat.w() << "\"," << std::endl;
+  ss << "                # \"--roll\"," << std::endl;
+  ss << "                # \"" << r_euler[0] << "\"," << std::endl;
+  ss << "                # \"--pitch\"," << std::endl;
+  ss << "                # \"" << r_euler[1] << "\"," << std::endl;
+  ss << "                # \"--yaw\"," << std::endl;
+  ss << "                # \"" << r_euler[2] << "\"," << std::endl;
+  ss << "            ]," << std::endl;
+  ss << "        )," << std::endl;
+  ss << "    ]" << std::endl;
+  ss << "    return LaunchDescription(nodes)" << std::endl;
+  return ss;
+}
+
+std::stringstream generateCalibrationXml(const std::string& from_frame, const std::string& to_frame,
+                                         const Eigen::Isometry3d& pose, SensorMountType setup,
+                                         const CalibrationUncertainty* uncertainty)
+{
+  const Eigen::Vector3d t = pose.translation();
+  const Eigen::Quaterniond r_quat(pose.rotation());
+  const Eigen::Vector3d r_euler = pose.rotation().eulerAngles(0, 1, 2);
+
+  std::stringstream ss;
+  ss << "<!-- Static transform publisher acquired via MoveIt 2 hand-eye calibration -->" << std::endl;
+  ss << "<!-- " << getMountTypeName(setup) << ": " << from_frame << " -> " << to_frame << " -->" << std::endl;
+  if (uncertainty)
+    ss << "<!--" << std::endl << getUncertaintyText(*uncertainty, "     ") << std::endl << "-->" << std::endl;
+  ss << std::endl;
+  ss << "<launch>" << std::endl;
+  ss << "    <node" << std::endl;
+  ss << "        pkg=\"tf2_ros\"" << std::endl;
+  ss << "        exec=\"static_transform_publisher\"" << std::endl;
+  ss << "        output=\"log\"" << std::endl;
+  ss << "        args=\"" << std::endl;
+  ss << "            --frame-id " << from_frame << std::endl;
+  ss << "            --child-frame-id " << to_frame << std::endl;
+  ss << "            --x " << t[0] << std::endl;
+  ss << "            --y " << t[1] << std::endl;
+  ss << "            --z " << t[2] << std::endl;
+  ss << "            --qx " << r_quat.x() << std::endl;
+  ss << "            --qy " << r_quat.y() << std::endl;
+  ss << "            --qz " << r_quat.z() << std::endl;
+  ss << "            --qw " << r_quat.w() << std::endl;
+  ss << "        \"" << std::endl;
+  ss << "    />" << std::endl;
+  ss << "    <!--" << std::endl;
+  ss << "            roll " << r_euler[0] << std::endl;
+  ss << "            pitch " << r_euler[1] << std::endl;
+  ss << "            yaw " << r_euler[2] << std::endl;
+  ss << "    -->" << std::endl;
+  ss << "</launch>" << std::endl;
+  return ss;
+}
+
+std::stringstream generateCalibrationYaml(const std::string& from_frame, const std::string& to_frame,
+                                          const Eigen::Isometry3d& pose, SensorMountType setup,
+                                          const CalibrationUncertainty* uncertainty)
+{
+  const Eigen::Vector3d t = pose.translation();
+  const Eigen::Quaterniond r_quat(pose.rotation());
+  const Eigen::Vector3d r_euler = pose.rotation().eulerAngles(0, 1, 2);
+
+  std::stringstream ss;
+  ss << "# Static transform publisher acquired via MoveIt 2 hand-eye calibration" << std::endl;
+  ss << "# " << getMountTypeName(setup) << ": " << from_frame << " -> " << to_frame << std::endl;
+  if (uncertainty)
+    ss << getUncertaintyText(*uncertainty, "# ") << std::endl;
+  ss << std::endl;
+  ss << "launch:" << std::endl;
+  ss << "    - node:" << std::endl;
+  ss << "          pkg: tf2_ros" << std::endl;
+  ss << "          exec: static_transform_publisher" << std::endl;
+  ss << "          output: log" << std::endl;
+  ss << "          args:" << std::endl;
+  ss << "              \"" << std::endl;
+  ss << "              --frame-id " << from_frame << std::endl;
+  ss << "              --child-frame-id " << to_frame << std::endl;
+  ss << "              --x " << t[0] << std::endl;
+  ss << "              --y " << t[1] << std::endl;
+  ss << "              --z " << t[2] << std::endl;
+  ss << "              --qx " << r_quat.x() << std::endl;
+  ss << "              --qy " << r_quat.y() << std::endl;
+  ss << "              --qz " << r_quat.z() << std::endl;
+  ss << "              --qw " << r_quat.w() << std::endl;
+  ss << "              \"" << std::endl;
+  ss << "              # --roll " << r_euler[0] << std::endl;
+  ss << "              # --pitch " << r_euler[1] << std::endl;
+  ss << "              # --yaw " << r_euler[2] << std::endl;
+  return ss;
+}
+
+}  // namespace moveit_handeye_calibration
@@ -0,0 +1,173 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt Calibration contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <moveit/handeye_calibration_tools/handeye_detection_statistics.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace moveit_handeye_calibration
+{
+namespace
+{
+const double DROP_GAP = 1.5;          // Smallest frame interval counted as a gap, relative to the frame period
+const double PERIOD_SMOOTHING = 0.1;  // Weight of a new frame interval in the frame period average
+
+diagnostic_msgs::msg::KeyValue makeKeyValue(const std::string& key, const std::string& value)
+{
+  diagnostic_msgs::msg::KeyValue key_value;
+  key_value.key = key;
+  key_value.value = value;
+  return key_value;
+}
+}  // namespace
+
+HandEyeDetectionStatistics::HandEyeDetectionStatistics(std::size_t window) : window_(std::max<std::size_t>(window, 1))
+{
+  reset();
+}
+
+void HandEyeDetectionStatistics::addReceivedFrame(double stamp)
+{
+  if (totals_.frames_received > 0 && stamp > last_stamp_)
+  {
+    const double interval = stamp - last_stamp_;
+    if (frame_period_ > 0. && interval > DROP_GAP * frame_period_)
+      totals_.frames_dropped += std::lround(interval / frame_period_) - 1;
+    else if (frame_period_ > 0.)
+      frame_period_ += PERIOD_SMOOTHING * (interval - frame_period_);
+    else
+      frame_period_ = interval;
+  }
+  if (totals_.frames_received == 0 || stamp > last_stamp_)
+    last_stamp_ = stamp;
+  ++totals_.frames_received;
+}
+
+void HandEyeDetectionStatistics::addSkippedFrame()
+{
+  ++totals_.frames_skipped;
+}
+
+void HandEyeDetectionStatistics::addProcessedFrame(bool detected, double latency, std::size_t num_markers,
+                                                   double reprojection_rms)
+{
+  ++totals_.frames_processed;
+  if (detected)
+    ++totals_.detections;
+  frames_.push_back({ detected, latency, num_markers, reprojection_rms });
+  if (frames_.size() > window_)
+    frames_.pop_front();
+}
+
+DetectionSummary HandEyeDetectionStatistics::getSummary() const
+{
+  DetectionSummary summary = totals_;
+  if (frames_.empty())
+    return summary;
+
+  std::vector<double> latencies;
+  latencies.reserve(frames_.size());
+  std::size_t detected = 0;
+  double squared_residual = 0.;
+  for (const Frame& frame : frames_)
+  {
+    latencies.push_back(frame.latency);
+    if (!frame.detected)
+      continue;
+    ++detected;
+    summary.mean_markers += frame.num_markers;
+    squared_residual += frame.reprojection_rms * frame.reprojection_rms;
+  }
+  summary.success_rate = double(detected) / frames_.size();
+  if (detected > 0)
+  {
+    summary.mean_markers /= detected;
+    summary.residual_rms = std::sqrt(squared_residual / detected);
+  }
+
+  std::sort(latencies.begin(), latencies.end());
+  summary.latency_p50 = latencies[(latencies.size() - 1) * 50 / 100];
+  summary.latency_p95 = latencies[(latencies.size() - 1) * 95 / 100];
+  summary.latency_max = latencies.back();
+  return summary;
+}
+
+void HandEyeDetectionStatistics::reset()
+{
+  frames_.clear();
+  totals_ = DetectionSummary();
+  last_stamp_ = 0.;
+  frame_period_ = 0.;
+}
+
+diagnostic_msgs::msg::DiagnosticStatus getDetectionDiagnostics(const DetectionSummary& summary, const std::string& name,
+                                                               const std::string& hardware_id)
+{
+  diagnostic_msgs::msg::DiagnosticStatus status;
+  status.name = name;
+  status.hardware_id = hardware_id;
+  if (summary.frames_processed == 0)
+  {
+    status.level = diagnostic_msgs::msg::DiagnosticStatus::STALE;
+    status.message = "No camera frames processed";
+  }
+  else if (summary.success_rate == 0.)
+  {
+    status.level = diagnostic_msgs::msg::DiagnosticStatus::WARN;
+    status.message = "Target not detected in the latest frames";
+  }
+  else
+  {
+    status.level = diagnostic_msgs::msg::DiagnosticStatus::OK;
+    status.message = "Target detected in " + std::to_string(std::lround(100. * summary.success_rate)) +
+                     "% of the latest frames";
+  }
+
+  status.values.push_back(makeKeyValue("frames received", std::to_string(summary.frames_received)));
+  status.values.push_back(makeKeyValue("frames processed", std::to_string(summary.frames_processed)));
+  status.values.push_back(makeKeyValue("frames skipped", std::to_string(summary.frames_skipped)));
+  status.values.push_back(makeKeyValue("frames dropped", std::to_string(summary.frames_dropped)));
+  status.values.push_back(makeKeyValue("detections", std::to_string(summary.detections)));
+  status.values.push_back(makeKeyValue("success rate", std::to_string(summary.success_rate)));
+  status.values.push_back(makeKeyValue("mean markers", std::to_string(summary.mean_markers)));
+  status.values.push_back(makeKeyValue("latency p50 (ms)", std::to_string(summary.latency_p50 * 1e3)));
+  status.values.push_back(makeKeyValue("latency p95 (ms)", std::to_string(summary.latency_p95 * 1e3)));
+  status.values.push_back(makeKeyValue("latency max (ms)", std::to_string(summary.latency_max * 1e3)));
+  status.values.push_back(makeKeyValue("residual rms (px)", std::to_string(summary.residual_rms)));
+  return status;
+}
+
+}  // namespace moveit_handeye_calibration
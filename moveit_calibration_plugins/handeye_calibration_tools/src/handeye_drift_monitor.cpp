@@ -0,0 +1,145 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt Calibration contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <moveit/handeye_calibration_tools/handeye_drift_monitor.h>
+
+namespace moveit_handeye_calibration
+{
+namespace
+{
+const MotionPairs REFERENCE_MOTION = { { 0, 1 } };  // Motion from the reference to the latest observation
+}  // namespace
+
+HandEyeDriftMonitor::HandEyeDriftMonitor(const Eigen::Isometry3d& camera_robot_pose, SensorMountType setup,
+                                         double smoothing)
+  : camera_robot_pose_(camera_robot_pose)
+  , setup_(setup)
+  , smoothing_(std::min(std::max(smoothing, std::numeric_limits<double>::epsilon()), 1.))
+  , effector_wrt_world_(2, Eigen::Isometry3d::Identity())
+  , object_wrt_sensor_(2, Eigen::Isometry3d::Identity())
+{
+}
+
+void HandEyeDriftMonitor::setThresholds(const DriftThresholds& thresholds)
+{
+  thresholds_ = thresholds;
+}
+
+const DriftThresholds& HandEyeDriftMonitor::getThresholds() const
+{
+  return thresholds_;
+}
+
+void HandEyeDriftMonitor::setCameraRobotPose(const Eigen::Isometry3d& camera_robot_pose)
+{
+  camera_robot_pose_ = camera_robot_pose;
+  reset();
+}
+
+void HandEyeDriftMonitor::reset()
+{
+  has_reference_ = false;
+  num_observations_ = 0;
+  translation_ = DriftStatistics();
+  rotation_ = DriftStatistics();
+  level_ = DRIFT_OK;
+}
+
+DriftLevel HandEyeDriftMonitor::addObservation(const Eigen::Isometry3d& effector_wrt_world,
+                                               const Eigen::Isometry3d& object_wrt_sensor)
+{
+  if (!has_reference_)
+  {
+    effector_wrt_world_[0] = effector_wrt_world;
+    object_wrt_sensor_[0] = object_wrt_sensor;
+    has_reference_ = true;
+    return level_;
+  }
+
+  effector_wrt_world_[1] = effector_wrt_world;
+  object_wrt_sensor_[1] = object_wrt_sensor;
+  const CalibrationError error = HandEyeSolverBase::getCalibrationError(
+      effector_wrt_world_, object_wrt_sensor_, camera_robot_pose_, REFERENCE_MOTION, setup_);
+  if (!std::isfinite(error.rotation) || !std::isfinite(error.translation))
+    return level_;
+
+  ++num_observations_;
+  updateStatistics(rotation_, error.rotation);
+  updateStatistics(translation_, error.translation);
+
+  if (translation_.mean > thresholds_.translation_error || rotation_.mean > thresholds_.rotation_error)
+    level_ = DRIFT_ERROR;
+  else if (translation_.mean > thresholds_.translation_warn || rotation_.mean > thresholds_.rotation_warn)
+    level_ = DRIFT_WARN;
+  else
+    level_ = DRIFT_OK;
+  return level_;
+}
+
+void HandEyeDriftMonitor::updateStatistics(DriftStatistics& statistics, double value)
+{
+  statistics.last = value;
+  statistics.max = std::max(statistics.max, value);
+  if (num_observations_ == 1)
+  {
+    statistics.mean = value;
+    statistics.variance = 0.;
+    return;
+  }
+  const double difference = value - statistics.mean;
+  statistics.mean += smoothing_ * difference;
+  statistics.variance = (1. - smoothing_) * (statistics.variance + smoothing_ * difference * difference);
+}
+
+DriftLevel HandEyeDriftMonitor::getLevel() const
+{
+  return level_;
+}
+
+std::size_t HandEyeDriftMonitor::getNumObservations() const
+{
+  return num_observations_;
+}
+
+const DriftStatistics& HandEyeDriftMonitor::getTranslationStatistics() const
+{
+  return translation_;
+}
+
+const DriftStatistics& HandEyeDriftMonitor::getRotationStatistics() const
+{
+  return rotation_;
+}
+
+}  // namespace moveit_handeye_calibration
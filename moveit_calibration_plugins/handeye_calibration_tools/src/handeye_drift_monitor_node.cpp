@@ -0,0 +1,276 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt Calibration contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <moveit/handeye_calibration_target/handeye_target_base.h>
+#include <moveit/handeye_calibration_tools/handeye_detection_statistics.h>
+#include <moveit/handeye_calibration_tools/handeye_drift_monitor.h>
+#include <moveit/handeye_calibration_tools/handeye_target_parameters.h>
+
+#include <cv_bridge/cv_bridge.h>
+#include <diagnostic_msgs/msg/diagnostic_array.hpp>
+#include <pluginlib/class_loader.hpp>
+#include <rclcpp/rclcpp.hpp>
+#include <sensor_msgs/image_encodings.hpp>
+#include <tf2_ros/buffer.h>
+#include <tf2_ros/transform_listener.h>
+
+#include <chrono>
+
+namespace moveit_handeye_calibration
+{
+namespace
+{
+const std::vector<std::string> LEVEL_MESSAGES = { "Calibration consistent", "Calibration drift suspected",
+                                                  "Calibration drift detected" };
+
+diagnostic_msgs::msg::KeyValue makeKeyValue(const std::string& key, const std::string& value)
+{
+  diagnostic_msgs::msg::KeyValue key_value;
+  key_value.key = key;
+  key_value.value = value;
+  return key_value;
+}
+}  // namespace
+
+/**
+ * @brief Detects the calibration target in every camera image and publishes the drift of the stored calibration, read
+ * from TF, and the detection statistics of the camera as diagnostics.
+ */
+class HandEyeDriftMonitorNode : public rclcpp::Node
+{
+public:
+  HandEyeDriftMonitorNode(const rclcpp::NodeOptions& options = rclcpp::NodeOptions())
+    : Node("handeye_drift_monitor", options)
+  {
+    const std::string target_type = declare_parameter<std::string>("target_type", "HandEyeTarget/Aruco");
+    const std::string mount_type = declare_parameter<std::string>("sensor_mount_type", "eye_to_hand");
+    setup_ = mount_type == "eye_in_hand" ? EYE_IN_HAND : EYE_TO_HAND;
+    base_frame_ = declare_parameter<std::string>("robot_base_frame", "base_link");
+    eef_frame_ = declare_parameter<std::string>("end_effector_frame", "tool0");
+
+    DriftThresholds thresholds;
+    thresholds.translation_warn = declare_parameter<double>("translation_warn", thresholds.translation_warn);
+    thresholds.translation_error = declare_parameter<double>("translation_error", thresholds.translation_error);
+    thresholds.rotation_warn = declare_parameter<double>("rotation_warn", thresholds.rotation_warn);
+    thresholds.rotation_error = declare_parameter<double>("rotation_error", thresholds.rotation_error);
+    const double smoothing = declare_parameter<double>("smoothing", HandEyeDriftMonitor::DEFAULT_SMOOTHING);
+    const double diagnostic_period = declare_parameter<double>("diagnostic_period", 1.0);
+    const int statistics_window =
+        declare_parameter<int>("statistics_window", HandEyeDetectionStatistics::DEFAULT_WINDOW);
+    statistics_ = std::make_unique<HandEyeDetectionStatistics>(std::max(statistics_window, 1));
+
+    monitor_ = std::make_unique<HandEyeDriftMonitor>(Eigen::Isometry3d::Identity(), setup_, smoothing);
+    monitor_->setThresholds(thresholds);
+
+    target_loader_ = std::make_unique<pluginlib::ClassLoader<HandEyeTargetBase>>(
+        "moveit_calibration_plugins", "moveit_handeye_calibration::HandEyeTargetBase");
+    target_ = target_loader_->createUniqueInstance(target_type);
+    target_params_callback_ = bindTargetParameters(*this, *target_);
+    target_->setUndistortImage(declare_parameter<bool>("undistort_image", false));
+    if (!target_->initialize())
+      throw std::runtime_error("Failed to initialize handeye target " + target_type);
+
+    tf_buffer_ = std::make_shared<tf2_ros::Buffer>(get_clock());
+    tf_listener_ = std::make_shared<tf2_ros::TransformListener>(*tf_buffer_);
+
+    diagnostic_pub_ = create_publisher<diagnostic_msgs::msg::DiagnosticArray>("/diagnostics", 1);
+    camera_info_sub_ = create_subscription<sensor_msgs::msg::CameraInfo>(
+        "camera_info", rclcpp::SensorDataQoS(),
+        [this](const sensor_msgs::msg::CameraInfo::ConstSharedPtr& msg) { cameraInfoCallback(msg); });
+    image_sub_ = create_subscription<sensor_msgs::msg::Image>(
+        "image", rclcpp::SensorDataQoS(),
+        [this](const sensor_msgs::msg::Image::ConstSharedPtr& msg) { imageCallback(msg); });
+    diagnostic_timer_ = create_wall_timer(std::chrono::duration<double>(diagnostic_period),
+                                          [this]() { publishDiagnostics(); });
+  }
+
+private:
+  void cameraInfoCallback(const sensor_msgs::msg::CameraInfo::ConstSharedPtr& msg)
+  {
+    // The image size is part of the intrinsics, since the undistortion remap tables depend on it
+    if (!camera_info_ || msg->k != camera_info_->k || msg->d != camera_info_->d || msg->width != camera_info_->width ||
+        msg->height != camera_info_->height)
+    {
+      if (target_->setCameraIntrinsicParams(msg))
+        camera_info_ = msg;
+    }
+  }
+
+  void imageCallback(const sensor_msgs::msg::Image::ConstSharedPtr& msg)
+  {
+    statistics_->addReceivedFrame(rclcpp::Time(msg->header.stamp).seconds());
+    if (!camera_info_ || msg->header.frame_id.empty())
+    {
+      statistics_->addSkippedFrame();
+      return;
+    }
+    sensor_frame_ = msg->header.frame_id;
+
+    // The stored calibration is the camera pose w.r.t. the base (eye-to-hand) or end-effector (eye-in-hand)
+    Eigen::Isometry3d camera_robot_pose, effector_wrt_world;
+    try
+    {
+      const std::string& from_frame = setup_ == EYE_IN_HAND ? eef_frame_ : base_frame_;
+      camera_robot_pose =
+          tf2::transformToEigen(tf_buffer_->lookupTransform(from_frame, sensor_frame_, tf2::TimePointZero));
+      effector_wrt_world =
+          tf2::transformToEigen(tf_buffer_->lookupTransform(base_frame_, eef_frame_, msg->header.stamp));
+    }
+    catch (const tf2::TransformException& e)
+    {
+      RCLCPP_WARN_THROTTLE(get_logger(), *get_clock(), 2000, "TF exception: %s", e.what());
+      statistics_->addSkippedFrame();
+      return;
+    }
+
+    if (!camera_robot_pose_valid_ || !camera_robot_pose.isApprox(camera_robot_pose_))
+    {
+      RCLCPP_INFO(get_logger(), "Monitoring calibration from '%s' to '%s'",
+                  (setup_ == EYE_IN_HAND ? eef_frame_ : base_frame_).c_str(), sensor_frame_.c_str());
+      camera_robot_pose_ = camera_robot_pose;
+      camera_robot_pose_valid_ = true;
+      monitor_->setCameraRobotPose(camera_robot_pose_);
+    }
+
+    cv_bridge::CvImagePtr cv_ptr;
+    try
+    {
+      cv_ptr = cv_bridge::toCvCopy(msg, sensor_msgs::image_encodings::MONO8);
+    }
+    catch (const cv_bridge::Exception& e)
+    {
+      RCLCPP_ERROR_THROTTLE(get_logger(), *get_clock(), 2000, "cv_bridge exception: %s", e.what());
+      statistics_->addSkippedFrame();
+      return;
+    }
+
+    bool detected = false;
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    try
+    {
+      detected = target_->detectTargetPose(cv_ptr->image);
+    }
+    catch (const cv::Exception& e)
+    {
+      RCLCPP_ERROR_THROTTLE(get_logger(), *get_clock(), 2000, "cv exception: %s", e.what());
+    }
+    const double latency = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const HandEyeTargetBase::DetectionInfo info = target_->getDetectionInfo();
+    statistics_->addProcessedFrame(detected, latency, info.num_markers, info.reprojection_rms);
+    if (!detected)
+      return;
+
+    const Eigen::Isometry3d object_wrt_sensor =
+        tf2::transformToEigen(target_->getTransformStamped(sensor_frame_, msg->header.stamp).transform);
+    const DriftLevel previous_level = monitor_->getLevel();
+    const DriftLevel level = monitor_->addObservation(effector_wrt_world, object_wrt_sensor);
+    if (level > previous_level)
+      RCLCPP_WARN(get_logger(), "%s: %f m, %f rad", LEVEL_MESSAGES[level].c_str(),
+                  monitor_->getTranslationStatistics().mean, monitor_->getRotationStatistics().mean);
+  }
+
+  void publishDiagnostics()
+  {
+    diagnostic_msgs::msg::DiagnosticStatus status;
+    status.name = std::string(get_name()) + ": Hand-eye calibration drift";
+    status.hardware_id = sensor_frame_;
+    if (!camera_robot_pose_valid_ || monitor_->getNumObservations() == 0)
+    {
+      status.level = diagnostic_msgs::msg::DiagnosticStatus::STALE;
+      status.message = "No observations of the calibration target";
+    }
+    else
+    {
+      const DriftLevel level = monitor_->getLevel();
+      if (level == DRIFT_ERROR)
+        status.level = diagnostic_msgs::msg::DiagnosticStatus::ERROR;
+      else if (level == DRIFT_WARN)
+        status.level = diagnostic_msgs::msg::DiagnosticStatus::WARN;
+      else
+        status.level = diagnostic_msgs::msg::DiagnosticStatus::OK;
+      status.message = LEVEL_MESSAGES[level];
+    }
+
+    const DriftStatistics& translation = monitor_->getTranslationStatistics();
+    const DriftStatistics& rotation = monitor_->getRotationStatistics();
+    status.values.push_back(makeKeyValue("observations", std::to_string(monitor_->getNumObservations())));
+    status.values.push_back(makeKeyValue("translation mean (m)", std::to_string(translation.mean)));
+    status.values.push_back(makeKeyValue("translation stddev (m)", std::to_string(std::sqrt(translation.variance))));
+    status.values.push_back(makeKeyValue("translation last (m)", std::to_string(translation.last)));
+    status.values.push_back(makeKeyValue("translation max (m)", std::to_string(translation.max)));
+    status.values.push_back(makeKeyValue("rotation mean (rad)", std::to_string(rotation.mean)));
+    status.values.push_back(makeKeyValue("rotation stddev (rad)", std::to_string(std::sqrt(rotation.variance))));
+    status.values.push_back(makeKeyValue("rotation last (rad)", std::to_string(rotation.last)));
+    status.values.push_back(makeKeyValue("rotation max (rad)", std::to_string(rotation.max)));
+
+    diagnostic_msgs::msg::DiagnosticArray array;
+    array.header.stamp = now();
+    array.status.push_back(status);
+    array.status.push_back(getDetectionDiagnostics(
+        statistics_->getSummary(), std::string(get_name()) + ": Hand-eye target detection", sensor_frame_));
+    diagnostic_pub_->publish(array);
+  }
+
+  SensorMountType setup_;
+  std::string base_frame_;
+  std::string eef_frame_;
+  std::string sensor_frame_;
+
+  std::unique_ptr<HandEyeDriftMonitor> monitor_;
+  std::unique_ptr<HandEyeDetectionStatistics> statistics_;
+  Eigen::Isometry3d camera_robot_pose_;
+  bool camera_robot_pose_valid_ = false;
+
+  std::unique_ptr<pluginlib::ClassLoader<HandEyeTargetBase>> target_loader_;
+  pluginlib::UniquePtr<HandEyeTargetBase> target_;
+  rclcpp::node_interfaces::OnSetParametersCallbackHandle::SharedPtr target_params_callback_;
+  sensor_msgs::msg::CameraInfo::ConstSharedPtr camera_info_;
+
+  std::shared_ptr<tf2_ros::Buffer> tf_buffer_;
+  std::shared_ptr<tf2_ros::TransformListener> tf_listener_;
+  rclcpp::Publisher<diagnostic_msgs::msg::DiagnosticArray>::SharedPtr diagnostic_pub_;
+  rclcpp::Subscription<sensor_msgs::msg::CameraInfo>::SharedPtr camera_info_sub_;
+  rclcpp::Subscription<sensor_msgs::msg::Image>::SharedPtr image_sub_;
+  rclcpp::TimerBase::SharedPtr diagnostic_timer_;
+};
+
+}  // namespace moveit_handeye_calibration
+
+int main(int argc, char** argv)
+{
+  rclcpp::init(argc, argv);
+  rclcpp::spin(std::make_shared<moveit_handeye_calibration::HandEyeDriftMonitorNode>());
+  rclcpp::shutdown();
+  return 0;
+}
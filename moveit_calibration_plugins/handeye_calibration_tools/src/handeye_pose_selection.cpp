@@ -0,0 +1,154 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt Calibration contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <moveit/handeye_calibration_tools/handeye_pose_selection.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <thread>
+
+namespace moveit_handeye_calibration
+{
+NextPoseSelector::NextPoseSelector(SensorMountType setup, MotionPairMode mode) : setup_(setup), mode_(mode)
+{
+  setSamples({});
+}
+
+void NextPoseSelector::setSamples(const std::vector<Eigen::Isometry3d>& effector_wrt_world)
+{
+  effector_wrt_world_ = effector_wrt_world;
+  rotation_information_ = PRIOR_INFORMATION * Eigen::Matrix3d::Identity();
+  translation_information_ = PRIOR_INFORMATION * Eigen::Matrix3d::Identity();
+  for (const std::pair<std::size_t, std::size_t>& pair :
+       HandEyeSolverBase::getMotionPairs(effector_wrt_world_, setup_, mode_))
+    addMotion(HandEyeSolverBase::getRobotMotion(effector_wrt_world_, pair.first, pair.second, setup_),
+              rotation_information_, translation_information_);
+  log_determinant_ = getLogDeterminant(rotation_information_, translation_information_);
+}
+
+void NextPoseSelector::addMotion(const Eigen::Isometry3d& motion, Eigen::Matrix3d& rotation_information,
+                                 Eigen::Matrix3d& translation_information) const
+{
+  // The rotation axis constrains the rotation of X only perpendicular to itself, and the translation of X is
+  // observed through (R_A - I) t_X = R_X t_B - t_A
+  const Eigen::AngleAxisd angle_axis(motion.linear());
+  const Eigen::Vector3d rotation = angle_axis.angle() * angle_axis.axis();
+  rotation_information += rotation.squaredNorm() * Eigen::Matrix3d::Identity() - rotation * rotation.transpose();
+  const Eigen::Matrix3d lever = motion.linear() - Eigen::Matrix3d::Identity();
+  translation_information += lever.transpose() * lever;
+}
+
+double NextPoseSelector::getLogDeterminant(const Eigen::Matrix3d& rotation_information,
+                                           const Eigen::Matrix3d& translation_information) const
+{
+  return std::log(rotation_information.determinant()) + std::log(translation_information.determinant());
+}
+
+double NextPoseSelector::getLogDeterminant() const
+{
+  return log_determinant_;
+}
+
+double NextPoseSelector::getInformationGain(const Eigen::Isometry3d& candidate) const
+{
+  if (effector_wrt_world_.empty())
+    return 0.;
+
+  // The candidate is appended as the last sample, so only its own motion pairs are added. Selected pairs are drawn
+  // from all pairs, so they are approximated by all pairs.
+  std::vector<Eigen::Isometry3d> effector_wrt_world = { Eigen::Isometry3d::Identity(), candidate };
+  Eigen::Matrix3d rotation_information = rotation_information_;
+  Eigen::Matrix3d translation_information = translation_information_;
+  const std::size_t first = mode_ == CONSECUTIVE_PAIRS ? effector_wrt_world_.size() - 1 : 0;
+  for (std::size_t i = first; i < effector_wrt_world_.size(); ++i)
+  {
+    effector_wrt_world[0] = effector_wrt_world_[i];
+    addMotion(HandEyeSolverBase::getRobotMotion(effector_wrt_world, 0, 1, setup_), rotation_information,
+              translation_information);
+  }
+  return getLogDeterminant(rotation_information, translation_information) - log_determinant_;
+}
+
+std::vector<double> NextPoseSelector::getInformationGains(const std::vector<Eigen::Isometry3d>& candidates,
+                                                          std::size_t num_threads) const
+{
+  std::vector<double> gains(candidates.size(), 0.);
+  if (num_threads == 0)
+    num_threads = std::max(1u, std::thread::hardware_concurrency());
+  num_threads = std::min(num_threads, candidates.size());
+
+  std::atomic<std::size_t> next_candidate(0);
+  auto worker = [&]() {
+    for (std::size_t k = next_candidate++; k < candidates.size(); k = next_candidate++)
+      gains[k] = getInformationGain(candidates[k]);
+  };
+
+  std::vector<std::thread> threads;
+  for (std::size_t t = 1; t < num_threads; ++t)
+    threads.emplace_back(worker);
+  worker();
+  for (std::thread& thread : threads)
+    thread.join();
+  return gains;
+}
+
+std::size_t NextPoseSelector::selectNextPose(const std::vector<Eigen::Isometry3d>& candidates, double* gain,
+                                             std::size_t num_threads) const
+{
+  const std::vector<double> gains = getInformationGains(candidates, num_threads);
+  const std::size_t best = std::max_element(gains.begin(), gains.end()) - gains.begin();
+  if (gain && best < gains.size())
+    *gain = gains[best];
+  return best;
+}
+
+std::size_t selectNextRecordedPose(SensorMountType setup, MotionPairMode mode,
+                                   const std::vector<Eigen::Isometry3d>& samples,
+                                   const std::vector<Eigen::Isometry3d>& remaining, std::size_t first, double* gain)
+{
+  if (gain)
+    *gain = 0.;
+  if (samples.size() + first == 0 || first + 1 >= remaining.size())
+    return first;
+
+  std::vector<Eigen::Isometry3d> planned_samples = samples;
+  planned_samples.insert(planned_samples.end(), remaining.begin(), remaining.begin() + first);
+  NextPoseSelector selector(setup, mode);
+  selector.setSamples(planned_samples);
+  return first + selector.selectNextPose(std::vector<Eigen::Isometry3d>(remaining.begin() + first, remaining.end()),
+                                         gain);
+}
+
+}  // namespace moveit_handeye_calibration
@@ -0,0 +1,136 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt Calibration contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <moveit/handeye_calibration_tools/handeye_rotation_index.h>
+
+#include <cmath>
+
+namespace moveit_handeye_calibration
+{
+namespace
+{
+Eigen::Vector4d getQuaternion(const Eigen::Matrix3d& rotation)
+{
+  Eigen::Quaterniond q(rotation);
+  q.normalize();
+  if (q.w() < 0.)
+    q.coeffs() = -q.coeffs();
+  return q.coeffs();
+}
+}  // namespace
+
+RotationIndex::RotationIndex(double min_angle)
+{
+  // Two unit quaternions at angle theta have dot product cos(theta / 2) and distance 2 sin(theta / 4)
+  min_dot_ = std::cos(min_angle / 2.);
+  cell_size_ = std::max(2. * std::sin(min_angle / 4.), 1e-6);
+}
+
+std::size_t RotationIndex::CellKeyHash::operator()(const CellKey& key) const
+{
+  std::size_t hash = 0;
+  for (int k : key)
+    hash = hash * 1000003u ^ std::hash<int>()(k);
+  return hash;
+}
+
+RotationIndex::CellKey RotationIndex::getCellKey(const Eigen::Vector4d& quaternion) const
+{
+  CellKey key;
+  for (std::size_t i = 0; i < 4; ++i)
+    key[i] = static_cast<int>(std::floor(quaternion[i] / cell_size_));
+  return key;
+}
+
+void RotationIndex::insert(const Eigen::Matrix3d& rotation)
+{
+  const Eigen::Vector4d q = getQuaternion(rotation);
+  const CellKey key = getCellKey(q);
+  cells_[key].push_back(quaternions_.size());
+  quaternions_.push_back(q);
+  keys_.push_back(key);
+}
+
+bool RotationIndex::hasNeighbor(const Eigen::Matrix3d& rotation) const
+{
+  const Eigen::Vector4d q = getQuaternion(rotation);
+
+  // q and -q are the same rotation, so neighbors are searched around both
+  for (double sign : { 1., -1. })
+  {
+    const CellKey center = getCellKey(sign * q);
+    CellKey key;
+    for (int offset = 0; offset < 81; ++offset)
+    {
+      int remainder = offset;
+      for (std::size_t i = 0; i < 4; ++i, remainder /= 3)
+        key[i] = center[i] + remainder % 3 - 1;
+
+      auto cell = cells_.find(key);
+      if (cell == cells_.end())
+        continue;
+      for (std::size_t index : cell->second)
+        if (std::abs(quaternions_[index].dot(q)) > min_dot_)
+          return true;
+    }
+  }
+  return false;
+}
+
+void RotationIndex::removeLast()
+{
+  if (quaternions_.empty())
+    return;
+
+  auto cell = cells_.find(keys_.back());
+  cell->second.pop_back();
+  if (cell->second.empty())
+    cells_.erase(cell);
+  quaternions_.pop_back();
+  keys_.pop_back();
+}
+
+void RotationIndex::clear()
+{
+  quaternions_.clear();
+  keys_.clear();
+  cells_.clear();
+}
+
+std::size_t RotationIndex::size() const
+{
+  return quaternions_.size();
+}
+
+}  // namespace moveit_handeye_calibration
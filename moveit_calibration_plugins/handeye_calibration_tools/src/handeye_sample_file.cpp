@@ -0,0 +1,287 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt Calibration contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <moveit/handeye_calibration_tools/handeye_sample_file.h>
+
+#include <cstring>
+#include <fstream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace moveit_handeye_calibration
+{
+constexpr char SampleFileHeader::MAGIC[8];
+constexpr std::uint32_t SampleFileHeader::BYTE_ORDER_MARK;
+constexpr std::uint32_t SampleFileHeader::VERSION;
+constexpr std::uint32_t SampleFileHeader::HAS_JOINT_STATES;
+constexpr std::uint32_t SampleFileHeader::HAS_STAMPS;
+
+namespace
+{
+static_assert(sizeof(SampleFileHeader) % sizeof(double) == 0, "Sample file header must keep the values aligned");
+
+bool setError(std::string* error_message, const std::string& message)
+{
+  if (error_message)
+    *error_message = message;
+  return false;
+}
+
+void writeMatrices(std::ofstream& file, const std::vector<Eigen::Isometry3d>& poses)
+{
+  for (const Eigen::Isometry3d& pose : poses)
+  {
+    const Eigen::Matrix<double, 4, 4, Eigen::RowMajor> matrix = pose.matrix();
+    file.write(reinterpret_cast<const char*>(matrix.data()), sizeof(double) * 16);
+  }
+}
+}  // namespace
+
+bool writeSampleFile(const std::string& file_name, const SampleSet& samples, std::string* error_message)
+{
+  const std::size_t num_samples = samples.effector_wrt_world.size();
+  if (samples.object_wrt_sensor.size() != num_samples)
+    return setError(error_message, "Different number of end-effector and object poses");
+  if (!samples.joint_states.empty() && samples.joint_states.size() != num_samples)
+    return setError(error_message, "Number of joint states doesn't match the number of samples");
+  for (const std::vector<double>& joint_state : samples.joint_states)
+    if (joint_state.size() != samples.joint_names.size())
+      return setError(error_message, "Joint state doesn't match the joint names");
+  if (!samples.stamps.empty() && samples.stamps.size() != num_samples)
+    return setError(error_message, "Number of stamps doesn't match the number of samples");
+
+  std::string joint_names;
+  for (const std::string& name : samples.joint_names)
+    joint_names += name + '\0';
+  joint_names.resize((joint_names.size() + sizeof(double) - 1) / sizeof(double) * sizeof(double), '\0');
+
+  SampleFileHeader header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, SampleFileHeader::MAGIC, sizeof(header.magic));
+  header.byte_order = SampleFileHeader::BYTE_ORDER_MARK;
+  header.version = SampleFileHeader::VERSION;
+  header.flags = (samples.joint_states.empty() ? 0 : SampleFileHeader::HAS_JOINT_STATES) |
+                 (samples.stamps.empty() ? 0 : SampleFileHeader::HAS_STAMPS);
+  header.num_samples = num_samples;
+  header.num_joints = samples.joint_names.size();
+  header.joint_names_size = joint_names.size();
+
+  std::ofstream file(file_name, std::ios::binary | std::ios::trunc);
+  if (!file)
+    return setError(error_message, "Unable to open file: " + file_name);
+
+  file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  file.write(joint_names.data(), joint_names.size());
+  writeMatrices(file, samples.effector_wrt_world);
+  writeMatrices(file, samples.object_wrt_sensor);
+  for (const std::vector<double>& joint_state : samples.joint_states)
+    file.write(reinterpret_cast<const char*>(joint_state.data()), sizeof(double) * joint_state.size());
+  file.write(reinterpret_cast<const char*>(samples.stamps.data()), sizeof(double) * samples.stamps.size());
+
+  if (!file)
+    return setError(error_message, "Unable to write file: " + file_name);
+  return true;
+}
+
+bool readSampleFile(const std::string& file_name, SampleSet& samples, std::string* error_message)
+{
+  MappedSampleFile file;
+  if (!file.open(file_name, error_message))
+    return false;
+
+  const std::size_t num_samples = file.size();
+  samples.joint_names = file.getJointNames();
+  samples.effector_wrt_world.resize(num_samples);
+  samples.object_wrt_sensor.resize(num_samples);
+  samples.joint_states.clear();
+  samples.stamps.clear();
+  for (std::size_t i = 0; i < num_samples; ++i)
+  {
+    samples.effector_wrt_world[i].matrix() = file.getEffectorWrtWorld(i);
+    samples.object_wrt_sensor[i].matrix() = file.getObjectWrtSensor(i);
+    if (file.hasJointStates())
+      samples.joint_states.emplace_back(file.getJointState(i), file.getJointState(i) + samples.joint_names.size());
+    if (file.hasStamps())
+      samples.stamps.push_back(file.getStamp(i));
+  }
+  return true;
+}
+
+MappedSampleFile::~MappedSampleFile()
+{
+  close();
+}
+
+bool MappedSampleFile::open(const std::string& file_name, std::string* error_message)
+{
+  close();
+
+  const int fd = ::open(file_name.c_str(), O_RDONLY);
+  if (fd < 0)
+    return setError(error_message, "Unable to open file: " + file_name);
+
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0 || static_cast<std::size_t>(file_stat.st_size) < sizeof(SampleFileHeader))
+  {
+    ::close(fd);
+    return setError(error_message, "Not a sample file: " + file_name);
+  }
+
+  data_size_ = file_stat.st_size;
+  data_ = mmap(nullptr, data_size_, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (data_ == MAP_FAILED)
+  {
+    data_ = nullptr;
+    data_size_ = 0;
+    return setError(error_message, "Unable to map file: " + file_name);
+  }
+
+  const char* data = static_cast<const char*>(data_);
+  std::memcpy(&header_, data, sizeof(header_));
+  if (std::memcmp(header_.magic, SampleFileHeader::MAGIC, sizeof(header_.magic)) != 0)
+  {
+    close();
+    return setError(error_message, "Not a sample file: " + file_name);
+  }
+  if (header_.byte_order != SampleFileHeader::BYTE_ORDER_MARK)
+  {
+    close();
+    return setError(error_message, "Sample file was written with a different byte order: " + file_name);
+  }
+  if (header_.version != SampleFileHeader::VERSION)
+  {
+    close();
+    return setError(error_message, "Unsupported sample file version " + std::to_string(header_.version));
+  }
+
+  // Check the size before pointing into the data, so a truncated file is never read past its end
+  const std::uint64_t num_samples = header_.num_samples;
+  if (num_samples > data_size_ / (32 * sizeof(double)) || header_.num_joints > data_size_)
+  {
+    close();
+    return setError(error_message, "Corrupted sample file: " + file_name);
+  }
+  const std::uint64_t num_values =
+      num_samples * 32 + (header_.flags & SampleFileHeader::HAS_JOINT_STATES ? num_samples * header_.num_joints : 0) +
+      (header_.flags & SampleFileHeader::HAS_STAMPS ? num_samples : 0);
+  if (header_.joint_names_size % sizeof(double) != 0 ||
+      data_size_ != sizeof(SampleFileHeader) + header_.joint_names_size + num_values * sizeof(double))
+  {
+    close();
+    return setError(error_message, "Corrupted sample file: " + file_name);
+  }
+
+  const char* names = data + sizeof(SampleFileHeader);
+  const char* names_end = names + header_.joint_names_size;
+  while (names < names_end && *names != '\0')
+  {
+    joint_names_.emplace_back(names, strnlen(names, names_end - names));
+    names += joint_names_.back().size() + 1;
+  }
+  if (joint_names_.size() != header_.num_joints)
+  {
+    close();
+    return setError(error_message, "Corrupted sample file: " + file_name);
+  }
+
+  effector_wrt_world_ = reinterpret_cast<const double*>(names_end);
+  object_wrt_sensor_ = effector_wrt_world_ + num_samples * 16;
+  const double* next = object_wrt_sensor_ + num_samples * 16;
+  if (header_.flags & SampleFileHeader::HAS_JOINT_STATES)
+  {
+    joint_states_ = next;
+    next += num_samples * header_.num_joints;
+  }
+  if (header_.flags & SampleFileHeader::HAS_STAMPS)
+    stamps_ = next;
+  return true;
+}
+
+void MappedSampleFile::close()
+{
+  if (data_)
+    munmap(data_, data_size_);
+  data_ = nullptr;
+  data_size_ = 0;
+  joint_names_.clear();
+  effector_wrt_world_ = nullptr;
+  object_wrt_sensor_ = nullptr;
+  joint_states_ = nullptr;
+  stamps_ = nullptr;
+}
+
+std::size_t MappedSampleFile::size() const
+{
+  return data_ ? header_.num_samples : 0;
+}
+
+const std::vector<std::string>& MappedSampleFile::getJointNames() const
+{
+  return joint_names_;
+}
+
+bool MappedSampleFile::hasJointStates() const
+{
+  return joint_states_ != nullptr;
+}
+
+bool MappedSampleFile::hasStamps() const
+{
+  return stamps_ != nullptr;
+}
+
+MappedSampleFile::MatrixMap MappedSampleFile::getEffectorWrtWorld(std::size_t i) const
+{
+  return MatrixMap(effector_wrt_world_ + i * 16);
+}
+
+MappedSampleFile::MatrixMap MappedSampleFile::getObjectWrtSensor(std::size_t i) const
+{
+  return MatrixMap(object_wrt_sensor_ + i * 16);
+}
+
+const double* MappedSampleFile::getJointState(std::size_t i) const
+{
+  return joint_states_ ? joint_states_ + i * joint_names_.size() : nullptr;
+}
+
+double MappedSampleFile::getStamp(std::size_t i) const
+{
+  return stamps_ ? stamps_[i] : 0.;
+}
+
+}  // namespace moveit_handeye_calibration
@@ -0,0 +1,103 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt Calibration contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <algorithm>
+#include <moveit/handeye_calibration_tools/handeye_sample_stream.h>
+#include <tf2/exceptions.h>
+#include <tf2_eigen/tf2_eigen.hpp>
+
+namespace moveit_handeye_calibration
+{
+namespace
+{
+tf2::TimePoint getTimePoint(const builtin_interfaces::msg::Time& stamp)
+{
+  return tf2::TimePoint(std::chrono::seconds(stamp.sec) + std::chrono::nanoseconds(stamp.nanosec));
+}
+}  // namespace
+
+void SampleStreamFilter::start(const SampleStreamFrames& frames, const tf2::TimePoint& start_time,
+                               const SampleStreamLimits& limits)
+{
+  frames_ = frames;
+  limits_ = limits;
+  last_stamp_ = start_time;
+}
+
+StreamStatus SampleStreamFilter::poll(const tf2::BufferCore& buffer,
+                                      geometry_msgs::msg::TransformStamped& camera_to_object,
+                                      geometry_msgs::msg::TransformStamped& base_to_eef, std::string* error_message)
+{
+  // The object transform is only updated on detection, there is none before the target was first seen
+  if (!buffer.canTransform(frames_.sensor, frames_.object, tf2::TimePointZero))
+    return STREAM_NO_DETECTION;
+
+  try
+  {
+    camera_to_object = buffer.lookupTransform(frames_.sensor, frames_.object, tf2::TimePointZero);
+    const tf2::TimePoint stamp = getTimePoint(camera_to_object.header.stamp);
+    if (stamp <= last_stamp_)
+      return STREAM_NO_DETECTION;
+
+    // Retry on the next poll if the robot state at the capture time has not been received yet
+    if (!buffer.canTransform(frames_.base, frames_.effector, stamp))
+      return STREAM_WAITING;
+    base_to_eef = buffer.lookupTransform(frames_.base, frames_.effector, stamp);
+
+    // Reject detections during fast motion, which suffer from motion blur and residual timing errors
+    const Eigen::Isometry3d prior_base_to_eef = tf2::transformToEigen(buffer.lookupTransform(
+        frames_.base, frames_.effector, stamp - tf2::durationFromSec(limits_.velocity_window)));
+    const Eigen::Isometry3d motion = prior_base_to_eef.inverse() * tf2::transformToEigen(base_to_eef);
+    if (Eigen::AngleAxisd(motion.rotation()).angle() > limits_.max_angular_velocity * limits_.velocity_window ||
+        motion.translation().norm() > limits_.max_linear_velocity * limits_.velocity_window)
+    {
+      last_stamp_ = stamp;
+      return STREAM_FAST_MOTION;
+    }
+    return STREAM_NEW_SAMPLE;
+  }
+  catch (const tf2::TransformException& e)
+  {
+    if (error_message)
+      *error_message = e.what();
+    return STREAM_LOOKUP_FAILED;
+  }
+}
+
+void SampleStreamFilter::markProcessed(const geometry_msgs::msg::TransformStamped& camera_to_object)
+{
+  last_stamp_ = std::max(last_stamp_, getTimePoint(camera_to_object.header.stamp));
+}
+
+}  // namespace moveit_handeye_calibration
@@ -0,0 +1,344 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt Calibration contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <moveit/handeye_calibration_target/handeye_target_base.h>
+#include <moveit/handeye_calibration_tools/handeye_rotation_index.h>
+#include <moveit/handeye_calibration_tools/handeye_session.h>
+#include <moveit/handeye_calibration_tools/handeye_target_parameters.h>
+
+#include <atomic>
+#include <thread>
+#include <cv_bridge/cv_bridge.h>
+#include <pluginlib/class_loader.hpp>
+#include <rclcpp/serialization.hpp>
+#include <rosbag2_cpp/reader.hpp>
+#include <rosbag2_cpp/writer.hpp>
+#include <rosbag2_storage/storage_options.hpp>
+#include <sensor_msgs/image_encodings.hpp>
+#include <sensor_msgs/msg/image.hpp>
+#include <std_msgs/msg/header.hpp>
+#include <tf2_eigen/tf2_eigen.hpp>
+#include <tf2_msgs/msg/tf_message.hpp>
+
+namespace moveit_handeye_calibration
+{
+namespace
+{
+const double VELOCITY_WINDOW = 0.05;  // Time window for estimating the end-effector velocity, in s
+
+template <typename T>
+T deserialize(const rosbag2_storage::SerializedBagMessage& bag_message)
+{
+  T msg;
+  rclcpp::SerializedMessage serialized(*bag_message.serialized_data);
+  rclcpp::Serialization<T>().deserialize_message(&serialized, &msg);
+  return msg;
+}
+
+// Messages are serialized field by field, so the header of a message that starts with one is read without the rest,
+// e.g. without copying the image data
+std_msgs::msg::Header deserializeHeader(const rosbag2_storage::SerializedBagMessage& bag_message)
+{
+  return deserialize<std_msgs::msg::Header>(bag_message);
+}
+}  // namespace
+
+HandEyeSessionRecorder::HandEyeSessionRecorder(const rclcpp::NodeOptions& options)
+  : Node("handeye_session_recorder", options)
+{
+  rosbag2_storage::StorageOptions storage_options;
+  storage_options.uri = declare_parameter<std::string>("output", "handeye_session");
+  storage_options.storage_id = declare_parameter<std::string>("storage_id", "mcap");
+  const std::string image_topic = declare_parameter<std::string>("image_topic", "image");
+  const std::string camera_info_topic = declare_parameter<std::string>("camera_info_topic", "camera_info");
+  const std::string joint_states_topic = declare_parameter<std::string>("joint_states_topic", "joint_states");
+
+  writer_ = std::make_unique<rosbag2_cpp::Writer>();
+  writer_->open(storage_options);
+
+  // Topics are recorded under their resolved names, which the loader looks up
+  record(image_topic, "sensor_msgs/msg/Image", rclcpp::SensorDataQoS());
+  record(camera_info_topic, "sensor_msgs/msg/CameraInfo", rclcpp::SensorDataQoS());
+  record(joint_states_topic, "sensor_msgs/msg/JointState", rclcpp::QoS(100));
+  record("/tf", "tf2_msgs/msg/TFMessage", rclcpp::QoS(100));
+  record("/tf_static", "tf2_msgs/msg/TFMessage", rclcpp::QoS(100).transient_local());
+  RCLCPP_INFO(get_logger(), "Recording calibration session to '%s'", storage_options.uri.c_str());
+}
+
+HandEyeSessionRecorder::~HandEyeSessionRecorder()
+{
+  // Stop receiving before the writer is closed
+  subscriptions_.clear();
+  writer_.reset();
+}
+
+void HandEyeSessionRecorder::record(const std::string& topic, const std::string& type, const rclcpp::QoS& qos)
+{
+  const std::string resolved_topic = get_node_topics_interface()->resolve_topic_name(topic);
+  subscriptions_.push_back(create_generic_subscription(
+      resolved_topic, type, qos, [this, resolved_topic, type](std::shared_ptr<const rclcpp::SerializedMessage> msg) {
+        writer_->write(msg, resolved_topic, type, now());
+      }));
+}
+
+HandEyeSessionLoader::HandEyeSessionLoader(const rclcpp::Node::SharedPtr& node) : node_(node)
+{
+  auto resolve_topic = [this](const std::string& topic) {
+    return node_->get_node_topics_interface()->resolve_topic_name(topic);
+  };
+  storage_id_ = node_->declare_parameter<std::string>("storage_id", "");
+  image_topic_ = resolve_topic(node_->declare_parameter<std::string>("image_topic", "image"));
+  camera_info_topic_ = resolve_topic(node_->declare_parameter<std::string>("camera_info_topic", "camera_info"));
+  target_type_ = node_->declare_parameter<std::string>("target_type", "HandEyeTarget/Aruco");
+  base_frame_ = node_->declare_parameter<std::string>("robot_base_frame", "base_link");
+  eef_frame_ = node_->declare_parameter<std::string>("end_effector_frame", "tool0");
+  min_rotation_ = node_->declare_parameter<double>("min_rotation", M_PI / 36.);
+  max_angular_velocity_ = node_->declare_parameter<double>("max_angular_velocity", 0.5);
+  max_linear_velocity_ = node_->declare_parameter<double>("max_linear_velocity", 0.1);
+  num_threads_ = node_->declare_parameter<int>("threads", 0);
+  undistort_image_ = node_->declare_parameter<bool>("undistort_image", false);
+}
+
+bool HandEyeSessionLoader::load(const std::string& uri)
+{
+  tf_buffer_.reset();
+  camera_info_.reset();
+  image_stamps_.clear();
+  sample_stamps_.clear();
+  samples_ = SampleSet();
+  return readSession(uri) && selectSamples() && detectTargets(uri);
+}
+
+const SampleSet& HandEyeSessionLoader::getSamples() const
+{
+  return samples_;
+}
+
+const std::string& HandEyeSessionLoader::getSensorFrame() const
+{
+  return sensor_frame_;
+}
+
+const std::string& HandEyeSessionLoader::getRobotBaseFrame() const
+{
+  return base_frame_;
+}
+
+const std::string& HandEyeSessionLoader::getEndEffectorFrame() const
+{
+  return eef_frame_;
+}
+
+bool HandEyeSessionLoader::readSession(const std::string& uri)
+{
+  rosbag2_storage::StorageOptions storage_options;
+  storage_options.uri = uri;
+  storage_options.storage_id = storage_id_;
+  rosbag2_cpp::Reader reader;
+  try
+  {
+    reader.open(storage_options);
+  }
+  catch (const std::exception& ex)
+  {
+    RCLCPP_ERROR(node_->get_logger(), "Failed to open session '%s': %s", uri.c_str(), ex.what());
+    return false;
+  }
+  const double duration = std::chrono::duration<double>(reader.get_metadata().duration).count();
+  tf_buffer_ = std::make_unique<tf2::BufferCore>(tf2::durationFromSec(duration + 1.));
+
+  while (reader.has_next())
+  {
+    std::shared_ptr<rosbag2_storage::SerializedBagMessage> bag_message = reader.read_next();
+    if (bag_message->topic_name == "/tf" || bag_message->topic_name == "/tf_static")
+    {
+      const bool is_static = bag_message->topic_name == "/tf_static";
+      for (const geometry_msgs::msg::TransformStamped& transform :
+           deserialize<tf2_msgs::msg::TFMessage>(*bag_message).transforms)
+        tf_buffer_->setTransform(transform, "session", is_static);
+    }
+    else if (bag_message->topic_name == camera_info_topic_ && !camera_info_)
+    {
+      camera_info_ =
+          std::make_shared<sensor_msgs::msg::CameraInfo>(deserialize<sensor_msgs::msg::CameraInfo>(*bag_message));
+    }
+    else if (bag_message->topic_name == image_topic_)
+    {
+      const std_msgs::msg::Header header = deserializeHeader(*bag_message);
+      sensor_frame_ = header.frame_id;
+      image_stamps_.push_back(rclcpp::Time(header.stamp).nanoseconds());
+    }
+  }
+
+  if (!camera_info_ || image_stamps_.empty())
+  {
+    RCLCPP_ERROR(node_->get_logger(), "No images or camera info found in '%s'", uri.c_str());
+    return false;
+  }
+  RCLCPP_INFO(node_->get_logger(), "Read %zu images over %.1f s", image_stamps_.size(), duration);
+  return true;
+}
+
+bool HandEyeSessionLoader::selectSamples()
+{
+  std::sort(image_stamps_.begin(), image_stamps_.end());
+  RotationIndex rotation_index(min_rotation_);
+  for (int64_t stamp : image_stamps_)
+  {
+    Eigen::Isometry3d effector_wrt_world, effector_before;
+    try
+    {
+      const tf2::TimePoint time{ std::chrono::nanoseconds(stamp) };
+      effector_wrt_world = tf2::transformToEigen(tf_buffer_->lookupTransform(base_frame_, eef_frame_, time));
+      effector_before = tf2::transformToEigen(
+          tf_buffer_->lookupTransform(base_frame_, eef_frame_, time - tf2::durationFromSec(VELOCITY_WINDOW)));
+    }
+    catch (const tf2::TransformException&)
+    {
+      continue;
+    }
+
+    const Eigen::Isometry3d motion = effector_before.inverse() * effector_wrt_world;
+    if (Eigen::AngleAxisd(motion.rotation()).angle() > max_angular_velocity_ * VELOCITY_WINDOW ||
+        motion.translation().norm() > max_linear_velocity_ * VELOCITY_WINDOW ||
+        rotation_index.hasNeighbor(effector_wrt_world.rotation()))
+      continue;
+
+    rotation_index.insert(effector_wrt_world.rotation());
+    sample_stamps_.push_back(stamp);
+    samples_.effector_wrt_world.push_back(effector_wrt_world);
+  }
+
+  RCLCPP_INFO(node_->get_logger(), "Selected %zu sample images", sample_stamps_.size());
+  return !sample_stamps_.empty();
+}
+
+bool HandEyeSessionLoader::detectTargets(const std::string& uri)
+{
+  std::vector<sensor_msgs::msg::Image::ConstSharedPtr> images(sample_stamps_.size());
+  rosbag2_storage::StorageOptions storage_options;
+  storage_options.uri = uri;
+  storage_options.storage_id = storage_id_;
+  rosbag2_cpp::Reader reader;
+  reader.open(storage_options);
+  while (reader.has_next())
+  {
+    std::shared_ptr<rosbag2_storage::SerializedBagMessage> bag_message = reader.read_next();
+    if (bag_message->topic_name != image_topic_)
+      continue;
+    const int64_t stamp = rclcpp::Time(deserializeHeader(*bag_message).stamp).nanoseconds();
+    auto it = std::lower_bound(sample_stamps_.begin(), sample_stamps_.end(), stamp);
+    if (it != sample_stamps_.end() && *it == stamp)
+      images[it - sample_stamps_.begin()] =
+          std::make_shared<sensor_msgs::msg::Image>(deserialize<sensor_msgs::msg::Image>(*bag_message));
+  }
+
+  std::size_t num_threads = num_threads_ > 0 ? num_threads_ : std::max(1u, std::thread::hardware_concurrency());
+  num_threads = std::min(num_threads, images.size());
+
+  // Plugin loading is not thread safe, so the targets are created up front
+  pluginlib::ClassLoader<HandEyeTargetBase> target_loader("moveit_calibration_plugins",
+                                                          "moveit_handeye_calibration::HandEyeTargetBase");
+  std::vector<pluginlib::UniquePtr<HandEyeTargetBase>> targets;
+  for (std::size_t t = 0; t < num_threads; ++t)
+  {
+    try
+    {
+      targets.push_back(target_loader.createUniqueInstance(target_type_));
+    }
+    catch (const pluginlib::PluginlibException& ex)
+    {
+      RCLCPP_ERROR(node_->get_logger(), "Failed to create handeye target %s: %s", target_type_.c_str(), ex.what());
+      return false;
+    }
+    declareTargetParameters(*node_, *targets.back());
+    targets.back()->setUndistortImage(undistort_image_);
+    if (!targets.back()->initialize() || !targets.back()->setCameraIntrinsicParams(camera_info_))
+    {
+      RCLCPP_ERROR(node_->get_logger(), "Failed to initialize handeye target %s", target_type_.c_str());
+      return false;
+    }
+  }
+
+  std::vector<Eigen::Isometry3d> object_wrt_sensor(images.size());
+  std::vector<char> detected(images.size(), false);
+  std::atomic<std::size_t> next_image(0);
+  auto worker = [&](HandEyeTargetBase* target) {
+    for (std::size_t i = next_image++; i < images.size(); i = next_image++)
+    {
+      if (!images[i])
+        continue;
+      try
+      {
+        cv_bridge::CvImagePtr cv_ptr = cv_bridge::toCvCopy(images[i], sensor_msgs::image_encodings::MONO8);
+        if (!target->detectTargetPose(cv_ptr->image))
+          continue;
+      }
+      catch (const std::exception&)
+      {
+        continue;
+      }
+      object_wrt_sensor[i] = tf2::transformToEigen(
+          target->getTransformStamped(sensor_frame_, images[i]->header.stamp).transform);
+      detected[i] = true;
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (std::size_t t = 1; t < num_threads; ++t)
+    threads.emplace_back(worker, targets[t].get());
+  worker(targets[0].get());
+  for (std::thread& thread : threads)
+    thread.join();
+
+  // Keep the samples in which the target was detected
+  std::size_t num_samples = 0;
+  for (std::size_t i = 0; i < images.size(); ++i)
+  {
+    if (!detected[i])
+      continue;
+    sample_stamps_[num_samples] = sample_stamps_[i];
+    samples_.effector_wrt_world[num_samples] = samples_.effector_wrt_world[i];
+    samples_.object_wrt_sensor.push_back(object_wrt_sensor[i]);
+    ++num_samples;
+  }
+  sample_stamps_.resize(num_samples);
+  samples_.effector_wrt_world.resize(num_samples);
+  for (int64_t stamp : sample_stamps_)
+    samples_.stamps.push_back(rclcpp::Time(stamp).seconds());
+  RCLCPP_INFO(node_->get_logger(), "Detected the target in %zu of %zu sample images", num_samples, images.size());
+  return num_samples > 0;
+}
+
+}  // namespace moveit_handeye_calibration
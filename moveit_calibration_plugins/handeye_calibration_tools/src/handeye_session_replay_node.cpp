@@ -0,0 +1,145 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt Calibration contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <moveit/handeye_calibration_solver/handeye_solver_base.h>
+#include <moveit/handeye_calibration_tools/handeye_session.h>
+
+#include <pluginlib/class_loader.hpp>
+#include <rclcpp/rclcpp.hpp>
+
+namespace moveit_handeye_calibration
+{
+/**
+ * @brief Calibrates offline from a session recorded by handeye_session_recorder.
+ * The samples are extracted by HandEyeSessionLoader and solved with the configured solver, as fast as the data can be
+ * processed.
+ */
+class HandEyeSessionReplayNode : public rclcpp::Node
+{
+public:
+  HandEyeSessionReplayNode(const rclcpp::NodeOptions& options = rclcpp::NodeOptions())
+    : Node("handeye_session_replay", options)
+  {
+    input_ = declare_parameter<std::string>("input", "handeye_session");
+    solver_type_ = declare_parameter<std::string>("solver_type", "OpenCV");
+    solver_name_ = declare_parameter<std::string>("solver_name", "Daniilidis1998");
+    motion_pairs_ = declare_parameter<int>("motion_pairs", CONSECUTIVE_PAIRS);
+    mount_type_ = declare_parameter<std::string>("sensor_mount_type", "eye_to_hand");
+    samples_output_ = declare_parameter<std::string>("samples_output", "");
+  }
+
+  bool run()
+  {
+    if (mount_type_ == "eye_to_hand")
+      setup_ = EYE_TO_HAND;
+    else if (mount_type_ == "eye_in_hand")
+      setup_ = EYE_IN_HAND;
+    else
+    {
+      RCLCPP_ERROR(get_logger(), "Unknown sensor_mount_type '%s', expected 'eye_to_hand' or 'eye_in_hand'",
+                   mount_type_.c_str());
+      return false;
+    }
+
+    HandEyeSessionLoader loader(shared_from_this());
+    return loader.load(input_) && solve(loader);
+  }
+
+private:
+  bool solve(const HandEyeSessionLoader& loader)
+  {
+    const SampleSet& samples = loader.getSamples();
+    if (!samples_output_.empty())
+    {
+      std::string error_message;
+      if (!writeSampleFile(samples_output_, samples, &error_message))
+        RCLCPP_ERROR(get_logger(), "%s", error_message.c_str());
+    }
+
+    pluginlib::ClassLoader<HandEyeSolverBase> solver_loader("moveit_calibration_plugins",
+                                                            "moveit_handeye_calibration::HandEyeSolverBase");
+    pluginlib::UniquePtr<HandEyeSolverBase> solver;
+    try
+    {
+      solver = solver_loader.createUniqueInstance(solver_type_);
+    }
+    catch (const pluginlib::PluginlibException& ex)
+    {
+      RCLCPP_ERROR(get_logger(), "Failed to create handeye solver %s: %s", solver_type_.c_str(), ex.what());
+      return false;
+    }
+    solver->initialize();
+    solver->setMotionPairMode(static_cast<MotionPairMode>(motion_pairs_));
+
+    std::string error_message;
+    if (!solver->solve(samples.effector_wrt_world, samples.object_wrt_sensor, setup_, solver_name_, &error_message))
+    {
+      RCLCPP_ERROR(get_logger(), "Calibration failed: %s", error_message.c_str());
+      return false;
+    }
+
+    const Eigen::Isometry3d& pose = solver->getCameraRobotPose();
+    const Eigen::Quaterniond q(pose.rotation());
+    const CalibrationError error =
+        solver->getCalibrationError(samples.effector_wrt_world, samples.object_wrt_sensor, pose, setup_);
+    RCLCPP_INFO(get_logger(),
+                "Calibration from '%s' to '%s' over %zu samples:\n"
+                "translation (x, y, z): %f, %f, %f\n"
+                "rotation (x, y, z, w): %f, %f, %f, %f\n"
+                "reprojection error: %f m, %f rad",
+                (setup_ == EYE_IN_HAND ? loader.getEndEffectorFrame() : loader.getRobotBaseFrame()).c_str(),
+                loader.getSensorFrame().c_str(), samples.effector_wrt_world.size(), pose.translation().x(),
+                pose.translation().y(), pose.translation().z(), q.x(), q.y(), q.z(), q.w(), error.translation,
+                error.rotation);
+    return true;
+  }
+
+  std::string input_;
+  std::string solver_type_;
+  std::string solver_name_;
+  int motion_pairs_;
+  std::string mount_type_;
+  SensorMountType setup_;
+  std::string samples_output_;
+};
+
+}  // namespace moveit_handeye_calibration
+
+int main(int argc, char** argv)
+{
+  rclcpp::init(argc, argv);
+  const bool success = std::make_shared<moveit_handeye_calibration::HandEyeSessionReplayNode>()->run();
+  rclcpp::shutdown();
+  return success ? 0 : 1;
+}
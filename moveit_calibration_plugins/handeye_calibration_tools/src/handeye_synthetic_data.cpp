@@ -0,0 +1,178 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt Calibration contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <moveit/handeye_calibration_tools/handeye_synthetic_data.h>
+
+#include <memory>
+#include <random>
+
+namespace moveit_handeye_calibration
+{
+namespace
+{
+const int MAX_VIEW_ATTEMPTS = 100;  // Random target views tried per sample until the target is in view
+
+Eigen::Isometry3d randomPose(std::mt19937& generator, double rotation_stddev, double translation_stddev)
+{
+  std::normal_distribution<double> normal(0., 1.);
+  Eigen::Vector3d rotation_vector;
+  for (size_t i = 0; i < 3; ++i)
+    rotation_vector[i] = rotation_stddev * normal(generator);
+  Eigen::Isometry3d pose = Eigen::Isometry3d::Identity();
+  if (rotation_vector.norm() > 0.)
+    pose.linear() = Eigen::AngleAxisd(rotation_vector.norm(), rotation_vector.normalized()).toRotationMatrix();
+  for (size_t i = 0; i < 3; ++i)
+    pose.translation()[i] = translation_stddev * normal(generator);
+  return pose;
+}
+
+bool setError(const std::string& message, std::string* error_message)
+{
+  if (error_message)
+    *error_message = message;
+  return false;
+}
+}  // namespace
+
+bool generateSyntheticData(const HandEyeTargetBase* target, const sensor_msgs::msg::CameraInfo& camera_info,
+                           const SyntheticDataOptions& options, SyntheticDataset& dataset, std::string* error_message)
+{
+  const double fx = camera_info.k[0];
+  const double fy = camera_info.k[4];
+  const double cx = camera_info.k[2];
+  const double cy = camera_info.k[5];
+  if (camera_info.width == 0 || camera_info.height == 0 || fx <= 0. || fy <= 0.)
+    return setError("Invalid camera info", error_message);
+  if (options.min_distance <= 0. || options.max_distance < options.min_distance)
+    return setError("Invalid target distance range", error_message);
+  if (2. * options.image_border >= std::min(camera_info.width, camera_info.height))
+    return setError("Image border larger than the image", error_message);
+
+  // The target is placed by its center, in the target frame
+  std::unique_ptr<HandEyeTargetRenderer> renderer;
+  Eigen::Vector3d target_center = Eigen::Vector3d::Zero();
+  if (target)
+  {
+    renderer = std::make_unique<HandEyeTargetRenderer>(*target);
+    if (!renderer->isValid())
+      return setError("The target cannot be rendered, make sure it is initialized", error_message);
+    const std::vector<cv::Point3d> corners = renderer->getTargetCorners();
+    target_center = Eigen::Vector3d(0.5 * (corners[0].x + corners[2].x), 0.5 * (corners[0].y + corners[2].y), 0.);
+  }
+
+  std::mt19937 generator(options.seed);
+  dataset.setup = options.setup;
+  dataset.samples.clear();
+  dataset.samples.reserve(options.num_samples);
+  if (options.setup == EYE_TO_HAND)
+  {
+    dataset.camera_robot_pose = randomPose(generator, 1., 1.);
+    dataset.target_robot_pose = randomPose(generator, 1., 0.1);
+  }
+  else
+  {
+    dataset.camera_robot_pose = randomPose(generator, 1., 0.1);
+    dataset.target_robot_pose = randomPose(generator, 1., 1.);
+  }
+
+  std::uniform_real_distribution<double> pixel_x(options.image_border, camera_info.width - options.image_border);
+  std::uniform_real_distribution<double> pixel_y(options.image_border, camera_info.height - options.image_border);
+  std::uniform_real_distribution<double> distance(options.min_distance, options.max_distance);
+  std::uniform_real_distribution<double> tilt(0., options.max_tilt);
+  std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+  std::uniform_real_distribution<double> unit(0., 1.);
+  for (size_t i = 0; i < options.num_samples; ++i)
+  {
+    SyntheticSample sample;
+    bool in_view = false;
+    for (int attempt = 0; attempt < MAX_VIEW_ATTEMPTS && !in_view; ++attempt)
+    {
+      // Facing the camera is a half turn about x, as the target z-axis points out of its front side
+      const Eigen::Vector3d center =
+          distance(generator) * Eigen::Vector3d((pixel_x(generator) - cx) / fx, (pixel_y(generator) - cy) / fy, 1.);
+      const double tilt_direction = angle(generator);
+      const Eigen::Vector3d tilt_axis(std::cos(tilt_direction), std::sin(tilt_direction), 0.);
+      sample.object_wrt_sensor.linear() = (Eigen::AngleAxisd(M_PI, Eigen::Vector3d::UnitX()) *
+                                           Eigen::AngleAxisd(tilt(generator), tilt_axis) *
+                                           Eigen::AngleAxisd(angle(generator), Eigen::Vector3d::UnitZ()))
+                                              .toRotationMatrix();
+      sample.object_wrt_sensor.translation() = center - sample.object_wrt_sensor.linear() * target_center;
+      sample.object_wrt_sensor.makeAffine();
+      in_view = !renderer || renderer->isVisible(camera_info, sample.object_wrt_sensor, options.image_border);
+    }
+    if (!in_view)
+      return setError("The target does not fit into the image in " + std::to_string(MAX_VIEW_ATTEMPTS) +
+                          " random views, increase the distance range",
+                      error_message);
+
+    sample.measured_object_wrt_sensor =
+        sample.object_wrt_sensor * randomPose(generator, options.rotation_noise, options.translation_noise);
+    if (options.setup == EYE_TO_HAND)
+      sample.effector_wrt_world =
+          dataset.camera_robot_pose * sample.object_wrt_sensor * dataset.target_robot_pose.inverse();
+    else
+      sample.effector_wrt_world =
+          dataset.target_robot_pose * sample.object_wrt_sensor.inverse() * dataset.camera_robot_pose.inverse();
+
+    // Draw the image effects even without rendering, so the poses only depend on the seed
+    RenderOptions render_options = options.render_options;
+    render_options.seed = options.render_options.seed + i;
+    render_options.blur_sigma += options.max_blur_sigma * unit(generator);
+    render_options.gradient += options.max_gradient * unit(generator);
+    const double gradient_direction = angle(generator);
+    if (options.max_gradient > 0.)
+      render_options.gradient_direction = gradient_direction;
+    if (renderer && options.render_images &&
+        !renderer->render(camera_info, sample.object_wrt_sensor, render_options, sample.image))
+      return setError("Failed to render sample " + std::to_string(i), error_message);
+
+    dataset.samples.push_back(std::move(sample));
+  }
+  return true;
+}
+
+SampleSet getSampleSet(const SyntheticDataset& dataset)
+{
+  SampleSet samples;
+  samples.effector_wrt_world.reserve(dataset.samples.size());
+  samples.object_wrt_sensor.reserve(dataset.samples.size());
+  for (const SyntheticSample& sample : dataset.samples)
+  {
+    samples.effector_wrt_world.push_back(sample.effector_wrt_world);
+    samples.object_wrt_sensor.push_back(sample.measured_object_wrt_sensor);
+  }
+  return samples;
+}
+
+}  // namespace moveit_handeye_calibration
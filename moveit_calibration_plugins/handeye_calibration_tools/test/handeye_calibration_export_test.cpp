@@ -0,0 +1,79 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt Calibration contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <gtest/gtest.h>
+#include <moveit/handeye_calibration_tools/handeye_calibration_export.h>
+
+namespace mhc = moveit_handeye_calibration;
+
+TEST(HandEyeCalibrationExport, EndsWith)
+{
+  EXPECT_TRUE(mhc::endsWith("session.samples", ".samples"));
+  EXPECT_TRUE(mhc::endsWith("calibration.py", ""));
+  EXPECT_FALSE(mhc::endsWith("calibration.py", ".yaml"));
+  EXPECT_FALSE(mhc::endsWith("py", ".py"));
+}
+
+TEST(HandEyeCalibrationExport, LaunchFormat)
+{
+  mhc::LaunchFormat format;
+  ASSERT_TRUE(mhc::getLaunchFormat("calibration.launch.py", format));
+  EXPECT_EQ(format, mhc::LAUNCH_PYTHON);
+  ASSERT_TRUE(mhc::getLaunchFormat("calibration.launch.xml", format));
+  EXPECT_EQ(format, mhc::LAUNCH_XML);
+  ASSERT_TRUE(mhc::getLaunchFormat("calibration.yml", format));
+  EXPECT_EQ(format, mhc::LAUNCH_YAML);
+  EXPECT_FALSE(mhc::getLaunchFormat("calibration.txt", format));
+  EXPECT_FALSE(mhc::getLaunchFormat("py", format));
+}
+
+TEST(HandEyeCalibrationExport, GenerateLaunch)
+{
+  Eigen::Isometry3d pose = Eigen::Isometry3d::Identity();
+  pose.translation() = Eigen::Vector3d(0.5, -0.25, 1.);
+
+  const std::string python =
+      mhc::generateCalibrationLaunch(mhc::LAUNCH_PYTHON, "base_link", "camera", pose, mhc::EYE_TO_HAND).str();
+  EXPECT_NE(python.find("EYE-TO-HAND: base_link -> camera"), std::string::npos);
+  EXPECT_NE(python.find("\"--x\",\n                \"0.5\""), std::string::npos);
+  EXPECT_EQ(python.find("Std. dev."), std::string::npos);
+
+  mhc::CalibrationUncertainty uncertainty;
+  uncertainty.num_resamples = 20;
+  const std::string xml =
+      mhc::generateCalibrationLaunch(mhc::LAUNCH_XML, "tool0", "camera", pose, mhc::EYE_IN_HAND, &uncertainty).str();
+  EXPECT_NE(xml.find("EYE-IN-HAND: tool0 -> camera"), std::string::npos);
+  EXPECT_NE(xml.find("--z 1\n"), std::string::npos);
+  EXPECT_NE(xml.find("Std. dev. over 20 resamples"), std::string::npos);
+}
@@ -0,0 +1,109 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt Calibration contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <gtest/gtest.h>
+#include <moveit/handeye_calibration_tools/handeye_detection_statistics.h>
+
+using moveit_handeye_calibration::DetectionSummary;
+using moveit_handeye_calibration::HandEyeDetectionStatistics;
+
+TEST(HandEyeDetectionStatistics, Empty)
+{
+  HandEyeDetectionStatistics statistics;
+  const DetectionSummary summary = statistics.getSummary();
+  EXPECT_EQ(summary.frames_received, 0u);
+  EXPECT_EQ(summary.success_rate, 0.);
+  EXPECT_EQ(moveit_handeye_calibration::getDetectionDiagnostics(summary, "camera", "camera_frame").level,
+            diagnostic_msgs::msg::DiagnosticStatus::STALE);
+}
+
+TEST(HandEyeDetectionStatistics, Window)
+{
+  HandEyeDetectionStatistics statistics(10);
+  for (int i = 0; i < 20; ++i)
+  {
+    statistics.addReceivedFrame(0.1 * i);
+    // The latest 10 frames have detections on every other frame
+    const bool detected = i >= 10 && i % 2 == 0;
+    statistics.addProcessedFrame(detected, 0.001 * (i + 1), 4, i >= 10 ? 0.5 : 10.);
+  }
+  const DetectionSummary summary = statistics.getSummary();
+  EXPECT_EQ(summary.frames_received, 20u);
+  EXPECT_EQ(summary.frames_processed, 20u);
+  EXPECT_EQ(summary.frames_dropped, 0u);
+  EXPECT_EQ(summary.detections, 5u);
+  EXPECT_DOUBLE_EQ(summary.success_rate, 0.5);
+  EXPECT_DOUBLE_EQ(summary.mean_markers, 4.);
+  EXPECT_DOUBLE_EQ(summary.residual_rms, 0.5);
+  EXPECT_DOUBLE_EQ(summary.latency_p50, 0.015);
+  EXPECT_DOUBLE_EQ(summary.latency_p95, 0.019);
+  EXPECT_DOUBLE_EQ(summary.latency_max, 0.02);
+
+  const diagnostic_msgs::msg::DiagnosticStatus status =
+      moveit_handeye_calibration::getDetectionDiagnostics(summary, "camera", "camera_frame");
+  EXPECT_EQ(status.level, diagnostic_msgs::msg::DiagnosticStatus::OK);
+  EXPECT_EQ(status.hardware_id, "camera_frame");
+  EXPECT_FALSE(status.values.empty());
+}
+
+TEST(HandEyeDetectionStatistics, DroppedAndSkippedFrames)
+{
+  HandEyeDetectionStatistics statistics;
+  double stamp = 0.;
+  for (int i = 0; i < 10; ++i)
+  {
+    statistics.addReceivedFrame(stamp);
+    stamp += 1. / 30.;
+  }
+  // Three frames missing
+  stamp += 3. / 30.;
+  statistics.addReceivedFrame(stamp);
+  statistics.addReceivedFrame(stamp + 1. / 30.);
+  statistics.addSkippedFrame();
+
+  DetectionSummary summary = statistics.getSummary();
+  EXPECT_EQ(summary.frames_received, 12u);
+  EXPECT_EQ(summary.frames_dropped, 3u);
+  EXPECT_EQ(summary.frames_skipped, 1u);
+
+  // No detection in the processed frames
+  statistics.addProcessedFrame(false, 0.01);
+  summary = statistics.getSummary();
+  EXPECT_EQ(summary.success_rate, 0.);
+  EXPECT_EQ(moveit_handeye_calibration::getDetectionDiagnostics(summary, "camera", "camera_frame").level,
+            diagnostic_msgs::msg::DiagnosticStatus::WARN);
+
+  statistics.reset();
+  EXPECT_EQ(statistics.getSummary().frames_received, 0u);
+}
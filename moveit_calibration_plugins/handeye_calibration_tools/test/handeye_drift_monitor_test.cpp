@@ -0,0 +1,98 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt Calibration contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <gtest/gtest.h>
+#include <moveit/handeye_calibration_tools/handeye_drift_monitor.h>
+
+using moveit_handeye_calibration::HandEyeDriftMonitor;
+
+class MoveItHandEyeDriftMonitorTester : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    camera_robot_pose_ = Eigen::Isometry3d::Identity();
+    camera_robot_pose_.translate(Eigen::Vector3d(0.6, -0.2, 0.8));
+    camera_robot_pose_.rotate(Eigen::AngleAxisd(2.5, Eigen::Vector3d(0.2, -0.8, 0.6).normalized()));
+    object_wrt_effector_ = Eigen::Isometry3d::Identity();
+    object_wrt_effector_.translate(Eigen::Vector3d(0.0, 0.05, 0.1));
+  }
+
+  // Observe the object on the end-effector from an eye-to-hand camera at the given pose
+  void observe(HandEyeDriftMonitor& monitor, const Eigen::Isometry3d& camera_pose, int sample)
+  {
+    Eigen::Isometry3d effector_wrt_world = Eigen::Isometry3d::Identity();
+    effector_wrt_world.translate(Eigen::Vector3d(0.4 + 0.01 * (sample % 7), 0.02 * (sample % 5), 0.5));
+    effector_wrt_world.rotate(Eigen::AngleAxisd(0.1 * sample, Eigen::Vector3d(1., sample % 3, 1.).normalized()));
+    monitor.addObservation(effector_wrt_world, camera_pose.inverse() * effector_wrt_world * object_wrt_effector_);
+  }
+
+  Eigen::Isometry3d camera_robot_pose_;
+  Eigen::Isometry3d object_wrt_effector_;
+};
+
+TEST_F(MoveItHandEyeDriftMonitorTester, ConsistentCalibration)
+{
+  HandEyeDriftMonitor monitor(camera_robot_pose_, moveit_handeye_calibration::EYE_TO_HAND);
+  for (int i = 0; i < 20; ++i)
+    observe(monitor, camera_robot_pose_, i);
+  ASSERT_EQ(monitor.getNumObservations(), 19);
+  ASSERT_EQ(monitor.getLevel(), moveit_handeye_calibration::DRIFT_OK);
+  ASSERT_LT(monitor.getTranslationStatistics().max, 1e-9);
+  ASSERT_LT(monitor.getRotationStatistics().max, 1e-9);
+}
+
+TEST_F(MoveItHandEyeDriftMonitorTester, ShiftedCamera)
+{
+  HandEyeDriftMonitor monitor(camera_robot_pose_, moveit_handeye_calibration::EYE_TO_HAND, 0.5);
+  for (int i = 0; i < 5; ++i)
+    observe(monitor, camera_robot_pose_, i);
+
+  Eigen::Isometry3d shifted_pose = camera_robot_pose_;
+  shifted_pose.translate(Eigen::Vector3d(0.05, 0., 0.));
+  for (int i = 5; i < 20; ++i)
+    observe(monitor, shifted_pose, i);
+  ASSERT_EQ(monitor.getLevel(), moveit_handeye_calibration::DRIFT_ERROR);
+  ASSERT_GT(monitor.getTranslationStatistics().mean, monitor.getThresholds().translation_error);
+
+  monitor.reset();
+  ASSERT_EQ(monitor.getNumObservations(), 0);
+  ASSERT_EQ(monitor.getLevel(), moveit_handeye_calibration::DRIFT_OK);
+}
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,159 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt Calibration contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <gtest/gtest.h>
+#include <moveit/handeye_calibration_tools/handeye_pose_selection.h>
+
+#include <random>
+
+namespace mhc = moveit_handeye_calibration;
+
+namespace
+{
+Eigen::Isometry3d makePose(const Eigen::Vector3d& axis, double angle, const Eigen::Vector3d& translation)
+{
+  Eigen::Isometry3d pose = Eigen::Isometry3d::Identity();
+  pose.linear() = Eigen::AngleAxisd(angle, axis.normalized()).matrix();
+  pose.translation() = translation;
+  return pose;
+}
+}  // namespace
+
+TEST(MoveItHandEyePoseSelectionTester, PreferNewRotationAxis)
+{
+  mhc::NextPoseSelector selector(mhc::EYE_IN_HAND, mhc::ALL_PAIRS);
+  selector.setSamples({ makePose(Eigen::Vector3d::UnitZ(), 0., Eigen::Vector3d(0.5, 0., 0.5)),
+                        makePose(Eigen::Vector3d::UnitZ(), 0.5, Eigen::Vector3d(0.5, 0.1, 0.5)),
+                        makePose(Eigen::Vector3d::UnitZ(), -0.5, Eigen::Vector3d(0.5, -0.1, 0.5)) });
+
+  // Only rotations about z were seen, so a rotation about x adds the most information
+  const std::vector<Eigen::Isometry3d> candidates = {
+    makePose(Eigen::Vector3d::UnitZ(), 0.8, Eigen::Vector3d(0.4, 0., 0.5)),
+    makePose(Eigen::Vector3d::UnitX(), 0.5, Eigen::Vector3d(0.5, 0., 0.4)),
+    makePose(Eigen::Vector3d::UnitZ(), 0., Eigen::Vector3d(0.6, 0., 0.6)),
+  };
+  double gain = 0.;
+  ASSERT_EQ(selector.selectNextPose(candidates, &gain), 1u);
+  ASSERT_GT(gain, selector.getInformationGain(candidates[0]));
+  ASSERT_GT(selector.getInformationGain(candidates[0]), selector.getInformationGain(candidates[2]));
+}
+
+TEST(MoveItHandEyePoseSelectionTester, ParallelMatchesSerial)
+{
+  std::mt19937 generator(7);
+  std::normal_distribution<double> normal;
+  auto random_pose = [&]() {
+    return makePose(Eigen::Vector3d(normal(generator), normal(generator), normal(generator)), normal(generator),
+                    Eigen::Vector3d(normal(generator), normal(generator), normal(generator)));
+  };
+
+  std::vector<Eigen::Isometry3d> samples, candidates;
+  for (std::size_t i = 0; i < 10; ++i)
+    samples.push_back(random_pose());
+  for (std::size_t i = 0; i < 100; ++i)
+    candidates.push_back(random_pose());
+
+  for (mhc::SensorMountType setup : { mhc::EYE_IN_HAND, mhc::EYE_TO_HAND })
+  {
+    mhc::NextPoseSelector selector(setup, mhc::CONSECUTIVE_PAIRS);
+    selector.setSamples(samples);
+    const std::vector<double> gains = selector.getInformationGains(candidates, 4);
+    ASSERT_EQ(gains.size(), candidates.size());
+    for (std::size_t i = 0; i < candidates.size(); ++i)
+    {
+      ASSERT_DOUBLE_EQ(gains[i], selector.getInformationGain(candidates[i]));
+      ASSERT_GE(gains[i], 0.);
+    }
+
+    // Adding the selected sample increases the information by the predicted gain
+    double gain = 0.;
+    const std::size_t best = selector.selectNextPose(candidates, &gain);
+    const double log_determinant = selector.getLogDeterminant();
+    samples.push_back(candidates[best]);
+    selector.setSamples(samples);
+    ASSERT_NEAR(selector.getLogDeterminant() - log_determinant, gain, 1e-9);
+    samples.pop_back();
+  }
+}
+
+TEST(MoveItHandEyePoseSelectionTester, NoCandidates)
+{
+  mhc::NextPoseSelector selector(mhc::EYE_TO_HAND, mhc::ALL_PAIRS);
+  ASSERT_EQ(selector.selectNextPose({}), 0u);
+  ASSERT_TRUE(selector.getInformationGains({}).empty());
+}
+
+TEST(MoveItHandEyePoseSelectionTester, SelectRecordedPose)
+{
+  const std::vector<Eigen::Isometry3d> samples = {
+    makePose(Eigen::Vector3d::UnitZ(), 0., Eigen::Vector3d(0.5, 0., 0.5)),
+    makePose(Eigen::Vector3d::UnitZ(), 0.5, Eigen::Vector3d(0.5, 0.1, 0.5)),
+  };
+  const std::vector<Eigen::Isometry3d> remaining = {
+    makePose(Eigen::Vector3d::UnitX(), 0.5, Eigen::Vector3d(0.5, 0., 0.4)),
+    makePose(Eigen::Vector3d::UnitZ(), 0.1, Eigen::Vector3d(0.5, 0., 0.5)),
+    makePose(Eigen::Vector3d::UnitX(), 0.3, Eigen::Vector3d(0.5, 0., 0.45)),
+    makePose(Eigen::Vector3d::UnitY(), 0.5, Eigen::Vector3d(0.4, 0., 0.5)),
+  };
+
+  // Without planned poses, the rotation about x is the best choice
+  double gain = 0.;
+  ASSERT_EQ(mhc::selectNextRecordedPose(mhc::EYE_IN_HAND, mhc::ALL_PAIRS, samples, remaining, 0, &gain), 0u);
+  ASSERT_GT(gain, 0.);
+
+  // Once it is planned, the rotation about y adds more than another rotation about x
+  std::vector<Eigen::Isometry3d> planned_samples = samples;
+  planned_samples.push_back(remaining[0]);
+  mhc::NextPoseSelector selector(mhc::EYE_IN_HAND, mhc::ALL_PAIRS);
+  selector.setSamples(planned_samples);
+  const std::size_t expected = 1 + selector.selectNextPose({ remaining.begin() + 1, remaining.end() });
+  ASSERT_EQ(expected, 3u);
+  ASSERT_EQ(mhc::selectNextRecordedPose(mhc::EYE_IN_HAND, mhc::ALL_PAIRS, samples, remaining, 1, &gain), expected);
+  ASSERT_DOUBLE_EQ(gain, selector.getInformationGain(remaining[expected]));
+}
+
+TEST(MoveItHandEyePoseSelectionTester, NoRecordedPoseChoice)
+{
+  const std::vector<Eigen::Isometry3d> remaining = { makePose(Eigen::Vector3d::UnitX(), 0.5, Eigen::Vector3d::Zero()),
+                                                     makePose(Eigen::Vector3d::UnitY(), 0.5, Eigen::Vector3d::Zero()) };
+
+  // Nothing to compare against
+  double gain = 1.;
+  ASSERT_EQ(mhc::selectNextRecordedPose(mhc::EYE_TO_HAND, mhc::ALL_PAIRS, {}, remaining, 0, &gain), 0u);
+  ASSERT_EQ(gain, 0.);
+
+  // Only one pose left
+  ASSERT_EQ(mhc::selectNextRecordedPose(mhc::EYE_TO_HAND, mhc::ALL_PAIRS, {}, remaining, 1), 1u);
+  ASSERT_EQ(mhc::selectNextRecordedPose(mhc::EYE_TO_HAND, mhc::ALL_PAIRS, {}, remaining, 2), 2u);
+}
@@ -0,0 +1,98 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt Calibration contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <gtest/gtest.h>
+#include <moveit/handeye_calibration_tools/handeye_rotation_index.h>
+
+#include <random>
+
+namespace
+{
+Eigen::Matrix3d randomRotation(std::mt19937& generator)
+{
+  std::normal_distribution<double> normal;
+  Eigen::Quaterniond q(normal(generator), normal(generator), normal(generator), normal(generator));
+  return q.normalized().toRotationMatrix();
+}
+}  // namespace
+
+TEST(MoveItHandEyeRotationIndexTester, MatchesLinearSearch)
+{
+  const double min_angle = M_PI / 36.;
+  moveit_handeye_calibration::RotationIndex index(min_angle);
+  std::vector<Eigen::Matrix3d> stored;
+  std::mt19937 generator(42);
+
+  for (std::size_t i = 0; i < 2000; ++i)
+  {
+    // Perturb stored rotations to also produce queries close to the minimum angle
+    Eigen::Matrix3d rotation = randomRotation(generator);
+    if (!stored.empty() && i % 2 == 0)
+      rotation = stored[i % stored.size()] *
+                 Eigen::AngleAxisd(min_angle * (0.45 + (i % 7) / 5.), randomRotation(generator).col(0)).matrix();
+
+    bool expected = false;
+    for (const Eigen::Matrix3d& prior : stored)
+      expected |= Eigen::AngleAxisd(rotation.transpose() * prior).angle() < min_angle;
+    ASSERT_EQ(index.hasNeighbor(rotation), expected);
+
+    if (!expected)
+    {
+      index.insert(rotation);
+      stored.push_back(rotation);
+    }
+  }
+  ASSERT_EQ(index.size(), stored.size());
+}
+
+TEST(MoveItHandEyeRotationIndexTester, RemoveLast)
+{
+  moveit_handeye_calibration::RotationIndex index(0.1);
+  const Eigen::Matrix3d rotation(Eigen::AngleAxisd(0.5, Eigen::Vector3d::UnitZ()));
+  index.insert(rotation);
+  ASSERT_TRUE(index.hasNeighbor(rotation * Eigen::AngleAxisd(0.05, Eigen::Vector3d::UnitX())));
+
+  index.removeLast();
+  ASSERT_EQ(index.size(), 0);
+  ASSERT_FALSE(index.hasNeighbor(rotation));
+}
+
+TEST(MoveItHandEyeRotationIndexTester, OppositeQuaternionSign)
+{
+  // Rotations by almost half a turn about the same axis have quaternions of opposite sign
+  moveit_handeye_calibration::RotationIndex index(0.1);
+  index.insert(Eigen::AngleAxisd(M_PI - 0.01, Eigen::Vector3d::UnitZ()).matrix());
+  ASSERT_TRUE(index.hasNeighbor(Eigen::AngleAxisd(M_PI + 0.02, Eigen::Vector3d::UnitZ()).matrix()));
+  ASSERT_FALSE(index.hasNeighbor(Eigen::AngleAxisd(M_PI + 0.2, Eigen::Vector3d::UnitZ()).matrix()));
+}
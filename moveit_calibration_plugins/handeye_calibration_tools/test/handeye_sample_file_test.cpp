@@ -0,0 +1,160 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt Calibration contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <gtest/gtest.h>
+#include <moveit/handeye_calibration_tools/handeye_sample_file.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
+#include <random>
+
+namespace mhc = moveit_handeye_calibration;
+
+namespace
+{
+mhc::SampleSet makeSamples(std::size_t num_samples, bool with_joint_states, bool with_stamps)
+{
+  std::mt19937 generator(3);
+  std::normal_distribution<double> normal;
+  mhc::SampleSet samples;
+  if (with_joint_states)
+    samples.joint_names = { "joint_1", "joint_2", "joint_3" };
+  for (std::size_t i = 0; i < num_samples; ++i)
+  {
+    Eigen::Isometry3d effector = Eigen::Isometry3d::Identity();
+    effector.linear() = Eigen::Quaterniond(normal(generator), normal(generator), normal(generator), normal(generator))
+                            .normalized()
+                            .toRotationMatrix();
+    effector.translation() = Eigen::Vector3d(normal(generator), normal(generator), normal(generator));
+    samples.effector_wrt_world.push_back(effector);
+    samples.object_wrt_sensor.push_back(effector.inverse());
+    if (with_joint_states)
+      samples.joint_states.push_back({ normal(generator), normal(generator), normal(generator) });
+    if (with_stamps)
+      samples.stamps.push_back(1e9 + i * 0.1);
+  }
+  return samples;
+}
+
+void expectEqual(const mhc::SampleSet& a, const mhc::SampleSet& b)
+{
+  ASSERT_EQ(a.effector_wrt_world.size(), b.effector_wrt_world.size());
+  ASSERT_EQ(a.object_wrt_sensor.size(), b.object_wrt_sensor.size());
+  for (std::size_t i = 0; i < a.effector_wrt_world.size(); ++i)
+  {
+    ASSERT_TRUE(a.effector_wrt_world[i].matrix() == b.effector_wrt_world[i].matrix());
+    ASSERT_TRUE(a.object_wrt_sensor[i].matrix() == b.object_wrt_sensor[i].matrix());
+  }
+  ASSERT_EQ(a.joint_names, b.joint_names);
+  ASSERT_EQ(a.joint_states, b.joint_states);
+  ASSERT_EQ(a.stamps, b.stamps);
+}
+}  // namespace
+
+TEST(MoveItHandEyeSampleFileTester, WriteAndRead)
+{
+  const std::string file_name = testing::TempDir() + "handeye_samples.samples";
+  for (bool with_joint_states : { false, true })
+    for (bool with_stamps : { false, true })
+    {
+      const mhc::SampleSet samples = makeSamples(50, with_joint_states, with_stamps);
+      std::string error_message;
+      ASSERT_TRUE(mhc::writeSampleFile(file_name, samples, &error_message)) << error_message;
+
+      mhc::SampleSet loaded;
+      ASSERT_TRUE(mhc::readSampleFile(file_name, loaded, &error_message)) << error_message;
+      expectEqual(samples, loaded);
+    }
+  std::remove(file_name.c_str());
+}
+
+TEST(MoveItHandEyeSampleFileTester, MappedAccess)
+{
+  const std::string file_name = testing::TempDir() + "handeye_samples_mapped.samples";
+  const mhc::SampleSet samples = makeSamples(10, true, true);
+  ASSERT_TRUE(mhc::writeSampleFile(file_name, samples));
+
+  mhc::MappedSampleFile file;
+  ASSERT_TRUE(file.open(file_name));
+  ASSERT_EQ(file.size(), 10u);
+  ASSERT_TRUE(file.hasJointStates());
+  ASSERT_TRUE(file.hasStamps());
+  ASSERT_EQ(file.getJointNames(), samples.joint_names);
+  ASSERT_TRUE(file.getEffectorWrtWorld(7) == samples.effector_wrt_world[7].matrix());
+  ASSERT_TRUE(file.getObjectWrtSensor(3) == samples.object_wrt_sensor[3].matrix());
+  ASSERT_EQ(file.getJointState(4)[2], samples.joint_states[4][2]);
+  ASSERT_EQ(file.getStamp(9), samples.stamps[9]);
+
+  file.close();
+  ASSERT_EQ(file.size(), 0u);
+  std::remove(file_name.c_str());
+}
+
+TEST(MoveItHandEyeSampleFileTester, RejectInvalidFiles)
+{
+  const std::string file_name = testing::TempDir() + "handeye_samples_invalid.samples";
+  mhc::SampleSet samples = makeSamples(5, true, false);
+  ASSERT_TRUE(mhc::writeSampleFile(file_name, samples));
+
+  // Truncated file
+  std::ifstream in(file_name, std::ios::binary);
+  std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+  in.close();
+  std::ofstream(file_name, std::ios::binary).write(content.data(), content.size() - 8);
+  mhc::SampleSet loaded;
+  std::string error_message;
+  ASSERT_FALSE(mhc::readSampleFile(file_name, loaded, &error_message));
+  ASSERT_FALSE(error_message.empty());
+
+  // Written with the other byte order
+  std::string swapped = content;
+  const std::size_t byte_order = offsetof(mhc::SampleFileHeader, byte_order);
+  std::reverse(swapped.begin() + byte_order, swapped.begin() + byte_order + sizeof(std::uint32_t));
+  std::ofstream(file_name, std::ios::binary).write(swapped.data(), swapped.size());
+  error_message.clear();
+  ASSERT_FALSE(mhc::readSampleFile(file_name, loaded, &error_message));
+  ASSERT_NE(error_message.find("byte order"), std::string::npos);
+
+  // Not a sample file
+  std::ofstream(file_name) << "- effector_wrt_world: [1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1]";
+  ASSERT_FALSE(mhc::readSampleFile(file_name, loaded));
+  ASSERT_FALSE(mhc::readSampleFile(file_name + ".missing", loaded));
+
+  // Inconsistent sample set
+  samples.joint_states.pop_back();
+  ASSERT_FALSE(mhc::writeSampleFile(file_name, samples));
+  std::remove(file_name.c_str());
+}
@@ -0,0 +1,155 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt Calibration contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <gtest/gtest.h>
+#include <moveit/handeye_calibration_tools/handeye_sample_stream.h>
+#include <tf2_eigen/tf2_eigen.hpp>
+
+namespace mhc = moveit_handeye_calibration;
+
+namespace
+{
+const mhc::SampleStreamFrames FRAMES = { "camera", "target", "base", "tool" };
+
+tf2::TimePoint getTime(double seconds)
+{
+  return tf2::TimePoint(tf2::durationFromSec(seconds));
+}
+
+void setTransform(tf2::BufferCore& buffer, const std::string& parent, const std::string& child, double seconds,
+                  const Eigen::Isometry3d& pose)
+{
+  geometry_msgs::msg::TransformStamped transform = tf2::eigenToTransform(pose);
+  transform.header.frame_id = parent;
+  transform.child_frame_id = child;
+  transform.header.stamp.sec = static_cast<int32_t>(seconds);
+  transform.header.stamp.nanosec = static_cast<uint32_t>((seconds - transform.header.stamp.sec) * 1e9 + 0.5);
+  buffer.setTransform(transform, "test");
+}
+
+void setEffectorPose(tf2::BufferCore& buffer, double seconds, double x)
+{
+  setTransform(buffer, FRAMES.base, FRAMES.effector, seconds,
+               Eigen::Isometry3d(Eigen::Translation3d(x, 0.1, 0.5) * Eigen::AngleAxisd(0.3, Eigen::Vector3d::UnitY())));
+}
+
+void setDetection(tf2::BufferCore& buffer, double seconds)
+{
+  setTransform(buffer, FRAMES.sensor, FRAMES.object, seconds,
+               Eigen::Isometry3d(Eigen::Translation3d(0., 0., 0.8 + seconds * 1e-3)));
+}
+}  // namespace
+
+TEST(MoveItHandEyeSampleStreamTester, StreamDetections)
+{
+  tf2::BufferCore buffer;
+  mhc::SampleStreamFilter filter;
+  filter.start(FRAMES, getTime(1.));
+  geometry_msgs::msg::TransformStamped camera_to_object, base_to_eef;
+
+  // The target has not been detected yet
+  EXPECT_EQ(filter.poll(buffer, camera_to_object, base_to_eef), mhc::STREAM_NO_DETECTION);
+
+  // Detections before the start are not streamed
+  for (double t = 0.; t <= 2.; t += 0.5)
+    setEffectorPose(buffer, t, 0.2);
+  setDetection(buffer, 0.8);
+  EXPECT_EQ(filter.poll(buffer, camera_to_object, base_to_eef), mhc::STREAM_NO_DETECTION);
+
+  // A new detection is reported until it is processed
+  setDetection(buffer, 1.2);
+  ASSERT_EQ(filter.poll(buffer, camera_to_object, base_to_eef), mhc::STREAM_NEW_SAMPLE);
+  EXPECT_NEAR(camera_to_object.transform.translation.z, 0.8012, 1e-9);
+  EXPECT_NEAR(base_to_eef.transform.translation.x, 0.2, 1e-9);
+  EXPECT_EQ(filter.poll(buffer, camera_to_object, base_to_eef), mhc::STREAM_NEW_SAMPLE);
+  filter.markProcessed(camera_to_object);
+  EXPECT_EQ(filter.poll(buffer, camera_to_object, base_to_eef), mhc::STREAM_NO_DETECTION);
+
+  // The robot state at the capture time is not known yet
+  setDetection(buffer, 2.2);
+  EXPECT_EQ(filter.poll(buffer, camera_to_object, base_to_eef), mhc::STREAM_WAITING);
+  setEffectorPose(buffer, 2.5, 0.2);
+  EXPECT_EQ(filter.poll(buffer, camera_to_object, base_to_eef), mhc::STREAM_NEW_SAMPLE);
+  filter.markProcessed(camera_to_object);
+}
+
+TEST(MoveItHandEyeSampleStreamTester, RejectFastMotion)
+{
+  tf2::BufferCore buffer;
+  mhc::SampleStreamFilter filter;
+  filter.start(FRAMES, getTime(0.));
+  geometry_msgs::msg::TransformStamped camera_to_object, base_to_eef;
+
+  // Moving at 1 m/s, ten times the maximum linear velocity
+  setEffectorPose(buffer, 1., 0.);
+  setEffectorPose(buffer, 2., 1.);
+  setDetection(buffer, 1.5);
+  EXPECT_EQ(filter.poll(buffer, camera_to_object, base_to_eef), mhc::STREAM_FAST_MOTION);
+
+  // The rejected detection is skipped
+  EXPECT_EQ(filter.poll(buffer, camera_to_object, base_to_eef), mhc::STREAM_NO_DETECTION);
+
+  // Accepted with a higher velocity limit
+  mhc::SampleStreamLimits limits;
+  limits.max_linear_velocity = 2.;
+  filter.start(FRAMES, getTime(0.), limits);
+  EXPECT_EQ(filter.poll(buffer, camera_to_object, base_to_eef), mhc::STREAM_NEW_SAMPLE);
+}
+
+TEST(MoveItHandEyeSampleStreamTester, RetryFailedLookup)
+{
+  tf2::BufferCore buffer;
+  mhc::SampleStreamFilter filter;
+  filter.start(FRAMES, getTime(0.));
+  geometry_msgs::msg::TransformStamped camera_to_object, base_to_eef;
+
+  // The robot state does not reach back to the start of the velocity window
+  setEffectorPose(buffer, 10., 0.2);
+  setEffectorPose(buffer, 10.02, 0.2);
+  setDetection(buffer, 10.01);
+  std::string error_message;
+  EXPECT_EQ(filter.poll(buffer, camera_to_object, base_to_eef, &error_message), mhc::STREAM_LOOKUP_FAILED);
+  EXPECT_FALSE(error_message.empty());
+
+  // The detection is not skipped, so it is sampled once the lookup succeeds
+  EXPECT_EQ(filter.poll(buffer, camera_to_object, base_to_eef), mhc::STREAM_LOOKUP_FAILED);
+  setEffectorPose(buffer, 9.9, 0.2);
+  EXPECT_EQ(filter.poll(buffer, camera_to_object, base_to_eef), mhc::STREAM_NEW_SAMPLE);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
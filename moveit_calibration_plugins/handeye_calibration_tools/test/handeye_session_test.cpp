@@ -0,0 +1,263 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt Calibration contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <gtest/gtest.h>
+#include <moveit/handeye_calibration_solver/handeye_solver_base.h>
+#include <moveit/handeye_calibration_target/handeye_target_charuco.h>
+#include <moveit/handeye_calibration_tools/handeye_session.h>
+#include <moveit/handeye_calibration_tools/handeye_synthetic_data.h>
+
+#include <filesystem>
+#include <map>
+#include <cv_bridge/cv_bridge.h>
+#include <pluginlib/class_loader.hpp>
+#include <rclcpp/serialization.hpp>
+#include <rosbag2_cpp/reader.hpp>
+#include <rosbag2_cpp/writer.hpp>
+#include <sensor_msgs/msg/joint_state.hpp>
+#include <tf2_eigen/tf2_eigen.hpp>
+#include <tf2_msgs/msg/tf_message.hpp>
+
+#include "handeye_test_camera_info.h"
+
+namespace mhc = moveit_handeye_calibration;
+
+namespace
+{
+const std::string SENSOR_FRAME = "camera_color_optical_frame";
+
+tf2_msgs::msg::TFMessage createTFMessage(const Eigen::Isometry3d& effector_wrt_world, const rclcpp::Time& stamp)
+{
+  geometry_msgs::msg::TransformStamped transform = tf2::eigenToTransform(effector_wrt_world);
+  transform.header.stamp = stamp;
+  transform.header.frame_id = "base_link";
+  transform.child_frame_id = "tool0";
+  tf2_msgs::msg::TFMessage msg;
+  msg.transforms.push_back(transform);
+  return msg;
+}
+
+std::map<std::string, std::size_t> countMessages(const std::string& uri)
+{
+  std::map<std::string, std::size_t> counts;
+  rosbag2_cpp::Reader reader;
+  reader.open(uri);
+  while (reader.has_next())
+    ++counts[reader.read_next()->topic_name];
+  return counts;
+}
+
+// The robot stands still at every sample pose, where two images are taken. Sample i is taken at 10 + i s.
+void writeSession(const std::string& uri, const sensor_msgs::msg::CameraInfo* camera_info,
+                  const mhc::SyntheticDataset& dataset)
+{
+  std::filesystem::remove_all(uri);
+  rosbag2_cpp::Writer writer;
+  writer.open(uri);
+  if (camera_info)
+    writer.write(*camera_info, "/camera_info", rclcpp::Time(1, 0));
+  for (std::size_t i = 0; i < dataset.samples.size(); ++i)
+  {
+    const mhc::SyntheticSample& sample = dataset.samples[i];
+    const rclcpp::Time stamp(10 + i, 0);
+    for (double offset : { -0.2, -0.1, 0., 0.1, 0.2 })
+      writer.write(createTFMessage(sample.effector_wrt_world, stamp + rclcpp::Duration::from_seconds(offset)), "/tf",
+                   stamp + rclcpp::Duration::from_seconds(offset));
+    for (double offset : { 0., 0.1 })
+    {
+      std_msgs::msg::Header header;
+      header.stamp = stamp + rclcpp::Duration::from_seconds(offset);
+      header.frame_id = SENSOR_FRAME;
+      writer.write(*cv_bridge::CvImage(header, "mono8", sample.image).toImageMsg(), "/image", header.stamp);
+    }
+  }
+}
+
+// Synthetic ChArUco images in view of the camera, in the default eye-to-hand setup
+mhc::SyntheticDataset createDataset(const sensor_msgs::msg::CameraInfo& camera_info, std::size_t num_samples)
+{
+  mhc::HandEyeCharucoTarget target;
+  mhc::SyntheticDataOptions options;
+  options.num_samples = num_samples;
+  options.min_distance = 1.;
+  options.max_distance = 1.5;
+  options.render_options.noise_stddev = 2.;
+  mhc::SyntheticDataset dataset;
+  std::string error_message;
+  if (!target.initialize() ||
+      !target.setCameraIntrinsicParams(std::make_shared<sensor_msgs::msg::CameraInfo>(camera_info)) ||
+      !mhc::generateSyntheticData(&target, camera_info, options, dataset, &error_message))
+    ADD_FAILURE() << "Failed to generate the synthetic data: " << error_message;
+  return dataset;
+}
+
+rclcpp::Node::SharedPtr createLoaderNode(const std::string& target_type)
+{
+  // A small rotation threshold, so that no random sample pose is dropped as too similar to another one
+  return rclcpp::Node::make_shared(
+      "handeye_session_loader_test",
+      rclcpp::NodeOptions().parameter_overrides(
+          { rclcpp::Parameter("target_type", target_type), rclcpp::Parameter("min_rotation", 0.01) }));
+}
+}  // namespace
+
+TEST(MoveItHandEyeSessionTester, RecordSession)
+{
+  const std::string uri = testing::TempDir() + "handeye_session_recorded";
+  std::filesystem::remove_all(uri);
+  auto recorder = std::make_shared<mhc::HandEyeSessionRecorder>(
+      rclcpp::NodeOptions().parameter_overrides({ rclcpp::Parameter("output", uri) }));
+
+  auto node = rclcpp::Node::make_shared("handeye_session_publisher");
+  auto image_pub = node->create_publisher<sensor_msgs::msg::Image>("image", rclcpp::SensorDataQoS());
+  auto camera_info_pub = node->create_publisher<sensor_msgs::msg::CameraInfo>("camera_info", rclcpp::SensorDataQoS());
+  auto joint_states_pub = node->create_publisher<sensor_msgs::msg::JointState>("joint_states", rclcpp::QoS(100));
+  auto tf_pub = node->create_publisher<tf2_msgs::msg::TFMessage>("/tf", rclcpp::QoS(100));
+  auto tf_static_pub =
+      node->create_publisher<tf2_msgs::msg::TFMessage>("/tf_static", rclcpp::QoS(100).transient_local());
+
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(recorder);
+  executor.add_node(node);
+  auto spin_until = [&executor](const std::function<bool()>& done) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!done() && std::chrono::steady_clock::now() < deadline)
+      executor.spin_some(std::chrono::milliseconds(10));
+    return done();
+  };
+
+  // Publish once the recorder is subscribed to every topic
+  ASSERT_TRUE(spin_until([&]() {
+    return image_pub->get_subscription_count() > 0 && camera_info_pub->get_subscription_count() > 0 &&
+           joint_states_pub->get_subscription_count() > 0 && tf_pub->get_subscription_count() > 0 &&
+           tf_static_pub->get_subscription_count() > 0;
+  }));
+  const rclcpp::Time stamp(100, 0);
+  std_msgs::msg::Header header;
+  header.stamp = stamp;
+  header.frame_id = SENSOR_FRAME;
+  image_pub->publish(*cv_bridge::CvImage(header, "mono8", cv::Mat(480, 640, CV_8UC1, cv::Scalar(128))).toImageMsg());
+  camera_info_pub->publish(mhc::createCameraInfo());
+  sensor_msgs::msg::JointState joint_state;
+  joint_state.header.stamp = stamp;
+  joint_state.name = { "joint_1" };
+  joint_state.position = { 0.5 };
+  joint_states_pub->publish(joint_state);
+  tf_pub->publish(createTFMessage(Eigen::Isometry3d::Identity(), stamp));
+  tf_static_pub->publish(createTFMessage(Eigen::Isometry3d::Identity(), stamp));
+  const auto wait_end = std::chrono::steady_clock::now() + std::chrono::milliseconds(500);
+  spin_until([&wait_end]() { return std::chrono::steady_clock::now() > wait_end; });
+
+  // Closes the session
+  executor.remove_node(recorder);
+  recorder.reset();
+
+  std::map<std::string, std::size_t> counts = countMessages(uri);
+  EXPECT_EQ(counts["/image"], 1u);
+  EXPECT_EQ(counts["/camera_info"], 1u);
+  EXPECT_EQ(counts["/joint_states"], 1u);
+  EXPECT_EQ(counts["/tf"], 1u);
+  EXPECT_EQ(counts["/tf_static"], 1u);
+  std::filesystem::remove_all(uri);
+}
+
+TEST(MoveItHandEyeSessionTester, ReplaySession)
+{
+  const sensor_msgs::msg::CameraInfo camera_info = mhc::createCameraInfo();
+  const mhc::SyntheticDataset dataset = createDataset(camera_info, 10);
+  ASSERT_EQ(dataset.samples.size(), 10u);
+
+  const std::string uri = testing::TempDir() + "handeye_session_replayed";
+  writeSession(uri, &camera_info, dataset);
+
+  mhc::HandEyeSessionLoader loader(createLoaderNode("HandEyeTarget/Charuco"));
+  ASSERT_TRUE(loader.load(uri));
+  EXPECT_EQ(loader.getSensorFrame(), SENSOR_FRAME);
+
+  // The second image at each pose has the same orientation, so only the first one becomes a sample
+  const mhc::SampleSet& samples = loader.getSamples();
+  ASSERT_EQ(samples.effector_wrt_world.size(), dataset.samples.size());
+  ASSERT_EQ(samples.object_wrt_sensor.size(), dataset.samples.size());
+  ASSERT_EQ(samples.stamps.size(), dataset.samples.size());
+  for (std::size_t i = 0; i < dataset.samples.size(); ++i)
+  {
+    EXPECT_DOUBLE_EQ(samples.stamps[i], 10. + i);
+    EXPECT_TRUE(samples.effector_wrt_world[i].isApprox(dataset.samples[i].effector_wrt_world, 1e-6));
+    EXPECT_LT((samples.object_wrt_sensor[i].translation() - dataset.samples[i].object_wrt_sensor.translation()).norm(),
+              0.02);
+  }
+
+  // Solve as the replay node does
+  pluginlib::ClassLoader<mhc::HandEyeSolverBase> solver_loader("moveit_calibration_plugins",
+                                                               "moveit_handeye_calibration::HandEyeSolverBase");
+  pluginlib::UniquePtr<mhc::HandEyeSolverBase> solver = solver_loader.createUniqueInstance("OpenCV");
+  solver->initialize();
+  std::string error_message;
+  ASSERT_TRUE(solver->solve(samples.effector_wrt_world, samples.object_wrt_sensor, mhc::EYE_TO_HAND, "Daniilidis1998",
+                            &error_message))
+      << error_message;
+  const Eigen::Isometry3d& pose = solver->getCameraRobotPose();
+  EXPECT_LT((pose.translation() - dataset.camera_robot_pose.translation()).norm(), 0.05);
+  EXPECT_LT(Eigen::AngleAxisd(pose.linear().transpose() * dataset.camera_robot_pose.linear()).angle(), 0.05);
+  std::filesystem::remove_all(uri);
+}
+
+TEST(MoveItHandEyeSessionTester, InvalidSession)
+{
+  const sensor_msgs::msg::CameraInfo camera_info = mhc::createCameraInfo();
+  const mhc::SyntheticDataset dataset = createDataset(camera_info, 3);
+  const std::string uri = testing::TempDir() + "handeye_session_invalid";
+
+  // Missing session
+  std::filesystem::remove_all(uri);
+  EXPECT_FALSE(mhc::HandEyeSessionLoader(createLoaderNode("HandEyeTarget/Charuco")).load(uri));
+
+  // The target poses cannot be computed without the camera intrinsics
+  writeSession(uri, nullptr, dataset);
+  EXPECT_FALSE(mhc::HandEyeSessionLoader(createLoaderNode("HandEyeTarget/Charuco")).load(uri));
+
+  // Unknown target plugin
+  writeSession(uri, &camera_info, dataset);
+  EXPECT_FALSE(mhc::HandEyeSessionLoader(createLoaderNode("HandEyeTarget/Unknown")).load(uri));
+  std::filesystem::remove_all(uri);
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  rclcpp::init(argc, argv);
+  const int result = RUN_ALL_TESTS();
+  rclcpp::shutdown();
+  return result;
+}
@@ -0,0 +1,144 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, MoveIt Calibration contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <gtest/gtest.h>
+#include <moveit/handeye_calibration_target/handeye_target_charuco.h>
+#include <moveit/handeye_calibration_tools/handeye_synthetic_data.h>
+
+#include "handeye_test_camera_info.h"
+
+namespace mhc = moveit_handeye_calibration;
+
+namespace
+{
+// The robot and object poses must close the loop through the calibration
+void expectConsistent(const mhc::SyntheticDataset& dataset)
+{
+  for (const mhc::SyntheticSample& sample : dataset.samples)
+  {
+    Eigen::Isometry3d target_wrt_camera;
+    if (dataset.setup == mhc::EYE_TO_HAND)
+      target_wrt_camera = dataset.camera_robot_pose.inverse() * sample.effector_wrt_world * dataset.target_robot_pose;
+    else
+      target_wrt_camera = (sample.effector_wrt_world * dataset.camera_robot_pose).inverse() * dataset.target_robot_pose;
+    EXPECT_TRUE(target_wrt_camera.isApprox(sample.object_wrt_sensor, 1e-9));
+  }
+}
+}  // namespace
+
+TEST(HandEyeSyntheticData, PosesOnly)
+{
+  mhc::SyntheticDataOptions options;
+  options.num_samples = 50;
+  for (mhc::SensorMountType setup : { mhc::EYE_TO_HAND, mhc::EYE_IN_HAND })
+  {
+    options.setup = setup;
+    mhc::SyntheticDataset dataset;
+    std::string error_message;
+    ASSERT_TRUE(mhc::generateSyntheticData(nullptr, mhc::createCameraInfo(), options, dataset, &error_message))
+        << error_message;
+    ASSERT_EQ(dataset.samples.size(), options.num_samples);
+    EXPECT_EQ(dataset.setup, setup);
+    expectConsistent(dataset);
+    for (const mhc::SyntheticSample& sample : dataset.samples)
+    {
+      EXPECT_TRUE(sample.image.empty());
+      EXPECT_TRUE(sample.measured_object_wrt_sensor.isApprox(sample.object_wrt_sensor));
+      EXPECT_GE(sample.object_wrt_sensor.translation().z(), options.min_distance);
+    }
+
+    // Same seed, same data
+    mhc::SyntheticDataset repeated;
+    ASSERT_TRUE(mhc::generateSyntheticData(nullptr, mhc::createCameraInfo(), options, repeated));
+    EXPECT_TRUE(repeated.camera_robot_pose.isApprox(dataset.camera_robot_pose));
+    EXPECT_TRUE(repeated.samples.back().effector_wrt_world.isApprox(dataset.samples.back().effector_wrt_world));
+  }
+}
+
+TEST(HandEyeSyntheticData, MeasurementNoise)
+{
+  mhc::SyntheticDataOptions options;
+  options.num_samples = 200;
+  options.translation_noise = 0.001;
+  options.rotation_noise = 0.001;
+  mhc::SyntheticDataset dataset;
+  ASSERT_TRUE(mhc::generateSyntheticData(nullptr, mhc::createCameraInfo(), options, dataset));
+  expectConsistent(dataset);
+
+  double translation_error = 0.;
+  const mhc::SampleSet samples = mhc::getSampleSet(dataset);
+  ASSERT_EQ(samples.object_wrt_sensor.size(), options.num_samples);
+  for (std::size_t i = 0; i < options.num_samples; ++i)
+  {
+    EXPECT_TRUE(samples.effector_wrt_world[i].isApprox(dataset.samples[i].effector_wrt_world));
+    translation_error +=
+        (samples.object_wrt_sensor[i].translation() - dataset.samples[i].object_wrt_sensor.translation()).norm();
+  }
+  // Mean norm of a 3D Gaussian is 1.6 times its standard deviation
+  EXPECT_NEAR(translation_error / options.num_samples, 1.6e-3, 0.3e-3);
+}
+
+TEST(HandEyeSyntheticData, RenderedImages)
+{
+  mhc::HandEyeCharucoTarget target;
+  ASSERT_TRUE(target.initialize());
+  const sensor_msgs::msg::CameraInfo camera_info = mhc::createCameraInfo();
+  ASSERT_TRUE(target.setCameraIntrinsicParams(std::make_shared<sensor_msgs::msg::CameraInfo>(camera_info)));
+
+  mhc::SyntheticDataOptions options;
+  options.num_samples = 5;
+  options.min_distance = 1.;
+  options.max_distance = 1.5;
+  options.render_options.noise_stddev = 2.;
+  options.max_blur_sigma = 1.;
+  mhc::SyntheticDataset dataset;
+  std::string error_message;
+  ASSERT_TRUE(mhc::generateSyntheticData(&target, camera_info, options, dataset, &error_message)) << error_message;
+  expectConsistent(dataset);
+
+  for (const mhc::SyntheticSample& sample : dataset.samples)
+  {
+    ASSERT_EQ(sample.image.cols, 640);
+    ASSERT_EQ(sample.image.rows, 480);
+    cv::Mat image = sample.image.clone();
+    ASSERT_TRUE(target.detectTargetPose(image));
+    const Eigen::Isometry3d detected = tf2::transformToEigen(target.getTransformStamped("camera"));
+    EXPECT_LT((detected.translation() - sample.object_wrt_sensor.translation()).norm(), 0.02);
+  }
+
+  // Too close for the target to fit into the image
+  options.min_distance = 0.1;
+  options.max_distance = 0.1;
+  EXPECT_FALSE(mhc::generateSyntheticData(&target, camera_info, options, dataset, &error_message));
+}